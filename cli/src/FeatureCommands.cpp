@@ -24,13 +24,18 @@
 
 #include <QElapsedTimer>
 #include <QEventLoop>
+#include <QJsonArray>
 #include <QJsonDocument>
+#include <QJsonObject>
 #include <QJsonParseError>
+#include <QTextStream>
 #include <QTimer>
 
 #include "ComputerControlInterface.h"
 #include "FeatureCommands.h"
 #include "FeatureManager.h"
+#include "NetworkObjectDirectory.h"
+#include "NetworkObjectDirectoryManager.h"
 #include "PluginManager.h"
 
 
@@ -90,7 +95,7 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 	{
 		printUsage( commandLineModuleName(), startCommand(),
 					{ { tr("HOST ADDRESS"), {} }, { tr("FEATURE"), {} } },
-					{ { tr("ARGUMENTS"), {} } } );
+					{ { tr("ARGUMENTS"), {} }, { tr("COUNT"), parallelArgument() } } );
 
 		printDescription( tr("Starts the specified feature on the specified host by connecting to "
 							  "the Veyon Server running remotely. The feature can be specified by name "
@@ -98,6 +103,7 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 							  "Depending on the feature, additional arguments (such as the text message to display) "
 							  "encoded as a single JSON string have to be specified. Please refer to "
 							  "the developer documentation for more information") );
+		printHostsDescription();
 
 		printExamples( commandLineModuleName(), startCommand(),
 					   {
@@ -111,6 +117,13 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 						   { tr( "Start an application" ),
 							   { QStringLiteral("192.168.1.2"), QStringLiteral("da9ca56a-b2ad-4fff-8f8a-929b2927b442"),
 								 QStringLiteral("\"{\\\"applications\\\":\\\"notepad\\\"}\"") }
+						   },
+						   { tr( "Lock the screens of all computers in a location" ),
+							   { QStringLiteral("\"%1Room 01\"").arg( locationPrefix() ), QStringLiteral("ScreenLock") }
+						   },
+						   { tr( "Lock the screens of multiple computers with up to 100 simultaneous connections" ),
+							   { QStringLiteral("192.168.1.2,192.168.1.3,192.168.1.4"), QStringLiteral("ScreenLock"),
+								 parallelArgument(), QStringLiteral("100") }
 						   }
 					   } );
 
@@ -120,16 +133,21 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 	if( command == stopCommand() )
 	{
 		printUsage( commandLineModuleName(), stopCommand(),
-					{ { tr("HOST ADDRESS"), {} }, { tr("FEATURE"), {} } }, {} );
+					{ { tr("HOST ADDRESS"), {} }, { tr("FEATURE"), {} } },
+					{ { tr("COUNT"), parallelArgument() } } );
 
 		printDescription( tr("Stops the specified feature on the specified host by connecting to "
 							  "the Veyon Server running remotely. The feature can be specified by name "
 							  "or UID. Use the ``show`` command to see all available features.") );
+		printHostsDescription();
 
 		printExamples( commandLineModuleName(), stopCommand(),
 					   {
 						   { tr( "Unlock the screen" ),
 							   { QStringLiteral("192.168.1.2"), QStringLiteral("ScreenLock") }
+						   },
+						   { tr( "Unlock the screens of all computers listed in a file" ),
+							   { stdinArgument(), QStringLiteral("ScreenLock"), QStringLiteral("< computers.txt") }
 						   }
 					   } );
 
@@ -142,6 +160,20 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 }
 
 
+void FeatureCommands::printHostsDescription()
+{
+	printDescription( tr("Multiple hosts can be specified as comma-separated list. All computers of a location "
+						  "can be specified by prefixing the location name with \"%1\". Specify \"%2\" "
+						  "to read hosts from the standard input (one or multiple per line). Connections "
+						  "to multiple hosts are established concurrently (up to %3 by default, use %4 to change) "
+						  "and the results are reported per host in JSON format (use %5 to always report "
+						  "results in JSON format).").
+					  arg( locationPrefix(), stdinArgument() ).arg( DefaultParallelism ).
+					  arg( parallelArgument(), jsonArgument() ) );
+}
+
+
+
 CommandLinePluginInterface::RunResult FeatureCommands::handle_list( const QStringList& arguments )
 {
 	Q_UNUSED(arguments)
@@ -218,14 +250,36 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_stop( const QStrin
 CommandLinePluginInterface::RunResult FeatureCommands::controlComputer( FeatureProviderInterface::Operation operation,
 									  const QStringList& arguments )
 {
-	if( arguments.count() < 2 )
+	auto positionalArguments = arguments;
+	auto parallelism = DefaultParallelism;
+	auto jsonOutput = false;
+
+	const auto parallelArgumentIndex = positionalArguments.indexOf( parallelArgument() );
+	if( parallelArgumentIndex >= 0 )
+	{
+		parallelism = positionalArguments.value( parallelArgumentIndex + 1 ).toInt();
+		if( parallelism <= 0 )
+		{
+			error( tr("Invalid value for %1 specified").arg( parallelArgument() ) );
+			return InvalidArguments;
+		}
+		positionalArguments.erase( positionalArguments.begin() + parallelArgumentIndex,
+								   positionalArguments.begin() + parallelArgumentIndex + 2 );
+	}
+
+	if( positionalArguments.removeAll( jsonArgument() ) > 0 )
+	{
+		jsonOutput = true;
+	}
+
+	if( positionalArguments.count() < 2 )
 	{
 		return NotEnoughArguments;
 	}
 
-	const auto host = arguments[0];
-	const auto featureNameOrUid = arguments[1];
-	const auto featureArguments = arguments.value(2);
+	const auto hostsSpecification = positionalArguments[0];
+	const auto featureNameOrUid = positionalArguments[1];
+	const auto featureArguments = positionalArguments.value(2);
 
 	FeatureManager featureManager;
 
@@ -261,61 +315,231 @@ CommandLinePluginInterface::RunResult FeatureCommands::controlComputer( FeatureP
 		return InvalidArguments;
 	}
 
+	QStringList hosts;
+	if( resolveHosts( hostsSpecification, hosts ) == false )
+	{
+		return InvalidArguments;
+	}
+
+	if( hosts.isEmpty() )
+	{
+		error( tr("No hosts specified or found") );
+		return InvalidArguments;
+	}
+
 	if( VeyonCore::instance()->initAuthentication() == false  )
 	{
 		error( tr("Failed to initialize credentials") );
 		return Failed;
 	}
 
-	Computer computer;
-	computer.setHostAddress(host);
+	const auto results = controlComputers( featureManager, featureUid, operation,
+										   featureArgsJson.toVariant().toMap(), hosts, parallelism );
 
-	auto computerControlInterface = ComputerControlInterface::Pointer::create( computer );
-	computerControlInterface->start();
+	auto successful = true;
+	QJsonArray jsonResults;
 
-	static constexpr auto ConnectTimeout = 30 * 1000;
-	QTimer timeoutTimer;
-	timeoutTimer.start( ConnectTimeout );
-
-	QEventLoop eventLoop;
-	connect( &timeoutTimer, &QTimer::timeout, &eventLoop, &QEventLoop::quit );
-	connect( computerControlInterface.data(), &ComputerControlInterface::stateChanged, this,
-			 [&]() {
-				 if( computerControlInterface->state() == ComputerControlInterface::State::Connected )
-				 {
-					 eventLoop.quit();
-				 }
-			 } );
+	for( const auto& result : results )
+	{
+		successful &= result.errorString.isEmpty();
 
-	eventLoop.exec();
+		if( jsonOutput || hosts.count() > 1 )
+		{
+			jsonResults.append( QJsonObject{
+				{ QStringLiteral("host"), result.host },
+				{ QStringLiteral("success"), result.errorString.isEmpty() },
+				{ QStringLiteral("error"), result.errorString },
+				{ QStringLiteral("duration"), result.duration }
+			} );
+		}
+		else if( result.errorString.isEmpty() == false )
+		{
+			error( result.errorString );
+		}
+	}
 
-	if( computerControlInterface->state() != ComputerControlInterface::State::Connected )
+	if( jsonResults.isEmpty() == false )
 	{
-		error( tr("Could not establish a connection to host %1").arg( host ) );
-		return Failed;
+		print( QString::fromUtf8( QJsonDocument( jsonResults ).toJson() ) );
 	}
 
-	featureManager.controlFeature( featureUid, operation,
-								   featureArgsJson.toVariant().toMap(),
-								   { computerControlInterface } );
+	return successful ? Successful : Failed;
+}
+
 
-	static constexpr auto MessageQueueWaitTimeout = 10 * 1000;
-	static constexpr auto MessageQueuePollInterval = 10;
 
-	QElapsedTimer messageQueueWaitTimer;
-	messageQueueWaitTimer.start();
+bool FeatureCommands::resolveHosts( const QString& hostsSpecification, QStringList& hosts )
+{
+	QStringList specifications;
 
-	while( computerControlInterface->isMessageQueueEmpty() == false &&
-		   messageQueueWaitTimer.elapsed() < MessageQueueWaitTimeout )
+	if( hostsSpecification == stdinArgument() )
+	{
+		QTextStream stream( stdin );
+		while( stream.atEnd() == false )
+		{
+			const auto line = stream.readLine().trimmed();
+			if( line.isEmpty() == false )
+			{
+				specifications.append( line.split( QLatin1Char(',') ) );
+			}
+		}
+	}
+	else
 	{
-		QThread::msleep(MessageQueuePollInterval);
+		specifications = hostsSpecification.split( QLatin1Char(',') );
 	}
 
-	if( messageQueueWaitTimer.elapsed() >= MessageQueueWaitTimeout )
+	hosts.clear();
+	hosts.reserve( specifications.count() );
+
+	for( auto specification : std::as_const(specifications) )
 	{
-		error( tr("Failed to send feature control message to host %1").arg( host ) );
-		return Failed;
+		specification = specification.trimmed();
+
+		if( specification.startsWith( locationPrefix() ) )
+		{
+			const auto locationName = specification.mid( locationPrefix().length() );
+
+			auto directory = VeyonCore::networkObjectDirectoryManager().configuredDirectory();
+			if( directory == nullptr )
+			{
+				error( tr("No network object directory configured for resolving location \"%1\"").arg( locationName ) );
+				return false;
+			}
+
+			const auto locations = directory->queryObjects( NetworkObject::Type::Location, NetworkObject::Attribute::Name,
+															locationName );
+			if( locations.isEmpty() )
+			{
+				error( tr("Location \"%1\" not found").arg( locationName ) );
+				return false;
+			}
+
+			for( const auto& location : locations )
+			{
+				const auto computers = directory->queryObjects( NetworkObject::Type::Host, NetworkObject::Attribute::ParentUid,
+																location.uid() );
+				for( const auto& computer : computers )
+				{
+					hosts.append( computer.hostAddress() );
+				}
+			}
+		}
+		else if( specification.isEmpty() == false )
+		{
+			hosts.append( specification );
+		}
+	}
+
+	hosts.removeDuplicates();
+
+	return true;
+}
+
+
+
+FeatureCommands::HostResults FeatureCommands::controlComputers( FeatureManager& featureManager,
+																Feature::Uid featureUid,
+																FeatureProviderInterface::Operation operation,
+																const QVariantMap& featureArguments,
+																const QStringList& hosts, int parallelism )
+{
+	struct Task
+	{
+		ComputerControlInterface::Pointer computerControlInterface;
+		QTimer* timeoutTimer{nullptr};
+		QTimer* messageQueuePollTimer{nullptr};
+		QElapsedTimer elapsedTimer;
+	};
+
+	HostResults results( hosts.count() );
+	QVector<Task> tasks( hosts.count() );
+
+	int nextHostIndex = 0;
+	int runningTaskCount = 0;
+
+	QEventLoop eventLoop;
+
+	std::function<void (int)> startTask;
+
+	const auto finishTask = [&]( int index, const QString& errorString ) {
+		auto& task = tasks[index];
+		if( task.computerControlInterface.isNull() )
+		{
+			return;
+		}
+
+		results[index] = { hosts[index], errorString, task.elapsedTimer.elapsed() };
+
+		task.timeoutTimer->stop();
+		task.timeoutTimer->deleteLater();
+		task.messageQueuePollTimer->stop();
+		task.messageQueuePollTimer->deleteLater();
+		task.computerControlInterface->disconnect( this );
+		task.computerControlInterface.clear();
+
+		--runningTaskCount;
+
+		if( nextHostIndex < hosts.count() )
+		{
+			startTask( nextHostIndex++ );
+		}
+		else if( runningTaskCount <= 0 )
+		{
+			eventLoop.quit();
+		}
+	};
+
+	startTask = [&]( int index ) {
+		auto& task = tasks[index];
+
+		Computer computer;
+		computer.setHostAddress( hosts[index] );
+
+		task.computerControlInterface = ComputerControlInterface::Pointer::create( computer );
+		task.timeoutTimer = new QTimer( this );
+		task.timeoutTimer->setSingleShot( true );
+		task.messageQueuePollTimer = new QTimer( this );
+		task.elapsedTimer.start();
+
+		++runningTaskCount;
+
+		connect( task.timeoutTimer, &QTimer::timeout, this, [&, index]() {
+			finishTask( index, tasks[index].messageQueuePollTimer->isActive() ?
+								   tr("Failed to send feature control message to host %1").arg( hosts[index] ) :
+								   tr("Could not establish a connection to host %1").arg( hosts[index] ) );
+		} );
+
+		connect( task.messageQueuePollTimer, &QTimer::timeout, this, [&, index]() {
+			if( tasks[index].computerControlInterface->isMessageQueueEmpty() )
+			{
+				finishTask( index, {} );
+			}
+		} );
+
+		connect( task.computerControlInterface.data(), &ComputerControlInterface::stateChanged, this, [&, index]() {
+			auto& currentTask = tasks[index];
+			if( currentTask.computerControlInterface->state() == ComputerControlInterface::State::Connected &&
+				currentTask.messageQueuePollTimer->isActive() == false )
+			{
+				featureManager.controlFeature( featureUid, operation, featureArguments,
+											   { currentTask.computerControlInterface } );
+
+				currentTask.timeoutTimer->start( MessageQueueWaitTimeout );
+				currentTask.messageQueuePollTimer->start( MessageQueuePollInterval );
+			}
+		} );
+
+		task.timeoutTimer->start( ConnectTimeout );
+		task.computerControlInterface->start();
+	};
+
+	while( nextHostIndex < hosts.count() && nextHostIndex < parallelism )
+	{
+		startTask( nextHostIndex++ );
 	}
 
-	return Successful;
+	eventLoop.exec();
+
+	return results;
 }
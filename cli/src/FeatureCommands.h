@@ -28,6 +28,8 @@
 #include "CommandLineIO.h"
 #include "FeatureProviderInterface.h"
 
+class FeatureManager;
+
 class FeatureCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
 {
 	Q_OBJECT
@@ -107,8 +109,49 @@ private:
 		return QStringLiteral("stop");
 	}
 
+	static QString parallelArgument()
+	{
+		return QStringLiteral("--parallel");
+	}
+
+	static QString jsonArgument()
+	{
+		return QStringLiteral("--json");
+	}
+
+	static QString stdinArgument()
+	{
+		return QStringLiteral("-");
+	}
+
+	static QString locationPrefix()
+	{
+		return QStringLiteral("location:");
+	}
+
+	struct HostResult
+	{
+		QString host;
+		QString errorString;
+		qint64 duration{0};
+	};
+	using HostResults = QVector<HostResult>;
+
+	static constexpr auto DefaultParallelism = 32;
+	static constexpr auto ConnectTimeout = 30 * 1000;
+	static constexpr auto MessageQueueWaitTimeout = 10 * 1000;
+	static constexpr auto MessageQueuePollInterval = 10;
+
+	void printHostsDescription();
+
 	RunResult controlComputer( FeatureProviderInterface::Operation operation, const QStringList& arguments );
 
+	bool resolveHosts( const QString& hostsSpecification, QStringList& hosts );
+	HostResults controlComputers( FeatureManager& featureManager, Feature::Uid featureUid,
+								  FeatureProviderInterface::Operation operation,
+								  const QVariantMap& featureArguments,
+								  const QStringList& hosts, int parallelism );
+
 	const QMap<QString, QString> m_commands;
 
 };
@@ -123,9 +123,20 @@ QStringList AccessControlProvider::locationsOfComputer( const QString& computer
 AccessControlProvider::CheckResult AccessControlProvider::checkAccess(const QString& accessingUser,
 																	  const QString& accessingComputer,
 																	  const QStringList& connectedUsers)
+{
+	return checkAccess(accessingUser, accessingComputer, connectedUsers,
+					   VeyonCore::platform().userFunctions().currentUser());
+}
+
+
+
+AccessControlProvider::CheckResult AccessControlProvider::checkAccess(const QString& accessingUser,
+																	  const QString& accessingComputer,
+																	  const QStringList& connectedUsers,
+																	  const QString& localUser)
 {
 	CheckResult denyAccessCheckResult{Access::Deny};
-	if (VeyonCore::config().isAccessRestrictedToUserGroups())
+	if (VeyonCore::config().snapshot()->isAccessRestrictedToUserGroups)
 	{
 		if (processAuthorizedGroups(accessingUser))
 		{
@@ -133,11 +144,11 @@ AccessControlProvider::CheckResult AccessControlProvider::checkAccess(const QStr
 		}
 		denyAccessCheckResult.reason = Reason::UserNotInAuthorizedUserGroups;
 	}
-	else if (VeyonCore::config().isAccessControlRulesProcessingEnabled())
+	else if (VeyonCore::config().snapshot()->isAccessControlRulesProcessingEnabled)
 	{
 		const auto rule = processAccessControlRules(accessingUser,
 													accessingComputer,
-													VeyonCore::platform().userFunctions().currentUser(),
+													localUser,
 													HostAddress::localFQDN(),
 													connectedUsers);
 		if (rule)
@@ -179,7 +190,7 @@ bool AccessControlProvider::processAuthorizedGroups( const QString& accessingUse
 	vDebug() << "processing for user" << accessingUser;
 
 	const auto groupsOfAccessingUser = m_userGroupsBackend->groupsOfUser( accessingUser, m_useDomainUserGroups );
-	const auto authorizedUserGroups = VeyonCore::config().authorizedUserGroups();
+	const auto authorizedUserGroups = VeyonCore::config().snapshot()->authorizedUserGroups;
 
 	vDebug() << groupsOfAccessingUser << authorizedUserGroups;
 
@@ -224,15 +235,21 @@ AccessControlRule::Pointer AccessControlProvider::processAccessControlRules(cons
  */
 bool AccessControlProvider::isAccessToLocalComputerDenied() const
 {
-	if( VeyonCore::config().isAccessControlRulesProcessingEnabled() == false )
+	return isAccessToLocalComputerDenied(VeyonCore::platform().userFunctions().currentUser());
+}
+
+
+
+bool AccessControlProvider::isAccessToLocalComputerDenied(const QString& localUser) const
+{
+	if( VeyonCore::config().snapshot()->isAccessControlRulesProcessingEnabled == false )
 	{
 		return false;
 	}
 
 	for (const auto& rule : std::as_const(m_accessControlRules))
 	{
-		if (matchConditions(*rule, {}, {},
-							VeyonCore::platform().userFunctions().currentUser(), HostAddress::localFQDN(), {}))
+		if (matchConditions(*rule, {}, {}, localUser, HostAddress::localFQDN(), {}))
 		{
 			switch (rule->action())
 			{
@@ -71,6 +71,8 @@ public:
 
 	CheckResult checkAccess(const QString& accessingUser, const QString& accessingComputer,
 							const QStringList& connectedUsers);
+	CheckResult checkAccess(const QString& accessingUser, const QString& accessingComputer,
+							const QStringList& connectedUsers, const QString& localUser);
 
 	bool processAuthorizedGroups( const QString& accessingUser );
 
@@ -81,6 +83,7 @@ public:
 														 const QStringList& connectedUsers);
 
 	bool isAccessToLocalComputerDenied() const;
+	bool isAccessToLocalComputerDenied(const QString& localUser) const;
 
 	Plugin::Uid uid() const override
 	{
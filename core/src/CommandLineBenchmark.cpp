@@ -0,0 +1,161 @@
+/*
+ * CommandLineBenchmark.cpp - helper for benchmark commands of command line plugins
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <numeric>
+
+#include "CommandLineBenchmark.h"
+
+
+CommandLineBenchmark::CommandLineBenchmark( const QString& name, const CommandLineIO::TableHeader& header ) :
+	m_name( name ),
+	m_table( header, {} )
+{
+}
+
+
+
+void CommandLineBenchmark::info( const QString& message ) const
+{
+	CommandLineIO::print( QStringLiteral("[TEST]: %1: %2").arg( m_name, message ) );
+}
+
+
+
+CommandLineBenchmark::Measurement CommandLineBenchmark::run( int count, const Operation& operation, const Operation& preparation )
+{
+	QVector<qint64> runTimes;
+	runTimes.reserve( count );
+
+	qint64 totalTime = 0;
+
+	for( int i = 0; i < count; ++i )
+	{
+		if( preparation && preparation() == false )
+		{
+			return measurement( runTimes, 1, totalTime );
+		}
+
+		QElapsedTimer elapsedTimer;
+		elapsedTimer.start();
+		const auto successful = operation();
+		const auto elapsed = elapsedTimer.nsecsElapsed();
+
+		if( successful == false )
+		{
+			return measurement( runTimes, 1, totalTime );
+		}
+
+		runTimes.append( elapsed );
+		totalTime += elapsed;
+	}
+
+	return measurement( runTimes, 0, totalTime );
+}
+
+
+
+CommandLineBenchmark::Measurement CommandLineBenchmark::runConcurrently( int count, int concurrency, const Operation& operation )
+{
+	QThreadPool threadPool;
+	threadPool.setMaxThreadCount( concurrency );
+
+	QMutex mutex;
+	QVector<qint64> runTimes;
+	runTimes.reserve( count );
+	int failedCount = 0;
+
+	QElapsedTimer totalTimer;
+	totalTimer.start();
+
+	for( int i = 0; i < count; ++i )
+	{
+		(void) QtConcurrent::run( &threadPool, [&]() {
+			QElapsedTimer elapsedTimer;
+			elapsedTimer.start();
+			const auto successful = operation();
+			const auto elapsed = elapsedTimer.nsecsElapsed();
+
+			QMutexLocker locker( &mutex );
+			if( successful )
+			{
+				runTimes.append( elapsed );
+			}
+			else
+			{
+				++failedCount;
+			}
+		} );
+	}
+
+	threadPool.waitForDone();
+
+	return measurement( runTimes, failedCount, totalTimer.nsecsElapsed() );
+}
+
+
+
+QString CommandLineBenchmark::milliseconds( qint64 nanoseconds, int precision )
+{
+	return QString::number( double(nanoseconds) / 1000000, 'f', precision );
+}
+
+
+
+void CommandLineBenchmark::addRow( const QString& variant, const CommandLineIO::TableRow& values )
+{
+	m_table.second.append( CommandLineIO::TableRow{ variant } + values );
+}
+
+
+
+void CommandLineBenchmark::print() const
+{
+	CommandLineIO::printTable( m_table );
+}
+
+
+
+CommandLineBenchmark::Measurement CommandLineBenchmark::measurement( QVector<qint64>& runTimes, int failedCount, qint64 totalTime )
+{
+	Measurement result;
+	result.runCount = runTimes.size();
+	result.failedCount = failedCount;
+	result.totalTime = totalTime;
+
+	if( runTimes.isEmpty() == false )
+	{
+		std::sort( runTimes.begin(), runTimes.end() );
+		result.averageTime = std::accumulate( runTimes.constBegin(), runTimes.constEnd(), qint64(0) ) / runTimes.size();
+		result.medianTime = runTimes.at( runTimes.size() / 2 );
+		result.maximumTime = runTimes.last();
+	}
+
+	return result;
+}
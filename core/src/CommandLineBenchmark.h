@@ -0,0 +1,79 @@
+/*
+ * CommandLineBenchmark.h - helper for benchmark commands of command line plugins
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "CommandLineIO.h"
+
+// clazy:excludeall=rule-of-three
+
+// measures the variants of an operation (e.g. a previous and a current implementation) and
+// prints one table row per variant
+class VEYON_CORE_EXPORT CommandLineBenchmark
+{
+public:
+	using Operation = std::function<bool()>;
+
+	struct Measurement
+	{
+		int runCount{0};
+		int failedCount{0};
+		// all times in nanoseconds
+		qint64 totalTime{0};
+		qint64 averageTime{0};
+		qint64 medianTime{0};
+		qint64 maximumTime{0};
+
+		double runsPerSecond() const
+		{
+			return totalTime > 0 ? runCount * 1e9 / double(totalTime) : 0;
+		}
+	};
+
+	CommandLineBenchmark( const QString& name, const CommandLineIO::TableHeader& header );
+
+	// prints a message prefixed with the name of the benchmark
+	void info( const QString& message ) const;
+
+	// runs the operation count times and stops at the first failed run - the optional preparation
+	// is run before each run without being measured
+	static Measurement run( int count, const Operation& operation, const Operation& preparation = {} );
+
+	// runs the operation count times in a thread pool with the given number of threads
+	static Measurement runConcurrently( int count, int concurrency, const Operation& operation );
+
+	static QString milliseconds( qint64 nanoseconds, int precision = 0 );
+
+	void addRow( const QString& variant, const CommandLineIO::TableRow& values );
+	void print() const;
+
+private:
+	static Measurement measurement( QVector<qint64>& runTimes, int failedCount, qint64 totalTime );
+
+	const QString m_name;
+	CommandLineIO::Table m_table;
+
+} ;
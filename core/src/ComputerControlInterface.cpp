@@ -88,7 +88,9 @@ void ComputerControlInterface::start( QSize scaledFramebufferSize, UpdateMode up
 			vncConnection->setPort( m_port );
 		}
 		vncConnection->setScaledSize( m_scaledFramebufferSize );
+		vncConnection->setConnectionPriority( m_connectionPriority );
 		connect( vncConnection, &VncConnection::framebufferUpdateComplete, this, &ComputerControlInterface::resetWatchdog );
+		connect(vncConnection, &VncConnection::framebufferUpdateComplete, this, [this]() { ++m_framebufferGeneration; });
 		connect( vncConnection, &VncConnection::framebufferUpdateComplete, this, &ComputerControlInterface::framebufferUpdated );
 
 		connect( vncConnection, &VncConnection::framebufferSizeChanged, this, &ComputerControlInterface::framebufferSizeChanged );
@@ -267,6 +269,18 @@ void ComputerControlInterface::setServerVersion(VeyonCore::ApplicationVersion ve
 
 
 
+void ComputerControlInterface::setServerSupportsFlowControl(bool supported)
+{
+	// servers not reporting the capability forward the announcement to the VNC server
+	// which would reset the encodings negotiated before
+	if (supported && vncConnection())
+	{
+		vncConnection()->announceFlowControlSupport();
+	}
+}
+
+
+
 void ComputerControlInterface::setUserInformation(const QString& userLoginName, const QString& userFullName)
 {
 	if (userLoginName != m_userLoginName ||
@@ -316,11 +330,11 @@ void ComputerControlInterface::setActiveFeatures( const FeatureUidList& activeFe
 
 
 
-void ComputerControlInterface::sendFeatureMessage(const FeatureMessage& featureMessage)
+void ComputerControlInterface::sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage)
 {
 	if( m_connection && m_connection->isConnected() )
 	{
-		m_connection->sendFeatureMessage(featureMessage);
+		m_connection->sendFeatureMessage(featureMessage, serializedMessage);
 	}
 }
 
@@ -353,6 +367,21 @@ void ComputerControlInterface::setUpdateMode( UpdateMode updateMode )
 
 
 
+void ComputerControlInterface::setConnectionPriority( ConnectionPriority priority )
+{
+	if( m_connectionPriority != priority )
+	{
+		m_connectionPriority = priority;
+
+		if( vncConnection() )
+		{
+			vncConnection()->setConnectionPriority( m_connectionPriority );
+		}
+	}
+}
+
+
+
 void ComputerControlInterface::setProperty(QUuid propertyId, const QVariant& data)
 {
 	if (propertyId.isNull() == false)
@@ -605,6 +634,14 @@ void ComputerControlInterface::updateScreens()
 
 void ComputerControlInterface::handleFeatureMessage( const FeatureMessage& message )
 {
+	if (message.command() == FeatureMessage::AcknowledgeCommand)
+	{
+		Q_EMIT featureMessageAcknowledged(message.requestId(),
+										  message.argument(FeatureMessage::AcknowledgementArgument::Handled).toBool(),
+										  message.argument(FeatureMessage::AcknowledgementArgument::ExecutionTime).toInt());
+		return;
+	}
+
 	lock();
 	VeyonCore::featureManager().handleFeatureMessage( weakPointer(), message );
 	unlock();
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "Computer.h"
 #include "Feature.h"
 #include "Lockable.h"
@@ -46,6 +48,7 @@ public:
 	using Pointer = QSharedPointer<ComputerControlInterface>;
 
 	using State = VncConnection::State;
+	using ConnectionPriority = VncConnectionScheduler::Priority;
 
 	struct ScreenProperties {
 		int index;
@@ -108,6 +111,13 @@ public:
 
 	QImage framebuffer() const;
 
+	// incremented with every completed framebuffer update and thus allows to tell whether
+	// an image derived from the framebuffer (e.g. an encoded screenshot) is still up to date
+	quint64 framebufferGeneration() const
+	{
+		return m_framebufferGeneration;
+	}
+
 	const QString& accessControlDetails() const
 	{
 		return m_accessControlDetails;
@@ -121,6 +131,7 @@ public:
 	}
 
 	void setServerVersion(VeyonCore::ApplicationVersion version);
+	void setServerSupportsFlowControl(bool supported);
 
 	const QString& userLoginName() const
 	{
@@ -165,7 +176,7 @@ public:
 		m_designatedModeFeature = designatedModeFeature;
 	}
 
-	void sendFeatureMessage(const FeatureMessage& featureMessage);
+	void sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage = {});
 	bool isMessageQueueEmpty();
 
 	void setUpdateMode( UpdateMode updateMode );
@@ -174,6 +185,12 @@ public:
 		return m_updateMode;
 	}
 
+	void setConnectionPriority( ConnectionPriority priority );
+	ConnectionPriority connectionPriority() const
+	{
+		return m_connectionPriority;
+	}
+
 	void setProperty(QUuid propertyId, const QVariant& data);
 
 	QVariant queryProperty(QUuid propertyId);
@@ -216,6 +233,7 @@ private:
 	const int m_port;
 
 	UpdateMode m_updateMode{UpdateMode::Disabled};
+	ConnectionPriority m_connectionPriority{ConnectionPriority::Normal};
 	Computer::NameSource m_computerNameSource{Computer::NameSource::Default};
 
 	State m_state{State::Disconnected};
@@ -227,6 +245,7 @@ private:
 	Feature::Uid m_designatedModeFeature;
 
 	QSize m_scaledFramebufferSize{};
+	std::atomic<quint64> m_framebufferGeneration{0};
 	int m_timestamp{0};
 
 	VeyonConnection* m_connection{nullptr};
@@ -251,6 +270,7 @@ Q_SIGNALS:
 	void stateChanged();
 	void activeFeaturesChanged();
 	void propertyChanged(QUuid propertyId);
+	void featureMessageAcknowledged(QUuid requestId, bool handled, int executionTime);
 
 };
 
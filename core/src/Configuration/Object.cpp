@@ -88,6 +88,7 @@ Object& Object::operator=( const Object& ref )
 	}
 
 	m_data = ref.data();
+	dataReplaced();
 
 	return *this;
 }
@@ -116,6 +117,7 @@ static Object::DataMap operator+(Object::DataMap dst, const Object::DataMap& src
 Object& Object::operator+=( const Object& ref )
 {
 	m_data = m_data + ref.data();
+	dataReplaced();
 
 	return *this;
 }
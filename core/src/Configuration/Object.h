@@ -61,7 +61,11 @@ public:
 	{
 		if( m_store )
 		{
+			m_reloading = true;
 			m_store->load( this );
+			m_reloading = false;
+
+			dataReplaced();
 		}
 	}
 
@@ -81,6 +85,7 @@ public:
 	void clear()
 	{
 		m_data.clear();
+		dataReplaced();
 	}
 
 	const DataMap & data() const
@@ -93,12 +98,25 @@ Q_SIGNALS:
 	void configurationChanged();
 
 
+protected:
+	// called after the data has been loaded, replaced or merged as a whole
+	virtual void dataReplaced()
+	{
+	}
+
+	bool isReloading() const
+	{
+		return m_reloading;
+	}
+
+
 private:
 	static Store* createStore( Store::Backend backend, Store::Scope scope );
 
 	Configuration::Store *m_store{nullptr};
 	bool m_customStore{false};
 	DataMap m_data{};
+	bool m_reloading{false};
 
 } ;
 
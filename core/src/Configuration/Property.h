@@ -178,4 +178,10 @@ VEYON_CORE_EXPORT void TypedProperty<Password>::setValue( const Password& value
 			m_##name->setValue( value ); \
 		}
 
+#define DECLARE_CONFIG_SNAPSHOT_VALUE(className,config,type, name, setter, key, parentKey, defaultValue, flags) \
+	type name{};
+
+#define INIT_CONFIG_SNAPSHOT_VALUE(className,config,type, name, setter, key, parentKey, defaultValue, flags) \
+	snapshot->name = name();
+
 }
@@ -22,6 +22,8 @@
  *
  */
 
+#include <QFileInfo>
+
 #include <openssl/bn.h>
 
 #include "CryptoCore.h"
@@ -95,3 +97,40 @@ CryptoCore::PlaintextPassword CryptoCore::decryptPassword( const QString& encryp
 
 	return {};
 }
+
+
+
+CryptoCore::PublicKey CryptoCore::loadPublicKey( const QString& publicKeyPath )
+{
+	const QFileInfo publicKeyFileInfo( publicKeyPath );
+
+	QMutexLocker locker( &m_publicKeyCacheMutex );
+
+	if( publicKeyFileInfo.exists() == false )
+	{
+		m_publicKeyCache.remove( publicKeyPath );
+		return {};
+	}
+
+	const auto lastModified = publicKeyFileInfo.lastModified();
+	const auto size = publicKeyFileInfo.size();
+
+	const auto it = m_publicKeyCache.constFind( publicKeyPath );
+	if( it != m_publicKeyCache.constEnd() && it->lastModified == lastModified && it->size == size )
+	{
+		return it->key;
+	}
+
+	PublicKey publicKey( publicKeyPath );
+	if( publicKey.isNull() || publicKey.isPublic() == false )
+	{
+		m_publicKeyCache.remove( publicKeyPath );
+		return publicKey;
+	}
+
+	vDebug() << "loaded public key from" << publicKeyPath;
+
+	m_publicKeyCache[publicKeyPath] = { lastModified, size, publicKey };
+
+	return publicKey;
+}
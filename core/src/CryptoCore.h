@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+
 #include "VeyonCore.h"
 
 #include <QtCrypto>
@@ -55,8 +59,20 @@ public:
 	QString encryptPassword( const PlaintextPassword& password ) const;
 	PlaintextPassword decryptPassword( const QString& encryptedPassword ) const;
 
+	PublicKey loadPublicKey( const QString& publicKeyPath );
+
 private:
+	struct CachedPublicKey
+	{
+		QDateTime lastModified;
+		qint64 size{0};
+		PublicKey key;
+	};
+
 	QCA::Initializer m_qcaInitializer;
 	PrivateKey m_defaultPrivateKey;
 
+	QMutex m_publicKeyCacheMutex;
+	QHash<QString, CachedPublicKey> m_publicKeyCache;
+
 };
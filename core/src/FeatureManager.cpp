@@ -64,6 +64,8 @@ FeatureManager::FeatureManager( QObject* parent ) :
 	{
 		m_disabledFeaturesUids.append(Plugin::Uid{disabledFeature});
 	}
+
+	buildDispatchTable();
 }
 
 
@@ -88,6 +90,19 @@ const FeatureList& FeatureManager::features( Plugin::Uid pluginUid ) const
 
 const Feature& FeatureManager::feature( Feature::Uid featureUid ) const
 {
+	const auto provider = featureProvider( featureUid );
+	if( provider )
+	{
+		for( const auto& feature : provider->featureInterface->featureList() )
+		{
+			if( feature.uid() == featureUid )
+			{
+				return feature;
+			}
+		}
+	}
+
+	// feature lists of some plugins change at runtime so fall back to searching all plugins
 	for( const auto& featureInterface : m_featurePluginInterfaces )
 	{
 		for( const auto& feature : featureInterface->featureList() )
@@ -113,6 +128,12 @@ const FeatureList& FeatureManager::relatedFeatures( Feature::Uid featureUid ) co
 
 Feature::Uid FeatureManager::metaFeatureUid( Feature::Uid featureUid ) const
 {
+	const auto provider = featureProvider( featureUid );
+	if( provider )
+	{
+		return provider->featureInterface->metaFeature( featureUid );
+	}
+
 	for( const auto& featureInterface : m_featurePluginInterfaces )
 	{
 		for( const auto& feature : featureInterface->featureList() )
@@ -131,6 +152,12 @@ Feature::Uid FeatureManager::metaFeatureUid( Feature::Uid featureUid ) const
 
 Plugin::Uid FeatureManager::pluginUid( Feature::Uid featureUid ) const
 {
+	const auto provider = featureProvider( featureUid );
+	if( provider )
+	{
+		return provider->pluginUid;
+	}
+
 	for( auto pluginObject : m_pluginObjects )
 	{
 		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
@@ -151,6 +178,20 @@ Plugin::Uid FeatureManager::pluginUid( Feature::Uid featureUid ) const
 
 
 
+const FeatureProviderInterfaceList& FeatureManager::featureProviders( Feature::Uid featureUid ) const
+{
+	const auto it = m_featureMessageDispatchTable.constFind( featureUid );
+	if( it != m_featureMessageDispatchTable.constEnd() )
+	{
+		return *it;
+	}
+
+	// unknown (e.g. dynamically added) feature - offer message to all plugins
+	return m_featurePluginInterfaces;
+}
+
+
+
 void FeatureManager::controlFeature( Feature::Uid featureUid,
 									FeatureProviderInterface::Operation operation,
 									const QVariantMap& arguments,
@@ -213,7 +254,7 @@ void FeatureManager::handleFeatureMessage(ComputerControlInterface::Pointer comp
 {
 	vDebug() << computerControlInterface << message;
 
-	for( const auto& featureInterface : std::as_const( m_featurePluginInterfaces ) )
+	for( const auto& featureInterface : featureProviders( message.featureUid() ) )
 	{
 		featureInterface->handleFeatureMessage(computerControlInterface, message);
 	}
@@ -221,7 +262,7 @@ void FeatureManager::handleFeatureMessage(ComputerControlInterface::Pointer comp
 
 
 
-void FeatureManager::handleFeatureMessage(VeyonServerInterface& server,
+bool FeatureManager::handleFeatureMessage(VeyonServerInterface& server,
 										  const MessageContext& messageContext,
 										  const FeatureMessage& message) const
 {
@@ -230,13 +271,17 @@ void FeatureManager::handleFeatureMessage(VeyonServerInterface& server,
 	if (m_disabledFeaturesUids.contains(message.featureUid()))
 	{
 		vWarning() << "ignoring message as feature" << message.featureUid() << "is disabled by configuration!";
-		return;
+		return false;
 	}
 
-	for( const auto& featureInterface : std::as_const( m_featurePluginInterfaces ) )
+	bool handled = false;
+
+	for( const auto& featureInterface : featureProviders( message.featureUid() ) )
 	{
-		featureInterface->handleFeatureMessage(server, messageContext, message);
+		handled |= featureInterface->handleFeatureMessage(server, messageContext, message);
 	}
+
+	return handled;
 }
 
 
@@ -252,7 +297,7 @@ void FeatureManager::handleFeatureMessageFromWorker(VeyonServerInterface& server
 		return;
 	}
 
-	for (const auto& featureInterface : std::as_const(m_featurePluginInterfaces))
+	for (const auto& featureInterface : featureProviders(message.featureUid()))
 	{
 		featureInterface->handleFeatureMessageFromWorker(server, message);
 	}
@@ -265,7 +310,7 @@ void FeatureManager::handleFeatureMessage(VeyonWorkerInterface& worker, const Fe
 {
 	vDebug() << "[WORKER]" << message;
 
-	for( const auto& featureInterface : std::as_const( m_featurePluginInterfaces ) )
+	for( const auto& featureInterface : featureProviders( message.featureUid() ) )
 	{
 		featureInterface->handleFeatureMessage(worker, message);
 	}
@@ -285,6 +330,13 @@ void FeatureManager::sendAsyncFeatureMessages(VeyonServerInterface& server,
 
 
 
+void FeatureManager::notifyAsyncFeatureMessagesPending()
+{
+	Q_EMIT asyncFeatureMessagesPending();
+}
+
+
+
 FeatureUidList FeatureManager::activeFeatures( VeyonServerInterface& server ) const
 {
 	FeatureUidList features;
@@ -303,3 +355,45 @@ FeatureUidList FeatureManager::activeFeatures( VeyonServerInterface& server ) co
 
 	return features;
 }
+
+
+
+void FeatureManager::buildDispatchTable()
+{
+	for( const auto& pluginObject : std::as_const( m_pluginObjects ) )
+	{
+		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
+		auto featureInterface = qobject_cast<FeatureProviderInterface *>( pluginObject );
+		if( pluginInterface == nullptr || featureInterface == nullptr )
+		{
+			continue;
+		}
+
+		for( const auto& feature : featureInterface->featureList() )
+		{
+			if( m_featureProviderTable.contains( feature.uid() ) == false )
+			{
+				m_featureProviderTable.insert( feature.uid(), { featureInterface, pluginInterface->uid() } );
+			}
+
+			auto& featureInterfaces = m_featureMessageDispatchTable[feature.uid()];
+			if( featureInterfaces.contains( featureInterface ) == false )
+			{
+				featureInterfaces.append( featureInterface );
+			}
+		}
+	}
+}
+
+
+
+const FeatureManager::FeatureProvider* FeatureManager::featureProvider( Feature::Uid featureUid ) const
+{
+	const auto it = m_featureProviderTable.constFind( featureUid );
+	if( it != m_featureProviderTable.constEnd() )
+	{
+		return &(*it);
+	}
+
+	return nullptr;
+}
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QObject>
 
 #include "Feature.h"
@@ -56,6 +57,7 @@ public:
 
 	Plugin::Uid pluginUid( Feature::Uid featureUid ) const;
 
+	const FeatureProviderInterfaceList& featureProviders( Feature::Uid featureUid ) const;
 
 	void controlFeature( Feature::Uid featureUid,
 						FeatureProviderInterface::Operation operation,
@@ -71,7 +73,7 @@ public:
 
 	void handleFeatureMessage(ComputerControlInterface::Pointer computerControlInterface,
 							  const FeatureMessage& message) const;
-	void handleFeatureMessage(VeyonServerInterface& server,
+	bool handleFeatureMessage(VeyonServerInterface& server,
 							  const MessageContext& messageContext,
 							  const FeatureMessage& message) const;
 	void handleFeatureMessageFromWorker(VeyonServerInterface& server,
@@ -80,14 +82,31 @@ public:
 
 	void sendAsyncFeatureMessages(VeyonServerInterface& server, const MessageContext& messageContext) const;
 
+	void notifyAsyncFeatureMessagesPending();
+
 	FeatureUidList activeFeatures( VeyonServerInterface& server ) const;
 
+Q_SIGNALS:
+	void asyncFeatureMessagesPending();
+
 private:
+	struct FeatureProvider
+	{
+		FeatureProviderInterface* featureInterface{nullptr};
+		Plugin::Uid pluginUid;
+	};
+
+	void buildDispatchTable();
+
+	const FeatureProvider* featureProvider( Feature::Uid featureUid ) const;
+
 	FeatureList m_features;
 	FeatureUidList m_disabledFeaturesUids{};
 	const FeatureList m_emptyFeatureList;
 	QObjectList m_pluginObjects;
 	FeatureProviderInterfaceList m_featurePluginInterfaces;
+	QHash<Feature::Uid, FeatureProvider> m_featureProviderTable;
+	QHash<Feature::Uid, FeatureProviderInterfaceList> m_featureMessageDispatchTable;
 	const Feature m_dummyFeature;
 
 };
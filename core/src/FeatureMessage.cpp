@@ -22,6 +22,8 @@
  *
  */
 
+#include <QBuffer>
+
 #include "FeatureManager.h"
 #include "FeatureMessage.h"
 #include "VariantArrayMessage.h"
@@ -64,6 +66,18 @@ bool FeatureMessage::sendAsRfbMessage(QIODevice* ioDevice) const
 
 
 
+QByteArray FeatureMessage::serializeAsRfbMessage() const
+{
+	QBuffer buffer;
+	buffer.open(QBuffer::WriteOnly); // Flawfinder: ignore
+
+	sendAsRfbMessage(&buffer);
+
+	return buffer.data();
+}
+
+
+
 bool FeatureMessage::isReadyForReceive( QIODevice* ioDevice )
 {
 	return ioDevice != nullptr &&
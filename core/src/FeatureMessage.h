@@ -46,6 +46,14 @@ public:
 		DefaultCommand = 0,
 		InvalidCommand = -1,
 		InitCommand = -2,
+		AcknowledgeCommand = -3,
+	};
+
+	// arguments of messages with AcknowledgeCommand sent by the server for messages with a request ID
+	enum class AcknowledgementArgument
+	{
+		Handled,
+		ExecutionTime
 	};
 
 	FeatureMessage() = default;
@@ -109,14 +117,33 @@ public:
 		return m_arguments.contains( QString::number( static_cast<int>( index ) ) );
 	}
 
+	QUuid requestId() const
+	{
+		return m_arguments.value(requestIdArgument()).toUuid();
+	}
+
+	FeatureMessage& setRequestId(QUuid requestId)
+	{
+		m_arguments[requestIdArgument()] = requestId;
+		return *this;
+	}
+
 	bool sendPlain(QIODevice* ioDevice) const;
 	bool sendAsRfbMessage(QIODevice* ioDevice) const;
 
+	// returns the message encoded as RFB message so it can be sent to many connections at once
+	QByteArray serializeAsRfbMessage() const;
+
 	bool isReadyForReceive( QIODevice* ioDevice );
 
 	bool receive( QIODevice* ioDevice );
 
 private:
+	static QString requestIdArgument()
+	{
+		return QStringLiteral("RequestId");
+	}
+
 	FeatureUid m_featureUid{};
 	Command m_command{InvalidCommand};
 	Arguments m_arguments{};
@@ -0,0 +1,228 @@
+/*
+ * FeatureMessageBroadcast.cpp - implementation of FeatureMessageBroadcast class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "FeatureMessageBroadcast.h"
+
+
+// broadcasts which still wait for acknowledgements (only accessed from main thread)
+static QList<FeatureMessageBroadcast *> __activeBroadcasts; // clazy:exclude=non-pod-global-static
+
+
+FeatureMessageBroadcast::FeatureMessageBroadcast(const FeatureMessage& message,
+												 const ComputerControlInterfaceList& computerControlInterfaces,
+												 int retryWindow) :
+	QObject(),
+	m_message(message)
+{
+	m_message.setRequestId(QUuid::createUuid());
+
+	// encode message once for all connections
+	m_serializedMessage = m_message.serializeAsRfbMessage();
+
+	for (const auto& controlInterface : computerControlInterfaces)
+	{
+		if (controlInterface.isNull() || m_hosts.contains(controlInterface.data()))
+		{
+			continue;
+		}
+
+		m_hosts[controlInterface.data()].controlInterface = controlInterface;
+
+		connect(controlInterface.data(), &ComputerControlInterface::stateChanged, this,
+				[this, controlInterface = controlInterface.data()]() { updateState(controlInterface); });
+		connect(controlInterface.data(), &ComputerControlInterface::featureMessageAcknowledged, this,
+				[this, controlInterface = controlInterface.data()](QUuid requestId, bool handled, int executionTime) {
+					acknowledge(controlInterface, requestId, handled, executionTime);
+				});
+	}
+
+	// a newer message for the same feature (e.g. unlock after lock) must not be overtaken
+	// by retries of an older one
+	const auto activeBroadcasts = __activeBroadcasts;
+	for (auto broadcast : activeBroadcasts)
+	{
+		if (broadcast->m_message.featureUid() == m_message.featureUid())
+		{
+			broadcast->supersede(this);
+		}
+	}
+
+	__activeBroadcasts.append(this);
+
+	for (auto& host : m_hosts)
+	{
+		if (host.controlInterface->state() == ComputerControlInterface::State::Connected)
+		{
+			send(host);
+		}
+	}
+
+	m_retryWindowTimer.setSingleShot(true);
+	connect(&m_retryWindowTimer, &QTimer::timeout, this, &FeatureMessageBroadcast::finish);
+	m_retryWindowTimer.start(retryWindow);
+
+	// allow connecting to signals before finishing
+	QTimer::singleShot(0, this, &FeatureMessageBroadcast::checkFinished);
+}
+
+
+
+FeatureMessageBroadcast::~FeatureMessageBroadcast()
+{
+	__activeBroadcasts.removeAll(this);
+}
+
+
+
+void FeatureMessageBroadcast::send(Host& host)
+{
+	host.state = DeliveryState::Sent;
+	host.sendTimer.start();
+	++host.attempts;
+
+	if (host.attempts > 1)
+	{
+		vDebug() << "sending request" << requestId() << "again to" << host.controlInterface;
+	}
+
+	host.controlInterface->sendFeatureMessage(m_message, m_serializedMessage);
+}
+
+
+
+void FeatureMessageBroadcast::updateState(ComputerControlInterface* controlInterface)
+{
+	const auto it = m_hosts.find(controlInterface);
+	if (it == m_hosts.end() || m_finished)
+	{
+		return;
+	}
+
+	const auto connected = controlInterface->state() == ComputerControlInterface::State::Connected;
+
+	if (connected && it->state == DeliveryState::Pending)
+	{
+		send(*it);
+	}
+	else if (connected == false && it->state == DeliveryState::Sent)
+	{
+		// message or acknowledgement might have been lost - the server does not
+		// execute the message twice if it receives it again
+		it->state = DeliveryState::Pending;
+	}
+}
+
+
+
+void FeatureMessageBroadcast::acknowledge(ComputerControlInterface* controlInterface, QUuid requestId,
+										  bool handled, int executionTime)
+{
+	const auto it = m_hosts.find(controlInterface);
+	if (requestId != this->requestId() || it == m_hosts.end() ||
+		it->state == DeliveryState::Acknowledged || it->state == DeliveryState::Superseded)
+	{
+		return;
+	}
+
+	it->state = DeliveryState::Acknowledged;
+	++m_acknowledgedCount;
+	++m_resolvedCount;
+
+	const auto deliveryLatency = int(qMax<qint64>(0, it->sendTimer.elapsed() - executionTime));
+	m_totalDeliveryLatency += deliveryLatency;
+
+	if (handled == false)
+	{
+		vWarning() << "request" << requestId << "has not been handled by" << it->controlInterface;
+	}
+
+	Q_EMIT acknowledged(it->controlInterface, handled, deliveryLatency, executionTime);
+
+	checkFinished();
+}
+
+
+
+void FeatureMessageBroadcast::supersede(const FeatureMessageBroadcast* broadcast)
+{
+	for (auto it = m_hosts.begin(); it != m_hosts.end(); ++it)
+	{
+		if (broadcast->m_hosts.contains(it.key()) &&
+			(it->state == DeliveryState::Pending || it->state == DeliveryState::Sent))
+		{
+			it->state = DeliveryState::Superseded;
+			++m_resolvedCount;
+		}
+	}
+
+	checkFinished();
+}
+
+
+
+void FeatureMessageBroadcast::checkFinished()
+{
+	if (pendingCount() <= 0)
+	{
+		finish();
+	}
+}
+
+
+
+void FeatureMessageBroadcast::finish()
+{
+	if (m_finished)
+	{
+		return;
+	}
+
+	m_finished = true;
+	m_retryWindowTimer.stop();
+
+	__activeBroadcasts.removeAll(this);
+
+	QStringList unacknowledgedHosts;
+	for (const auto& host : std::as_const(m_hosts))
+	{
+		if (host.state == DeliveryState::Pending || host.state == DeliveryState::Sent)
+		{
+			unacknowledgedHosts.append(host.controlInterface->computer().hostName());
+		}
+	}
+
+	if (unacknowledgedHosts.isEmpty() == false)
+	{
+		vWarning() << "request" << requestId() << m_message
+				   << "has not been acknowledged by" << unacknowledgedHosts;
+	}
+
+	vDebug() << "request" << requestId() << "acknowledged by" << m_acknowledgedCount << "of" << m_hosts.size()
+			 << "computers, average delivery latency:"
+			 << (m_acknowledgedCount > 0 ? m_totalDeliveryLatency / m_acknowledgedCount : 0) << "ms";
+
+	Q_EMIT finished();
+
+	deleteLater();
+}
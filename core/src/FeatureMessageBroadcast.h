@@ -0,0 +1,104 @@
+/*
+ * FeatureMessageBroadcast.h - declaration of FeatureMessageBroadcast class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "ComputerControlInterface.h"
+#include "FeatureMessage.h"
+
+// sends a feature message with a request ID to many computers and tracks the acknowledgements
+// of the servers - computers which are not connected or lose their connection before
+// acknowledging the message get it again as soon as they (re)connect within the retry window;
+// the object deletes itself once all computers acknowledged the message or the window expired
+class VEYON_CORE_EXPORT FeatureMessageBroadcast : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr auto DefaultRetryWindow = 60 * 1000;
+
+	FeatureMessageBroadcast(const FeatureMessage& message,
+							const ComputerControlInterfaceList& computerControlInterfaces,
+							int retryWindow = DefaultRetryWindow);
+	~FeatureMessageBroadcast() override;
+
+	QUuid requestId() const
+	{
+		return m_message.requestId();
+	}
+
+	int acknowledgedCount() const
+	{
+		return m_acknowledgedCount;
+	}
+
+	int pendingCount() const
+	{
+		return m_hosts.size() - m_resolvedCount;
+	}
+
+Q_SIGNALS:
+	void acknowledged(ComputerControlInterface::Pointer computerControlInterface, bool handled,
+					  int deliveryLatency, int executionTime);
+	void finished();
+
+private:
+	enum class DeliveryState
+	{
+		Pending,
+		Sent,
+		Acknowledged,
+		Superseded
+	};
+
+	struct Host
+	{
+		ComputerControlInterface::Pointer controlInterface;
+		DeliveryState state{DeliveryState::Pending};
+		int attempts{0};
+		QElapsedTimer sendTimer;
+	};
+
+	void send(Host& host);
+	void updateState(ComputerControlInterface* controlInterface);
+	void acknowledge(ComputerControlInterface* controlInterface, QUuid requestId, bool handled, int executionTime);
+	void supersede(const FeatureMessageBroadcast* broadcast);
+
+	void checkFinished();
+	void finish();
+
+	FeatureMessage m_message;
+	QByteArray m_serializedMessage;
+
+	QHash<ComputerControlInterface *, Host> m_hosts;
+	int m_acknowledgedCount{0};
+	int m_resolvedCount{0};
+	qint64 m_totalDeliveryLatency{0};
+
+	QTimer m_retryWindowTimer{this};
+	bool m_finished{false};
+
+};
@@ -27,6 +27,7 @@
 #include "ComputerControlInterface.h"
 #include "EnumHelper.h"
 #include "FeatureMessage.h"
+#include "FeatureMessageBroadcast.h"
 #include "Feature.h"
 #include "MessageContext.h"
 #include "PluginInterface.h"
@@ -161,7 +162,9 @@ public:
 	}
 
 	/*!
-	 * \brief Send asynchronous messages (e.g. notifications or state updates) to client
+	 * \brief Send asynchronous messages (e.g. notifications or state updates) to client. This is called
+	 * once a connection has been established and for all connections after
+	 * FeatureManager::notifyAsyncFeatureMessagesPending() has been called.
 	 */
 	virtual void sendAsyncFeatureMessages(VeyonServerInterface& server, const MessageContext& messageContext)
 	{
@@ -193,12 +196,23 @@ public:
 protected:
 	void sendFeatureMessage(const FeatureMessage& message, const ComputerControlInterfaceList& computerControlInterfaces)
 	{
+		// encode message once for all connections
+		const auto serializedMessage = message.serializeAsRfbMessage();
+
 		for (const auto& controlInterface : computerControlInterfaces)
 		{
-			controlInterface->sendFeatureMessage(message);
+			controlInterface->sendFeatureMessage(message, serializedMessage);
 		}
 	}
 
+	// sends message like sendFeatureMessage() but waits for acknowledgements of all servers and
+	// sends it again to computers which (re)connect within the retry window
+	FeatureMessageBroadcast* sendTrackedFeatureMessage(const FeatureMessage& message,
+													   const ComputerControlInterfaceList& computerControlInterfaces)
+	{
+		return new FeatureMessageBroadcast(message, computerControlInterfaces);
+	}
+
 };
 
 using FeatureProviderInterfaceList = QList<FeatureProviderInterface *>;
@@ -32,6 +32,7 @@
 #include "Filesystem.h"
 #include "VeyonConfiguration.h"
 #include "VeyonCore.h"
+#include "VeyonServerInterface.h"
 #include "PlatformCoreFunctions.h"
 #include "PlatformUserFunctions.h"
 
@@ -46,7 +47,7 @@ FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, QObjec
 			 this, &FeatureWorkerManager::acceptConnection );
 
 	if( !m_tcpServer.listen( QHostAddress::LocalHost,
-							 static_cast<quint16>( VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId() ) ) )
+							 static_cast<quint16>( VeyonCore::config().featureWorkerManagerPort() + m_server.sessionId() ) ) )
 	{
 		vCritical() << "can't listen on localhost!";
 	}
@@ -55,6 +56,11 @@ FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, QObjec
 	connect( pendingMessagesTimer, &QTimer::timeout, this, &FeatureWorkerManager::sendPendingMessages );
 
 	pendingMessagesTimer->start( 100 );
+
+	m_idleWorkersTimer.setSingleShot( true );
+	connect( &m_idleWorkersTimer, &QTimer::timeout, this, &FeatureWorkerManager::updateIdleWorkers );
+
+	setPoolSize( VeyonCore::config().featureWorkerPoolSize() );
 }
 
 
@@ -63,6 +69,22 @@ FeatureWorkerManager::~FeatureWorkerManager()
 {
 	m_tcpServer.close();
 
+	m_idleWorkersTimer.stop();
+
+	for( const auto& idleWorker : std::as_const(m_idleWorkers) )
+	{
+		if( idleWorker.socket )
+		{
+			idleWorker.socket->disconnect( this );
+			idleWorker.socket->close();
+		}
+		if( idleWorker.process )
+		{
+			idleWorker.process->terminate();
+		}
+	}
+	m_idleWorkers.clear();
+
 	// properly shutdown all worker processes
 	while( m_workers.isEmpty() == false )
 	{
@@ -72,6 +94,30 @@ FeatureWorkerManager::~FeatureWorkerManager()
 
 
 
+void FeatureWorkerManager::setPoolSize( int poolSize )
+{
+	m_poolSize = qMax( 0, poolSize );
+
+	if( m_poolSize > 0 )
+	{
+		vDebug() << "keeping" << m_poolSize << "idle workers per worker type";
+	}
+
+	// defer so that the server can finish its initialization first
+	m_idleWorkersTimer.start( 0 );
+}
+
+
+
+int FeatureWorkerManager::idleWorkerCount() const
+{
+	return int( std::count_if( m_idleWorkers.constBegin(), m_idleWorkers.constEnd(), []( const IdleWorker& worker ) {
+		return worker.socket && worker.socket->state() == QTcpSocket::ConnectedState;
+	} ) );
+}
+
+
+
 bool FeatureWorkerManager::startManagedSystemWorker( Feature::Uid featureUid )
 {
 	if( thread() != QThread::currentThread() )
@@ -82,28 +128,15 @@ bool FeatureWorkerManager::startManagedSystemWorker( Feature::Uid featureUid )
 
 	stopWorker( featureUid );
 
-	Worker worker;
-
-	worker.process = new QProcess;
-	worker.process->setProcessChannelMode( QProcess::ForwardedChannels );
+	if( assignIdleWorker( featureUid, WorkerType::ManagedSystem ) )
+	{
+		return true;
+	}
 
-	connect( worker.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-			 worker.process, &QProcess::deleteLater );
+	Worker worker;
 
 	vDebug() << "Starting managed system worker for feature" << VeyonCore::featureManager().feature(featureUid).name();
-	if( qEnvironmentVariableIsSet("VEYON_VALGRIND_WORKERS") )
-	{
-		worker.process->start( QStringLiteral("valgrind"),
-							   { QStringLiteral("--error-limit=no"),
-								 QStringLiteral("--leak-check=full"),
-								 QStringLiteral("--show-leak-kinds=all"),
-								 QStringLiteral("--log-file=valgrind-%1.log").arg(VeyonCore::formattedUuid(featureUid)),
-								 VeyonCore::filesystem().workerFilePath(), featureUid.toString() } );
-	}
-	else
-	{
-		worker.process->start( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() } );
-	}
+	worker.process = startSystemWorkerProcess( featureUid.toString(), VeyonCore::formattedUuid(featureUid) );
 
 	m_workersMutex.lock();
 	m_workers[featureUid] = worker;
@@ -124,11 +157,16 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 
 	stopWorker( featureUid );
 
+	if( assignIdleWorker( featureUid, WorkerType::UnmanagedSession ) )
+	{
+		return true;
+	}
+
 	Worker worker;
 
 	vDebug() << "Starting worker (unmanaged session process) for feature" << featureUid;
 
-	const auto currentUser = VeyonCore::platform().userFunctions().currentUser();
+	const auto currentUser = m_server.sessionUser();
 	if( currentUser.isEmpty() )
 	{
 		vDebug() << "could not determine current user - probably a console session with logon screen";
@@ -138,7 +176,8 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 	const auto ret = VeyonCore::platform().coreFunctions().
 					 runProgramAsUser( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() },
 									   currentUser,
-									   VeyonCore::platform().coreFunctions().activeDesktopName() );
+									   VeyonCore::platform().coreFunctions().activeDesktopName(),
+									   workerEnvironment() );
 	if( ret == false )
 	{
 		vWarning() << "failed to start worker for feature" << featureUid;
@@ -258,6 +297,12 @@ void FeatureWorkerManager::processConnection( QTcpSocket* socket )
 	{
 		message.receive(socket);
 
+		if (message.featureUid().isNull() && message.command() == FeatureMessage::InitCommand)
+		{
+			registerIdleWorker(socket, message);
+			continue;
+		}
+
 		m_workersMutex.lock();
 
 		// set socket information
@@ -271,7 +316,12 @@ void FeatureWorkerManager::processConnection( QTcpSocket* socket )
 
 			m_workersMutex.unlock();
 
-			if (message.command() >= 0)
+			// sent by newly started workers as well as by idle workers after the assignment of a feature
+			if (message.command() == FeatureMessage::InitCommand)
+			{
+				Q_EMIT workerConnected(message.featureUid());
+			}
+			else if (message.command() >= 0)
 			{
 				VeyonCore::featureManager().handleFeatureMessageFromWorker(m_server, message);
 			}
@@ -306,6 +356,20 @@ void FeatureWorkerManager::closeConnection( QTcpSocket* socket )
 
 	m_workersMutex.unlock();
 
+	for( auto it = m_idleWorkers.begin(); it != m_idleWorkers.end(); )
+	{
+		if( it->socket == socket )
+		{
+			vDebug() << "removing idle worker after socket has been closed";
+			it = m_idleWorkers.erase( it );
+			m_idleWorkersTimer.start( UnmanagedSessionProcessRetryInterval );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
 	socket->deleteLater();
 }
 
@@ -325,6 +389,12 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 	}
 
 	m_workersMutex.unlock();
+
+	// deliver to already connected (e.g. previously idle) workers right away instead of on next timer event
+	if( thread() == QThread::currentThread() )
+	{
+		sendPendingMessages();
+	}
 }
 
 
@@ -346,3 +416,192 @@ void FeatureWorkerManager::sendPendingMessages()
 
 	m_workersMutex.unlock();
 }
+
+
+
+QProcess* FeatureWorkerManager::startSystemWorkerProcess( const QString& argument, const QString& logName )
+{
+	auto process = new QProcess;
+	process->setProcessChannelMode( QProcess::ForwardedChannels );
+	process->setProcessEnvironment( workerEnvironment() );
+
+	connect( process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+			 process, &QProcess::deleteLater );
+
+	if( qEnvironmentVariableIsSet("VEYON_VALGRIND_WORKERS") )
+	{
+		process->start( QStringLiteral("valgrind"),
+						{ QStringLiteral("--error-limit=no"),
+						  QStringLiteral("--leak-check=full"),
+						  QStringLiteral("--show-leak-kinds=all"),
+						  QStringLiteral("--log-file=valgrind-%1.log").arg(logName),
+						  VeyonCore::filesystem().workerFilePath(), argument } );
+	}
+	else
+	{
+		process->start( VeyonCore::filesystem().workerFilePath(), { argument } );
+	}
+
+	return process;
+}
+
+
+
+QProcessEnvironment FeatureWorkerManager::workerEnvironment() const
+{
+	auto environment = m_server.sessionEnvironment();
+
+	// make workers connect to the manager of the session served even if the server
+	// process itself belongs to a different session
+	if( VeyonCore::config().multiSessionModeEnabled() )
+	{
+		environment.insert( VeyonCore::sessionIdEnvironmentVariable(), QString::number( m_server.sessionId() ) );
+	}
+
+	return environment;
+}
+
+
+
+bool FeatureWorkerManager::assignIdleWorker( Feature::Uid featureUid, WorkerType type )
+{
+	for( auto it = m_idleWorkers.begin(); it != m_idleWorkers.end(); ++it )
+	{
+		if( it->type != type || it->socket.isNull() ||
+			it->socket->state() != QTcpSocket::ConnectedState )
+		{
+			continue;
+		}
+
+		Worker worker;
+		worker.socket = it->socket;
+		worker.process = it->process;
+
+		m_idleWorkers.erase( it );
+
+		vDebug() << "Assigning idle worker to feature" << featureUid;
+
+		// the idle worker confirms with an init message and handles all following messages for this feature
+		FeatureMessage( featureUid, FeatureMessage::InitCommand ).sendPlain( worker.socket );
+
+		m_workersMutex.lock();
+		m_workers[featureUid] = worker;
+		m_workersMutex.unlock();
+
+		// replace the assigned worker
+		m_idleWorkersTimer.start( 0 );
+
+		return true;
+	}
+
+	return false;
+}
+
+
+
+void FeatureWorkerManager::registerIdleWorker( QTcpSocket* socket, const FeatureMessage& message )
+{
+	const auto processId = message.argument( InitArgument::ProcessId ).toLongLong();
+
+	// managed system workers can be identified through their process while all
+	// others have been launched as unmanaged session processes
+	auto idleWorker = std::find_if( m_idleWorkers.begin(), m_idleWorkers.end(), [=]( const IdleWorker& worker ) {
+		return worker.socket.isNull() && worker.process && worker.process->processId() == processId;
+	} );
+
+	if( idleWorker == m_idleWorkers.end() )
+	{
+		idleWorker = std::find_if( m_idleWorkers.begin(), m_idleWorkers.end(), []( const IdleWorker& worker ) {
+			return worker.socket.isNull() && worker.type == WorkerType::UnmanagedSession;
+		} );
+	}
+
+	if( idleWorker == m_idleWorkers.end() )
+	{
+		vWarning() << "closing connection of unexpected idle worker" << processId;
+		socket->close();
+		return;
+	}
+
+	vDebug() << "idle worker" << processId << "connected";
+
+	idleWorker->socket = socket;
+}
+
+
+
+void FeatureWorkerManager::updateIdleWorkers()
+{
+	// discard idle workers which exited or failed to connect
+	for( auto it = m_idleWorkers.begin(); it != m_idleWorkers.end(); )
+	{
+		const auto connected = it->socket && it->socket->state() == QTcpSocket::ConnectedState;
+		const auto exited = it->type == WorkerType::ManagedSystem && it->process.isNull();
+
+		if( connected == false && ( exited || it->startTimer.hasExpired( IdleWorkerConnectTimeout ) ) )
+		{
+			if( it->process )
+			{
+				it->process->kill();
+			}
+			it = m_idleWorkers.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	bool recheck = false;
+
+	for( const auto type : { WorkerType::ManagedSystem, WorkerType::UnmanagedSession } )
+	{
+		auto count = std::count_if( m_idleWorkers.constBegin(), m_idleWorkers.constEnd(),
+									[type]( const IdleWorker& worker ) { return worker.type == type; } );
+
+		while( count < m_poolSize && startIdleWorker( type ) )
+		{
+			++count;
+		}
+
+		recheck |= count < m_poolSize;
+	}
+
+	recheck |= std::any_of( m_idleWorkers.constBegin(), m_idleWorkers.constEnd(),
+							[]( const IdleWorker& worker ) { return worker.socket.isNull(); } );
+
+	if( recheck )
+	{
+		m_idleWorkersTimer.start( UnmanagedSessionProcessRetryInterval );
+	}
+}
+
+
+
+bool FeatureWorkerManager::startIdleWorker( WorkerType type )
+{
+	IdleWorker idleWorker;
+	idleWorker.type = type;
+
+	if( type == WorkerType::ManagedSystem )
+	{
+		idleWorker.process = startSystemWorkerProcess( idleWorkerArgument(), QStringLiteral("idle") );
+	}
+	else
+	{
+		const auto currentUser = m_server.sessionUser();
+		if( currentUser.isEmpty() ||
+			VeyonCore::platform().coreFunctions().runProgramAsUser( VeyonCore::filesystem().workerFilePath(),
+																	{ idleWorkerArgument() }, currentUser,
+																	VeyonCore::platform().coreFunctions().activeDesktopName(),
+																	workerEnvironment() ) == false )
+		{
+			return false;
+		}
+	}
+
+	idleWorker.startTimer.start();
+	m_idleWorkers.append( idleWorker );
+
+	return true;
+}
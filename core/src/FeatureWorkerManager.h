@@ -24,10 +24,12 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QPointer>
 #include <QProcess>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QTimer>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 #include <QRecursiveMutex>
@@ -44,9 +46,21 @@ class VEYON_CORE_EXPORT FeatureWorkerManager : public QObject
 {
 	Q_OBJECT
 public:
+	enum class InitArgument {
+		ProcessId
+	};
+
 	FeatureWorkerManager( VeyonServerInterface& server, QObject* parent = nullptr );
 	~FeatureWorkerManager() override;
 
+	static QString idleWorkerArgument()
+	{
+		return QStringLiteral("--idle");
+	}
+
+	void setPoolSize( int poolSize );
+	int idleWorkerCount() const;
+
 	bool startManagedSystemWorker( Feature::Uid featureUid );
 	bool startUnmanagedSessionWorker( Feature::Uid featureUid );
 
@@ -57,7 +71,23 @@ public:
 
 	bool isWorkerRunning( Feature::Uid featureUid );
 
+Q_SIGNALS:
+	void workerConnected( Feature::Uid featureUid );
+
 private:
+	enum class WorkerType {
+		ManagedSystem,
+		UnmanagedSession
+	};
+
+	QProcess* startSystemWorkerProcess( const QString& argument, const QString& logName );
+	QProcessEnvironment workerEnvironment() const;
+
+	bool assignIdleWorker( Feature::Uid featureUid, WorkerType type );
+	void registerIdleWorker( QTcpSocket* socket, const FeatureMessage& message );
+	void updateIdleWorkers();
+	bool startIdleWorker( WorkerType type );
+
 	void acceptConnection();
 	void processConnection( QTcpSocket* socket );
 	void closeConnection( QTcpSocket* socket );
@@ -67,6 +97,7 @@ private:
 	void sendPendingMessages();
 
 	static constexpr auto UnmanagedSessionProcessRetryInterval = 5000;
+	static constexpr auto IdleWorkerConnectTimeout = 30000;
 
 	VeyonServerInterface& m_server;
 	QTcpServer m_tcpServer;
@@ -81,6 +112,19 @@ private:
 	using WorkerMap = QMap<Feature::Uid, Worker>;
 	WorkerMap m_workers;
 
+	// pre-initialized workers waiting for a feature assignment - only accessed from the manager's thread
+	struct IdleWorker
+	{
+		QPointer<QTcpSocket> socket;
+		QPointer<QProcess> process;
+		WorkerType type;
+		QElapsedTimer startTimer;
+	};
+
+	QList<IdleWorker> m_idleWorkers;
+	int m_poolSize{0};
+	QTimer m_idleWorkersTimer{this};
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	QRecursiveMutex m_workersMutex;
 #else
@@ -0,0 +1,109 @@
+/*
+ * FramebufferTimestamp.h - encode timestamps into synthetic framebuffers
+ *
+ * Copyright (c) 2020-2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QImage>
+
+#include <algorithm>
+
+// encodes a millisecond timestamp as a row of black and white blocks at the top of
+// the framebuffer so it survives lossy encodings and can be decoded on the master side -
+// further rows carry other values such as the last pointer position received by the server
+class FramebufferTimestamp
+{
+public:
+	static constexpr int BlockSize = 8;
+	static constexpr int MarkerBlockCount = 2;
+	static constexpr int BitCount = 48;
+	static constexpr int Width = ( MarkerBlockCount + BitCount ) * BlockSize;
+	static constexpr qint64 InvalidTimestamp = -1;
+
+	static constexpr int TimestampRow = 0;
+	static constexpr int PointerPositionRow = 1;
+
+	static void encode( QImage& image, qint64 timestamp, int row = TimestampRow )
+	{
+		if( image.width() < Width || image.height() < ( row + 1 ) * BlockSize )
+		{
+			return;
+		}
+
+		// white/black marker allows detecting framebuffers without timestamp
+		fillBlock( image, row, 0, true );
+		fillBlock( image, row, 1, false );
+
+		for( int bit = 0; bit < BitCount; ++bit )
+		{
+			fillBlock( image, row, MarkerBlockCount + bit, ( timestamp >> bit ) & 1 );
+		}
+	}
+
+	static qint64 decode( const QImage& image, int row = TimestampRow )
+	{
+		if( image.width() < Width || image.height() < ( row + 1 ) * BlockSize ||
+			isBlockSet( image, row, 0 ) == false || isBlockSet( image, row, 1 ) )
+		{
+			return InvalidTimestamp;
+		}
+
+		qint64 timestamp = 0;
+		for( int bit = 0; bit < BitCount; ++bit )
+		{
+			if( isBlockSet( image, row, MarkerBlockCount + bit ) )
+			{
+				timestamp |= qint64(1) << bit;
+			}
+		}
+
+		return timestamp;
+	}
+
+	static qint64 encodePointerPosition( int x, int y )
+	{
+		return ( qint64(x) << 16 ) | ( y & 0xffff );
+	}
+
+	static QPoint decodePointerPosition( qint64 value )
+	{
+		return { int( ( value >> 16 ) & 0xffff ), int( value & 0xffff ) };
+	}
+
+private:
+	static void fillBlock( QImage& image, int row, int index, bool set )
+	{
+		const auto color = set ? qRgb( 255, 255, 255 ) : qRgb( 0, 0, 0 );
+		for( int y = row * BlockSize; y < ( row + 1 ) * BlockSize; ++y )
+		{
+			auto line = reinterpret_cast<QRgb *>( image.scanLine( y ) ) + index * BlockSize;
+			std::fill( line, line + BlockSize, color );
+		}
+	}
+
+	static bool isBlockSet( const QImage& image, int row, int index )
+	{
+		return qGray( image.pixel( index * BlockSize + BlockSize / 2, row * BlockSize + BlockSize / 2 ) ) > 127;
+	}
+
+};
@@ -155,6 +155,7 @@ bool MonitoringMode::handleFeatureMessage( ComputerControlInterface::Pointer com
 	{
 		computerControlInterface->setServerVersion(message.argument(Argument::ApplicationVersion)
 												   .value<VeyonCore::ApplicationVersion>());
+		computerControlInterface->setServerSupportsFlowControl(message.argument(Argument::FlowControlSupported).toBool());
 		return true;
 	}
 
@@ -245,7 +246,8 @@ bool MonitoringMode::handleFeatureMessage(VeyonServerInterface& server,
 	{
 		server.sendFeatureMessageReply(messageContext,
 									   FeatureMessage{m_queryApplicationVersionFeature.uid()}
-									   .addArgument(Argument::ApplicationVersion, int(VeyonCore::config().applicationVersion())));
+									   .addArgument(Argument::ApplicationVersion, int(VeyonCore::config().applicationVersion()))
+									   .addArgument(Argument::FlowControlSupported, true));
 	}
 
 	if (m_queryActiveFeatures.uid() == message.featureUid())
@@ -325,6 +327,16 @@ bool MonitoringMode::sendUserInformation(VeyonServerInterface& server, const Mes
 {
 	FeatureMessage message{m_queryUserInfoFeature.uid()};
 
+	// the cached user information belongs to the session of this process
+	if (server.servesProcessSession() == false)
+	{
+		const auto userLoginName = server.sessionUser();
+		message.addArgument(Argument::UserLoginName, userLoginName);
+		message.addArgument(Argument::UserFullName, userLoginName.isEmpty() ? QString{} : userFullName(userLoginName));
+
+		return server.sendFeatureMessageReply(messageContext, message);
+	}
+
 	m_userDataLock.lockForRead();
 	if (m_userLoginName.isEmpty())
 	{
@@ -348,6 +360,25 @@ bool MonitoringMode::sendSessionInfo(VeyonServerInterface& server, const Message
 {
 	FeatureMessage message{m_querySessionInfoFeature.uid()};
 
+	if (server.servesProcessSession() == false)
+	{
+		auto sessionInfo = VeyonCore::platform().sessionFunctions().querySessionInfo(server.sessionEnvironment());
+		sessionInfo.id = server.sessionId();
+		if (m_sessionMetaDataContent == PlatformSessionFunctions::SessionMetaDataContent::EnvironmentVariable)
+		{
+			sessionInfo.metaData = server.sessionEnvironment().value(m_sessionMetaDataEnvironmentVariable);
+		}
+
+		message.addArgument(Argument::SessionId, sessionInfo.id);
+		message.addArgument(Argument::SessionUptime, sessionInfo.uptime);
+		message.addArgument(Argument::SessionClientAddress, sessionInfo.clientAddress);
+		message.addArgument(Argument::SessionClientName, sessionInfo.clientName);
+		message.addArgument(Argument::SessionHostName, sessionInfo.hostName);
+		message.addArgument(Argument::SessionMetaData, sessionInfo.metaData);
+
+		return server.sendFeatureMessageReply(messageContext, message);
+	}
+
 	m_sessionInfoLock.lockForRead();
 	message.addArgument(Argument::SessionId, m_sessionInfo.id);
 	message.addArgument(Argument::SessionUptime, m_sessionInfo.uptime);
@@ -390,6 +421,7 @@ void MonitoringMode::updateActiveFeatures()
 		{
 			m_activeFeatures = activeFeatures;
 			m_activeFeaturesVersion++;
+			notifyAsyncFeatureMessagesPending();
 		}
 	}
 }
@@ -406,14 +438,20 @@ void MonitoringMode::updateUserInfo()
 			const auto userLoginName = VeyonCore::platform().userFunctions().currentUser();
 			const auto userFullName = VeyonCore::platform().userFunctions().fullName( userLoginName );
 			m_userDataLock.lockForWrite();
-			if(m_userLoginName != userLoginName ||
-			   m_userFullName != userFullName)
+			const auto userInfoChanged = m_userLoginName != userLoginName ||
+										 m_userFullName != userFullName;
+			if (userInfoChanged)
 			{
 				m_userLoginName = userLoginName;
 				m_userFullName = userFullName;
 				++m_userInfoVersion;
 			}
 			m_userDataLock.unlock();
+
+			if (userInfoChanged)
+			{
+				notifyAsyncFeatureMessagesPending();
+			}
 		}
 
 		m_userDataLock.lockForRead();
@@ -427,6 +465,37 @@ void MonitoringMode::updateUserInfo()
 
 
 
+QString MonitoringMode::userFullName(const QString& userLoginName)
+{
+	m_userDataLock.lockForRead();
+	const auto cachedFullName = m_userFullNames.constFind(userLoginName);
+	const auto isCached = cachedFullName != m_userFullNames.constEnd();
+	const auto fullName = isCached ? *cachedFullName : QString{};
+	m_userDataLock.unlock();
+
+	if (isCached == false)
+	{
+		m_userDataLock.lockForWrite();
+		m_userFullNames.insert(userLoginName, {});
+		m_userDataLock.unlock();
+
+		// resolving the full name might block, therefore resend the user information once it's available
+		(void) QtConcurrent::run([=]() {
+			const auto resolvedFullName = VeyonCore::platform().userFunctions().fullName(userLoginName);
+			m_userDataLock.lockForWrite();
+			m_userFullNames[userLoginName] = resolvedFullName;
+			++m_userInfoVersion;
+			m_userDataLock.unlock();
+
+			notifyAsyncFeatureMessagesPending();
+		});
+	}
+
+	return fullName;
+}
+
+
+
 void MonitoringMode::updateSessionInfo()
 {
 	(void) QtConcurrent::run([=]() {
@@ -453,18 +522,35 @@ void MonitoringMode::updateSessionInfo()
 		};
 
 		m_sessionInfoLock.lockForWrite();
-		if (currentSessionInfo != m_sessionInfo)
+		const auto sessionInfoChanged = currentSessionInfo != m_sessionInfo;
+		if (sessionInfoChanged)
 		{
 			m_sessionInfo = currentSessionInfo;
 			++m_sessionInfoVersion;
 		}
 		m_sessionInfoLock.unlock();
+
+		if (sessionInfoChanged)
+		{
+			notifyAsyncFeatureMessagesPending();
+		}
 	});
 }
 
 
 
 
+void MonitoringMode::notifyAsyncFeatureMessagesPending()
+{
+	// always notify from the main thread which also ensures the FeatureManager has been created
+	// when called during construction
+	QMetaObject::invokeMethod(this, []() {
+		VeyonCore::featureManager().notifyAsyncFeatureMessagesPending();
+	}, Qt::QueuedConnection);
+}
+
+
+
 void MonitoringMode::updateScreenInfoList()
 {
 	const auto screens = QGuiApplication::screens();
@@ -488,5 +574,6 @@ void MonitoringMode::updateScreenInfoList()
 	{
 		m_screenInfoList = screenInfoList;
 		++m_screenInfoListVersion;
+		notifyAsyncFeatureMessagesPending();
 	}
 }
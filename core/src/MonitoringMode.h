@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QTimer>
 
 #include "FeatureProviderInterface.h"
@@ -47,6 +48,7 @@ public:
 		SessionClientAddress,
 		SessionClientName,
 		SessionMetaData,
+		FlowControlSupported,
 		ActiveFeaturesList = 0 // for compatibility after migration from FeatureControl
 	};
 	Q_ENUM(Argument)
@@ -156,9 +158,12 @@ private:
 
 	void updateActiveFeatures();
 	void updateUserInfo();
+	QString userFullName(const QString& userLoginName);
 	void updateSessionInfo();
 	void updateScreenInfoList();
 
+	void notifyAsyncFeatureMessagesPending();
+
 	enum Command
 	{
 		Ping,
@@ -184,6 +189,7 @@ private:
 	QReadWriteLock m_userDataLock;
 	QString m_userLoginName;
 	QString m_userFullName;
+	QHash<QString, QString> m_userFullNames;
 	QAtomicInt m_userInfoVersion{0};
 
 	QVariantList m_screenInfoList;
@@ -0,0 +1,122 @@
+/*
+ * MultiSessionServerControl.h - commands for controlling a server serving multiple sessions
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QProcessEnvironment>
+
+// a server process started with the environment variable below set serves multiple sessions
+// and gets told which sessions to open and close through line-based commands on its standard
+// input so that only the process which started the server can control it
+namespace MultiSessionServerControl
+{
+
+struct Command
+{
+	enum class Type
+	{
+		Invalid,
+		OpenSession,
+		CloseSession
+	};
+
+	Type type{Type::Invalid};
+	int sessionId{-1};
+	QString sessionUser;
+	QProcessEnvironment sessionEnvironment;
+};
+
+inline const char* environmentVariable()
+{
+	return "VEYON_MULTI_SESSION_SERVER";
+}
+
+inline bool isEnabled()
+{
+	return qEnvironmentVariableIntValue( environmentVariable() ) > 0;
+}
+
+inline QByteArray openSessionCommand( int sessionId, const QString& sessionUser,
+									  const QProcessEnvironment& sessionEnvironment )
+{
+	return QByteArrayLiteral("open ") + QByteArray::number( sessionId ) + ' ' +
+		   sessionUser.toUtf8().toBase64() + ' ' +
+		   sessionEnvironment.toStringList().join( QLatin1Char('\0') ).toUtf8().toBase64() + '\n';
+}
+
+inline QByteArray closeSessionCommand( int sessionId )
+{
+	return QByteArrayLiteral("close ") + QByteArray::number( sessionId ) + '\n';
+}
+
+inline Command parseCommand( const QByteArray& line )
+{
+	// do not trim fields which may be empty
+	auto data = line;
+	while( data.endsWith( '\n' ) || data.endsWith( '\r' ) )
+	{
+		data.chop( 1 );
+	}
+
+	const auto fields = data.split( ' ' );
+
+	Command command;
+
+	bool ok = false;
+	command.sessionId = fields.value( 1 ).toInt( &ok );
+	if( ok == false || command.sessionId < 0 )
+	{
+		return {};
+	}
+
+	if( fields.value( 0 ) == "open" && fields.size() == 4 )
+	{
+		command.type = Command::Type::OpenSession;
+		command.sessionUser = QString::fromUtf8( QByteArray::fromBase64( fields[2] ) );
+
+		const auto variables = QString::fromUtf8( QByteArray::fromBase64( fields[3] ) ).split( QLatin1Char('\0') );
+		for( const auto& variable : variables )
+		{
+			const auto separator = variable.indexOf( QLatin1Char('=') );
+			if( separator > 0 )
+			{
+				command.sessionEnvironment.insert( variable.left( separator ), variable.mid( separator + 1 ) );
+			}
+		}
+	}
+	else if( fields.value( 0 ) == "close" && fields.size() == 2 )
+	{
+		command.type = Command::Type::CloseSession;
+	}
+	else
+	{
+		return {};
+	}
+
+	return command;
+}
+
+}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QFile>
+#include <QProcessEnvironment>
 
 #include "Logger.h"
 #include "PlatformPluginInterface.h"
@@ -58,10 +59,12 @@ public:
 	virtual bool isRunningAsAdmin() const = 0;
 	virtual bool runProgramAsAdmin( const QString& program, const QStringList& parameters ) = 0;
 
+	// an empty environment makes the program inherit the environment of the calling process
 	virtual bool runProgramAsUser( const QString& program,
 								   const QStringList& parameters,
 								   const QString& username,
-								   const QString& desktop ) = 0;
+								   const QString& desktop,
+								   const QProcessEnvironment& environment = {} ) = 0;
 
 	virtual QString genericUrlHandler() const = 0;
 
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QProcessEnvironment>
+
 #include "VeyonCore.h"
 
 // clazy:excludeall=copyable-polymorphic
@@ -85,4 +87,18 @@ public:
 	virtual EnvironmentVariables currentSessionEnvironmentVariables() const = 0;
 	virtual QVariant querySettingsValueInCurrentSession(const QString& key) const = 0;
 
+	// queries uptime, client and host of the session described by the given environment -
+	// the session ID and meta data are not filled in
+	virtual SessionInfo querySessionInfo(const QProcessEnvironment& sessionEnvironment) const
+	{
+		Q_UNUSED(sessionEnvironment)
+
+		SessionInfo sessionInfo;
+		sessionInfo.uptime = currentSessionUptime();
+		sessionInfo.clientAddress = currentSessionClientAddress();
+		sessionInfo.clientName = currentSessionClientName();
+		sessionInfo.hostName = currentSessionHostName();
+		return sessionInfo;
+	}
+
 };
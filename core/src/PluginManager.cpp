@@ -26,11 +26,24 @@
 
 #include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QPluginLoader>
+#include <QSaveFile>
+#include <QStandardPaths>
 
+#include "CommandLinePluginInterface.h"
+#include "ConfigurationPagePluginInterface.h"
+#include "FeatureProviderInterface.h"
 #include "Logger.h"
+#include "NetworkObjectDirectoryPluginInterface.h"
+#include "PlatformPluginInterface.h"
 #include "PluginManager.h"
+#include "UserGroupsBackendInterface.h"
 #include "VeyonConfiguration.h"
+#include "VncServerPluginInterface.h"
 
 
 PluginManager::PluginManager( QObject* parent ) :
@@ -38,6 +51,7 @@ PluginManager::PluginManager( QObject* parent ) :
 	m_pluginInterfaces(),
 	m_pluginObjects(),
 	m_pluginLoaders(),
+	m_metaDataCacheEnabled( qEnvironmentVariableIsSet( metaDataCacheDisabledEnvironmentVariable() ) == false ),
 	m_noDebugMessages( qEnvironmentVariableIsSet( Logger::logLevelEnvironmentVariable() ) )
 {
 	initPluginSearchPath();
@@ -62,14 +76,14 @@ PluginManager::~PluginManager()
 
 void PluginManager::loadPlatformPlugins()
 {
-	loadPlugins( QStringLiteral("*-platform") + VeyonCore::sharedLibrarySuffix() );
+	loadPlugins( QStringLiteral("*-platform") + VeyonCore::sharedLibrarySuffix(), {} );
 }
 
 
 
-void PluginManager::loadPlugins()
+void PluginManager::loadPlugins( const PluginFilter& filter )
 {
-	loadPlugins( QStringLiteral("*") + VeyonCore::sharedLibrarySuffix() );
+	loadPlugins( QStringLiteral("*") + VeyonCore::sharedLibrarySuffix(), filter );
 }
 
 
@@ -156,6 +170,15 @@ QString PluginManager::pluginName( Plugin::Uid pluginUid ) const
 		}
 	}
 
+	// plugin may not have been loaded in this process
+	for( const auto& metaData : m_pluginMetaData )
+	{
+		if( metaData.uid == pluginUid )
+		{
+			return metaData.name;
+		}
+	}
+
 	return {};
 }
 
@@ -190,14 +213,21 @@ void PluginManager::initPluginSearchPath()
 
 
 
-void PluginManager::loadPlugins( const QString& nameFilter )
+void PluginManager::loadPlugins( const QString& nameFilter, const PluginFilter& filter )
 {
+	QElapsedTimer loadTimer;
+	loadTimer.start();
+
+	loadMetaDataCache();
+
 	QFileInfoList plugins;
 	for (const auto& pluginSearchPath : std::as_const(m_pluginSearchPaths))
 	{
 		plugins.append(QDir(pluginSearchPath).entryInfoList({nameFilter}));
 	}
 
+	int skippedPlugins = 0;
+
 	for( const auto& fileInfo : plugins )
 	{
 		const auto fileName = fileInfo.fileName();
@@ -209,6 +239,17 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 			continue;
 		}
 
+		const auto cachedMetaData = m_pluginMetaData.find( fileInfo.filePath() );
+		const auto hasValidMetaData = cachedMetaData != m_pluginMetaData.end() &&
+									  isMetaDataValid( *cachedMetaData, fileInfo );
+
+		// do not even load plugins not required by the current process
+		if( filter && hasValidMetaData && filter( *cachedMetaData ) == false )
+		{
+			++skippedPlugins;
+			continue;
+		}
+
 		auto pluginLoader = new QPluginLoader( fileInfo.filePath(), this );
 		auto pluginObject = pluginLoader->instance();
 		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
@@ -216,6 +257,21 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 		if( pluginObject && pluginInterface &&
 			m_pluginInterfaces.contains( pluginInterface ) == false )
 		{
+			if( hasValidMetaData == false )
+			{
+				m_pluginMetaData[fileInfo.filePath()] = createMetaData( fileInfo, pluginObject );
+				m_metaDataCacheModified = true;
+
+				// plugin had to be loaded for creating the meta data but is not required otherwise
+				if( filter && filter( m_pluginMetaData[fileInfo.filePath()] ) == false )
+				{
+					pluginLoader->unload();
+					delete pluginLoader;
+					++skippedPlugins;
+					continue;
+				}
+			}
+
 			if( m_noDebugMessages == false )
 			{
 				vDebug() << "discovered plugin" << pluginInterface->name() << "at" << fileInfo.filePath();
@@ -229,4 +285,190 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 			delete pluginLoader;
 		}
 	}
+
+	if( m_metaDataCacheModified )
+	{
+		saveMetaDataCache();
+	}
+
+	if( m_noDebugMessages == false )
+	{
+		vDebug() << "loaded" << m_pluginInterfaces.size() << "plugins, skipped" << skippedPlugins
+				 << "plugins in" << loadTimer.elapsed() << "ms";
+	}
+}
+
+
+
+void PluginManager::loadMetaDataCache()
+{
+	if( m_metaDataCacheEnabled == false || m_metaDataCacheLoaded )
+	{
+		return;
+	}
+
+	m_metaDataCacheLoaded = true;
+
+	QFile cacheFile( metaDataCacheFilePath() );
+	if( cacheFile.open( QFile::ReadOnly ) == false )
+	{
+		return;
+	}
+
+	const auto cache = QJsonDocument::fromJson( cacheFile.readAll() ).object();
+
+	// discard cache written by other versions as plugin interfaces may have changed
+	if( cache[QStringLiteral("version")].toString() != VeyonCore::versionString() )
+	{
+		return;
+	}
+
+	const auto plugins = cache[QStringLiteral("plugins")].toArray();
+	for( const auto& pluginValue : plugins )
+	{
+		const auto plugin = pluginValue.toObject();
+
+		PluginMetaData metaData;
+		metaData.filePath = plugin[QStringLiteral("filePath")].toString();
+		metaData.lastModified = plugin[QStringLiteral("lastModified")].toVariant().toLongLong();
+		metaData.size = plugin[QStringLiteral("size")].toVariant().toLongLong();
+		metaData.uid = Plugin::Uid{plugin[QStringLiteral("uid")].toString()};
+		metaData.name = plugin[QStringLiteral("name")].toString();
+		metaData.flags = Plugin::Flags(plugin[QStringLiteral("flags")].toInt());
+		metaData.interfaces = plugin[QStringLiteral("interfaces")].toVariant().toStringList();
+		const auto featureUids = plugin[QStringLiteral("featureUids")].toArray();
+		for( const auto& featureUid : featureUids )
+		{
+			metaData.featureUids.append( Feature::Uid{featureUid.toString()} );
+		}
+		metaData.commandLineModuleName = plugin[QStringLiteral("commandLineModuleName")].toString();
+		metaData.commands = plugin[QStringLiteral("commands")].toVariant().toStringList();
+
+		if( metaData.filePath.isEmpty() == false && metaData.uid.isNull() == false )
+		{
+			m_pluginMetaData[metaData.filePath] = metaData;
+		}
+	}
+}
+
+
+
+void PluginManager::saveMetaDataCache()
+{
+	m_metaDataCacheModified = false;
+
+	if( m_metaDataCacheEnabled == false )
+	{
+		return;
+	}
+
+	QJsonArray plugins;
+	for( const auto& metaData : std::as_const(m_pluginMetaData) )
+	{
+		QJsonArray featureUids;
+		for( const auto& featureUid : metaData.featureUids )
+		{
+			featureUids.append( featureUid.toString() );
+		}
+
+		plugins.append( QJsonObject{
+			{ QStringLiteral("filePath"), metaData.filePath },
+			{ QStringLiteral("lastModified"), metaData.lastModified },
+			{ QStringLiteral("size"), metaData.size },
+			{ QStringLiteral("uid"), metaData.uid.toString() },
+			{ QStringLiteral("name"), metaData.name },
+			{ QStringLiteral("flags"), int(metaData.flags) },
+			{ QStringLiteral("interfaces"), QJsonArray::fromStringList( metaData.interfaces ) },
+			{ QStringLiteral("featureUids"), featureUids },
+			{ QStringLiteral("commandLineModuleName"), metaData.commandLineModuleName },
+			{ QStringLiteral("commands"), QJsonArray::fromStringList( metaData.commands ) },
+		} );
+	}
+
+	const QFileInfo cacheFileInfo( metaDataCacheFilePath() );
+	if( QDir().mkpath( cacheFileInfo.absolutePath() ) == false )
+	{
+		vDebug() << "could not create cache directory" << cacheFileInfo.absolutePath();
+		return;
+	}
+
+	// write atomically as multiple Veyon processes may update the cache concurrently
+	QSaveFile cacheFile( cacheFileInfo.absoluteFilePath() );
+	if( cacheFile.open( QFile::WriteOnly ) == false )
+	{
+		vDebug() << "could not write plugin meta data cache" << cacheFile.fileName();
+		return;
+	}
+
+	cacheFile.write( QJsonDocument( QJsonObject{
+									   { QStringLiteral("version"), VeyonCore::versionString() },
+									   { QStringLiteral("plugins"), plugins }
+								   } ).toJson( QJsonDocument::Compact ) );
+	cacheFile.commit();
+}
+
+
+
+QString PluginManager::metaDataCacheFilePath() const
+{
+	return QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) +
+			QDir::separator() + QStringLiteral("PluginMetaData.json");
+}
+
+
+
+PluginManager::PluginMetaData PluginManager::createMetaData( const QFileInfo& fileInfo, QObject* pluginObject )
+{
+	PluginMetaData metaData;
+
+	metaData.filePath = fileInfo.filePath();
+	metaData.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+	metaData.size = fileInfo.size();
+
+	const auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
+	if( pluginInterface )
+	{
+		metaData.uid = pluginInterface->uid();
+		metaData.name = pluginInterface->name();
+		metaData.flags = pluginInterface->flags();
+	}
+
+	for( const auto interfaceId : { PluginInterface_iid, PlatformPluginInterface_iid, FeatureProviderInterface_iid,
+									 CommandLinePluginInterface_iid, ConfigurationPagePluginInterface_iid,
+									 NetworkObjectDirectoryPluginInterface_iid, UserGroupsBackendInterface_iid,
+									 VncServerPluginInterface_iid } )
+	{
+		if( pluginObject->qt_metacast( interfaceId ) )
+		{
+			metaData.interfaces.append( QLatin1String(interfaceId) );
+		}
+	}
+
+	const auto featureProvider = qobject_cast<FeatureProviderInterface *>( pluginObject );
+	if( featureProvider )
+	{
+		const auto features = featureProvider->featureList();
+		for( const auto& feature : features )
+		{
+			metaData.featureUids.append( feature.uid() );
+		}
+	}
+
+	const auto commandLinePlugin = qobject_cast<CommandLinePluginInterface *>( pluginObject );
+	if( commandLinePlugin )
+	{
+		metaData.commandLineModuleName = commandLinePlugin->commandLineModuleName();
+		metaData.commands = commandLinePlugin->commands();
+	}
+
+	return metaData;
+}
+
+
+
+bool PluginManager::isMetaDataValid( const PluginMetaData& metaData, const QFileInfo& fileInfo )
+{
+	return metaData.uid.isNull() == false &&
+			metaData.size == fileInfo.size() &&
+			metaData.lastModified == fileInfo.lastModified().toMSecsSinceEpoch();
 }
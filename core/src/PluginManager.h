@@ -26,20 +26,45 @@
 
 #include <QObject>
 
+#include "Feature.h"
 #include "Plugin.h"
 #include "PluginInterface.h"
 
+class QFileInfo;
 class QPluginLoader;
 
 class VEYON_CORE_EXPORT PluginManager : public QObject
 {
 	Q_OBJECT
 public:
+	// information about a plugin which is cached persistently so that plugins
+	// not required by the current process do not have to be loaded at all
+	struct PluginMetaData
+	{
+		QString filePath;
+		qint64 lastModified{0};
+		qint64 size{0};
+		Plugin::Uid uid;
+		QString name;
+		Plugin::Flags flags;
+		QStringList interfaces;
+		FeatureUidList featureUids;
+		QString commandLineModuleName;
+		QStringList commands;
+
+		bool implements( const char* interfaceId ) const
+		{
+			return interfaces.contains( QLatin1String(interfaceId) );
+		}
+	};
+	using PluginMetaDataList = QList<PluginMetaData>;
+	using PluginFilter = std::function<bool(const PluginMetaData&)>;
+
 	explicit PluginManager( QObject* parent = nullptr );
 	~PluginManager();
 
 	void loadPlatformPlugins();
-	void loadPlugins();
+	void loadPlugins( const PluginFilter& filter = {} );
 	void upgradePlugins();
 
 	const PluginInterfaceList& pluginInterfaces() const
@@ -60,14 +85,35 @@ public:
 
 	QString pluginName( Plugin::Uid pluginUid ) const;
 
+	PluginMetaDataList pluginMetaData() const
+	{
+		return m_pluginMetaData.values();
+	}
+
+	static const char* metaDataCacheDisabledEnvironmentVariable()
+	{
+		return "VEYON_NO_PLUGIN_CACHE";
+	}
+
 private:
 	void initPluginSearchPath();
-	void loadPlugins( const QString& nameFilter );
+	void loadPlugins( const QString& nameFilter, const PluginFilter& filter );
+
+	void loadMetaDataCache();
+	void saveMetaDataCache();
+	QString metaDataCacheFilePath() const;
+
+	static PluginMetaData createMetaData( const QFileInfo& fileInfo, QObject* pluginObject );
+	static bool isMetaDataValid( const PluginMetaData& metaData, const QFileInfo& fileInfo );
 
 	QStringList m_pluginSearchPaths;
 	PluginInterfaceList m_pluginInterfaces;
 	QObjectList m_pluginObjects;
 	QList<QPluginLoader *> m_pluginLoaders;
+	QHash<QString, PluginMetaData> m_pluginMetaData;
+	bool m_metaDataCacheEnabled;
+	bool m_metaDataCacheLoaded{false};
+	bool m_metaDataCacheModified{false};
 	bool m_noDebugMessages;
 
 };
@@ -0,0 +1,135 @@
+/*
+ * RfbFlowControl.h - definitions of the ContinuousUpdates and Fence RFB extensions
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QRect>
+#include <QtEndian>
+
+// message types, pseudo-encodings and message builders of the ContinuousUpdates and Fence
+// extensions of the RFB protocol (as implemented by TigerVNC) which allow servers to push
+// framebuffer updates without waiting for requests and to measure round trip times in-band
+namespace RfbFlowControl
+{
+
+// client -> server: EnableContinuousUpdates, server -> client: EndOfContinuousUpdates
+static constexpr uint8_t ContinuousUpdatesMessageType = 150;
+static constexpr uint8_t FenceMessageType = 248;
+
+static constexpr int32_t ContinuousUpdatesEncoding = -313;
+static constexpr int32_t FenceEncoding = -312;
+
+static constexpr int EnableContinuousUpdatesMessageSize = 10;
+static constexpr int EndOfContinuousUpdatesMessageSize = 1;
+static constexpr int FenceMessageHeaderSize = 9;
+static constexpr int MaximumFencePayloadSize = 64;
+
+enum FenceFlag : uint32_t
+{
+	FenceBlockBefore = 0x00000001,
+	FenceBlockAfter = 0x00000002,
+	FenceSyncNext = 0x00000004,
+	FenceRequest = 0x80000000
+};
+
+static constexpr uint32_t SupportedFenceFlags = FenceBlockBefore | FenceBlockAfter | FenceSyncNext;
+
+inline QByteArray enableContinuousUpdatesMessage( bool enable, const QRect& rect )
+{
+	QByteArray message( EnableContinuousUpdatesMessageSize, 0 );
+	auto data = reinterpret_cast<uchar *>( message.data() );
+	data[0] = ContinuousUpdatesMessageType;
+	data[1] = enable ? 1 : 0;
+	qToBigEndian<uint16_t>( uint16_t(rect.x()), data + 2 );
+	qToBigEndian<uint16_t>( uint16_t(rect.y()), data + 4 );
+	qToBigEndian<uint16_t>( uint16_t(rect.width()), data + 6 );
+	qToBigEndian<uint16_t>( uint16_t(rect.height()), data + 8 );
+	return message;
+}
+
+inline QRect continuousUpdatesRect( const QByteArray& enableContinuousUpdatesMessage )
+{
+	const auto data = reinterpret_cast<const uchar *>( enableContinuousUpdatesMessage.constData() );
+	return { qFromBigEndian<uint16_t>( data + 2 ), qFromBigEndian<uint16_t>( data + 4 ),
+			 qFromBigEndian<uint16_t>( data + 6 ), qFromBigEndian<uint16_t>( data + 8 ) };
+}
+
+// SetEncodings message containing the pseudo-encodings only - Veyon Server handles the
+// extensions itself and does not forward such a message to the VNC server so the
+// encodings set before remain in effect
+inline QByteArray announcementMessage()
+{
+	static constexpr uint8_t SetEncodingsMessageType = 2;
+	static constexpr int SetEncodingsMessageHeaderSize = 4;
+	static constexpr int EncodingCount = 2;
+
+	QByteArray message( SetEncodingsMessageHeaderSize + EncodingCount * int(sizeof(int32_t)), 0 );
+	auto data = reinterpret_cast<uchar *>( message.data() );
+	data[0] = SetEncodingsMessageType;
+	qToBigEndian<uint16_t>( uint16_t(EncodingCount), data + 2 );
+	qToBigEndian<int32_t>( ContinuousUpdatesEncoding, data + 4 );
+	qToBigEndian<int32_t>( FenceEncoding, data + 8 );
+	return message;
+}
+
+inline QByteArray endOfContinuousUpdatesMessage()
+{
+	return QByteArray( 1, char(ContinuousUpdatesMessageType) );
+}
+
+inline QByteArray fenceMessage( uint32_t flags, const QByteArray& payload )
+{
+	const auto payloadSize = qMin<int>( payload.size(), MaximumFencePayloadSize );
+
+	QByteArray message( FenceMessageHeaderSize, 0 );
+	auto data = reinterpret_cast<uchar *>( message.data() );
+	data[0] = FenceMessageType;
+	qToBigEndian<uint32_t>( flags, data + 4 );
+	data[8] = uchar(payloadSize);
+
+	return message + payload.left( payloadSize );
+}
+
+// returns the flags of a fence message header
+inline uint32_t fenceFlags( const QByteArray& fenceMessageHeader )
+{
+	return qFromBigEndian<uint32_t>( reinterpret_cast<const uchar *>( fenceMessageHeader.constData() ) + 4 );
+}
+
+// returns the payload size announced in a fence message header which has to be validated
+// against MaximumFencePayloadSize by the receiver
+inline int fencePayloadSize( const QByteArray& fenceMessageHeader )
+{
+	return uchar(fenceMessageHeader[8]);
+}
+
+// builds the response to a fence request which has to be sent once all messages preceding
+// the request have been processed - unsupported flags are cleared as required by the protocol
+inline QByteArray fenceResponseMessage( uint32_t requestFlags, const QByteArray& payload )
+{
+	return fenceMessage( requestFlags & SupportedFenceFlags, payload );
+}
+
+}
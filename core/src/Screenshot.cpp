@@ -26,10 +26,13 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
 #include <QMessageBox>
 #include <QMetaEnum>
 #include <QPainter>
 #include <QRegularExpression>
+#include <QtConcurrent>
 
 #include "Screenshot.h"
 #include "VeyonConfiguration.h"
@@ -38,14 +41,27 @@
 #include "Filesystem.h"
 #include "PlatformFilesystemFunctions.h"
 
-Screenshot::Screenshot( const QString &fileName, QObject* parent ) :
+Screenshot::Screenshot( const QString &fileName, QObject* parent, LoadMode loadMode ) :
 	QObject( parent ),
 	m_fileName( fileName ),
 	m_image()
 {
 	if( !m_fileName.isEmpty() && QFileInfo( m_fileName ).isFile() )
 	{
-		m_image.load( m_fileName );
+		if( loadMode == LoadMode::MetaDataOnly )
+		{
+			// only reads embedded texts (e.g. PNG text chunks) without decoding the image data
+			QImageReader imageReader( m_fileName );
+			const auto keys = imageReader.textKeys();
+			for( const auto& key : keys )
+			{
+				m_metaData[key] = imageReader.text( key );
+			}
+		}
+		else
+		{
+			m_image.load( m_fileName );
+		}
 	}
 }
 
@@ -53,121 +69,139 @@ Screenshot::Screenshot( const QString &fileName, QObject* parent ) :
 
 void Screenshot::take( const ComputerControlInterface::Pointer& computerControlInterface )
 {
-	auto userLogin = computerControlInterface->userLoginName();
-	if( userLogin.isEmpty() )
+	auto screenshotCapture = capture( computerControlInterface );
+	if( screenshotCapture.image.isNull() )
 	{
-		userLogin = tr( "unknown" );
+		vWarning() << "no framebuffer available for" << computerControlInterface->computer().hostName();
+		return;
 	}
 
-	const auto dir = VeyonCore::filesystem().screenshotDirectoryPath();
-
-	if( VeyonCore::filesystem().ensurePathExists( dir ) == false )
+	const auto result = save( screenshotCapture );
+	if( result.errorString.isEmpty() == false )
 	{
-		const auto msg = tr( "Could not take a screenshot as directory %1 doesn't exist and couldn't be created." ).arg( dir );
-		vCritical() << msg.toUtf8().constData();
+		vCritical() << result.errorString.toUtf8().constData();
 		if( qobject_cast<QApplication *>( QCoreApplication::instance() ) )
 		{
-			QMessageBox::critical( nullptr, tr( "Screenshot" ), msg );
+			QMessageBox::critical( nullptr, tr( "Screenshot" ), result.errorString );
 		}
 
 		return;
 	}
 
-	// construct filename
-	m_fileName = dir + QDir::separator() + constructFileName(userLogin, computerControlInterface->computer().hostName());
+	m_fileName = result.fileName;
+	m_image = screenshotCapture.image;
 
-	QFile outputFile( m_fileName );
-	if( VeyonCore::platform().filesystemFunctions().openFileSafely(
-			&outputFile,
-			QFile::WriteOnly | QFile::Truncate,
-			QFile::ReadOwner | QFile::WriteOwner ) == false )
+	Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+}
+
+
+
+QFuture<Screenshot::Result> Screenshot::takeAll( const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	const auto timestamp = QDateTime::currentDateTime();
+
+	QVector<Capture> captures;
+	captures.reserve( computerControlInterfaces.size() );
+
+	for( const auto& computerControlInterface : computerControlInterfaces )
 	{
-		const auto msg = tr( "Could not open screenshot file %1 for writing." ).arg( m_fileName );
-		vCritical() << msg.toUtf8().constData();
-		if( qobject_cast<QApplication *>( QCoreApplication::instance() ) )
+		auto screenshotCapture = capture( computerControlInterface, timestamp );
+		if( screenshotCapture.image.isNull() )
 		{
-			QMessageBox::critical( nullptr, tr( "Screenshot" ), msg );
+			vWarning() << "skipping" << screenshotCapture.host << "without framebuffer";
+			continue;
 		}
 
-		return;
+		captures.append( screenshotCapture );
 	}
 
-	// construct caption
-	auto user = userLogin;
-	if( computerControlInterface->userFullName().isEmpty() == false )
-	{
-		user = QStringLiteral( "%1 (%2)" ).arg( userLogin, computerControlInterface->userFullName() );
-	}
+	return QtConcurrent::mapped( captures, &Screenshot::write );
+}
 
-	const auto host = computerControlInterface->computer().hostName();
-	const auto date = QDate::currentDate().toString( Qt::ISODate );
-	const auto time = QTime::currentTime().toString( Qt::ISODate );
 
-	const auto caption = QStringLiteral( "%1@%2 %3 %4" ).arg( user, host, date, time );
 
-	m_image = computerControlInterface->framebuffer();
+Screenshot::Capture Screenshot::capture( const ComputerControlInterface::Pointer& computerControlInterface,
+										 const QDateTime& timestamp )
+{
+	Capture capture;
+	// deep copy as the framebuffer is updated by the connection thread concurrently
+	capture.image = computerControlInterface->framebuffer().copy();
+	capture.userLogin = computerControlInterface->userLoginName();
+	if( capture.userLogin.isEmpty() )
+	{
+		capture.userLogin = tr( "unknown" );
+	}
+	capture.userFullName = computerControlInterface->userFullName();
+	capture.host = computerControlInterface->computer().hostName();
+	capture.date = timestamp.date();
+	capture.time = timestamp.time();
+	capture.directory = VeyonCore::filesystem().screenshotDirectoryPath();
+	capture.format = configuredFormat();
+
+	return capture;
+}
 
-	QPixmap icon( QStringLiteral( ":/core/icon16.png" ) );
 
-	QPainter painter( &m_image );
 
-	auto font = painter.font();
-	font.setPointSize( 14 );
-	font.setBold( true );
-	painter.setFont( font );
+Screenshot::Result Screenshot::write( const Capture& capture )
+{
+	auto annotatedCapture = capture;
 
-	const QFontMetrics fontMetrics( painter.font() );
-#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
-	const auto captionWidth = fontMetrics.horizontalAdvance( caption );
-	const auto captionHeight = fontMetrics.boundingRect( caption ).height();
-#else
-	const auto boundingRect = fontMetrics.boundingRect( caption );
-	const auto captionWidth = boundingRect.width();
-	const auto captionHeight = boundingRect.height();
-#endif
+	return save( annotatedCapture );
+}
 
-	const auto MARGIN = 14;
-	const auto PADDING = 7;
-	const QRect rect{ MARGIN,
-				m_image.height() - MARGIN - 2 * PADDING - captionHeight,
-				4 * PADDING + captionWidth + icon.width(),
-				2 * PADDING + captionHeight };
-	const auto iconX = rect.x() + PADDING + 1;
-	const auto iconY = rect.y() + ( rect.height() - icon.height() ) / 2;
-	const auto textX = iconX + icon.width() + PADDING;
-	const auto textY = rect.y() + PADDING + fontMetrics.ascent();
 
-	painter.fillRect( rect, QColor( 255, 255, 255, 160 ) );
-	painter.drawPixmap( iconX, iconY, icon );
-	painter.drawText( textX, textY, caption );
 
-	m_image.setText( metaDataKey( MetaData::User ), user );
-	m_image.setText( metaDataKey( MetaData::Host ), host );
-	m_image.setText( metaDataKey( MetaData::Date ), date );
-	m_image.setText( metaDataKey( MetaData::Time ), time );
+Screenshot::Format Screenshot::configuredFormat()
+{
+	const auto configuredFormatName = VeyonCore::config().screenshotFormat().toLower();
 
-	m_image.save( &outputFile, "PNG", 50 );
+	auto format = Format::Png;
+	if( configuredFormatName == QLatin1String("jpeg") || configuredFormatName == QLatin1String("jpg") )
+	{
+		format = Format::Jpeg;
+	}
+	else if( configuredFormatName == QLatin1String("webp") )
+	{
+		format = Format::WebP;
+	}
 
-	Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+	if( QImageWriter::supportedImageFormats().contains( formatName( format ) ) == false )
+	{
+		vWarning() << "image format" << formatName( format ) << "not supported - falling back to PNG";
+		return Format::Png;
+	}
+
+	return format;
 }
 
 
 
 QString Screenshot::constructFileName( const QString& user, const QString& hostAddress,
-									   QDate date, QTime time )
+									   QDate date, QTime time, Format format )
 {
 	static const QRegularExpression nonAllowedCharsRX{QStringLiteral("[^a-z0-9.]")};
 	const auto userSimplified = VeyonCore::stripDomain(user).toLower().remove(nonAllowedCharsRX);
 
-	return QStringLiteral( "%1_%2_%3_%4.png" ).arg( userSimplified,
-													hostAddress,
-													date.toString( Qt::ISODate ),
-													time.toString( Qt::ISODate ) ).
+	return QStringLiteral( "%1_%2_%3_%4.%5" ).arg( userSimplified,
+												   hostAddress,
+												   date.toString( Qt::ISODate ),
+												   time.toString( Qt::ISODate ),
+												   fileNameExtension( format ) ).
 			replace( QLatin1Char(':'), QLatin1Char('-') );
 }
 
 
 
+QStringList Screenshot::fileNameFilters()
+{
+	return { QStringLiteral("*.%1").arg( fileNameExtension( Format::Png ) ),
+				QStringLiteral("*.%1").arg( fileNameExtension( Format::Jpeg ) ),
+				QStringLiteral("*.%1").arg( fileNameExtension( Format::WebP ) ) };
+}
+
+
+
 QString Screenshot::user() const
 {
 	return property( metaDataKey( MetaData::User ), 0 );
@@ -206,7 +240,12 @@ QString Screenshot::metaDataKey( MetaData key )
 
 QString Screenshot::property( const QString& key, int section ) const
 {
-	const auto embeddedProperty = m_image.text( key );
+	auto embeddedProperty = m_image.text( key );
+	if( embeddedProperty.isEmpty() )
+	{
+		embeddedProperty = m_metaData.value( key );
+	}
+
 	if( embeddedProperty.isEmpty() )
 	{
 		return fileNameSection( section );
@@ -221,3 +260,122 @@ QString Screenshot::fileNameSection( int n ) const
 {
 	return QFileInfo( fileName() ).fileName().section( QLatin1Char('_'), n, n );
 }
+
+
+
+Screenshot::Result Screenshot::save( Capture& capture )
+{
+	Result result;
+
+	if( VeyonCore::filesystem().ensurePathExists( capture.directory ) == false )
+	{
+		result.errorString = tr( "Could not take a screenshot as directory %1 doesn't exist and couldn't be created." ).arg( capture.directory );
+		return result;
+	}
+
+	result.fileName = capture.directory + QDir::separator() +
+					  constructFileName( capture.userLogin, capture.host, capture.date, capture.time, capture.format );
+
+	QFile outputFile( result.fileName );
+	if( VeyonCore::platform().filesystemFunctions().openFileSafely(
+			&outputFile,
+			QFile::WriteOnly | QFile::Truncate,
+			QFile::ReadOwner | QFile::WriteOwner ) == false )
+	{
+		result.errorString = tr( "Could not open screenshot file %1 for writing." ).arg( result.fileName );
+		return result;
+	}
+
+	// construct caption
+	auto user = capture.userLogin;
+	if( capture.userFullName.isEmpty() == false )
+	{
+		user = QStringLiteral( "%1 (%2)" ).arg( capture.userLogin, capture.userFullName );
+	}
+
+	const auto date = capture.date.toString( Qt::ISODate );
+	const auto time = capture.time.toString( Qt::ISODate );
+
+	annotate( capture.image, QStringLiteral( "%1@%2 %3 %4" ).arg( user, capture.host, date, time ) );
+
+	capture.image.setText( metaDataKey( MetaData::User ), user );
+	capture.image.setText( metaDataKey( MetaData::Host ), capture.host );
+	capture.image.setText( metaDataKey( MetaData::Date ), date );
+	capture.image.setText( metaDataKey( MetaData::Time ), time );
+
+	if( capture.image.save( &outputFile, formatName( capture.format ),
+							capture.format == Format::Png ? PngQuality : LossyQuality ) == false )
+	{
+		result.errorString = tr( "Could not write screenshot file %1." ).arg( result.fileName );
+	}
+
+	return result;
+}
+
+
+
+const char* Screenshot::formatName( Format format )
+{
+	switch( format )
+	{
+	case Format::Png: return "png";
+	case Format::Jpeg: return "jpeg";
+	case Format::WebP: return "webp";
+	}
+
+	return "png";
+}
+
+
+
+QString Screenshot::fileNameExtension( Format format )
+{
+	switch( format )
+	{
+	case Format::Png: return QStringLiteral("png");
+	case Format::Jpeg: return QStringLiteral("jpg");
+	case Format::WebP: return QStringLiteral("webp");
+	}
+
+	return QStringLiteral("png");
+}
+
+
+
+void Screenshot::annotate( QImage& image, const QString& caption )
+{
+	// QPixmap must not be used outside the GUI thread
+	const QImage icon( QStringLiteral( ":/core/icon16.png" ) );
+
+	QPainter painter( &image );
+
+	auto font = painter.font();
+	font.setPointSize( 14 );
+	font.setBold( true );
+	painter.setFont( font );
+
+	const QFontMetrics fontMetrics( painter.font() );
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	const auto captionWidth = fontMetrics.horizontalAdvance( caption );
+	const auto captionHeight = fontMetrics.boundingRect( caption ).height();
+#else
+	const auto boundingRect = fontMetrics.boundingRect( caption );
+	const auto captionWidth = boundingRect.width();
+	const auto captionHeight = boundingRect.height();
+#endif
+
+	const auto MARGIN = 14;
+	const auto PADDING = 7;
+	const QRect rect{ MARGIN,
+				image.height() - MARGIN - 2 * PADDING - captionHeight,
+				4 * PADDING + captionWidth + icon.width(),
+				2 * PADDING + captionHeight };
+	const auto iconX = rect.x() + PADDING + 1;
+	const auto iconY = rect.y() + ( rect.height() - icon.height() ) / 2;
+	const auto textX = iconX + icon.width() + PADDING;
+	const auto textY = rect.y() + PADDING + fontMetrics.ascent();
+
+	painter.fillRect( rect, QColor( 255, 255, 255, 160 ) );
+	painter.drawImage( iconX, iconY, icon );
+	painter.drawText( textX, textY, caption );
+}
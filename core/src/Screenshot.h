@@ -26,7 +26,8 @@
 #include "ComputerControlInterface.h"
 #include "VeyonCore.h"
 
-#include <QDate>
+#include <QDateTime>
+#include <QFuture>
 #include <QImage>
 
 class ComputerControlInterface;
@@ -44,10 +45,55 @@ public:
 	};
 	Q_ENUM(MetaData)
 
-	explicit Screenshot( const QString &fileName = {}, QObject* parent = nullptr );
+	enum class Format
+	{
+		Png,
+		Jpeg,
+		WebP
+	};
+	Q_ENUM(Format)
+
+	// everything required for annotating, encoding and writing a screenshot without
+	// accessing the ComputerControlInterface, i.e. it can be processed in any thread
+	struct Capture
+	{
+		QImage image;
+		QString userLogin;
+		QString userFullName;
+		QString host;
+		QDate date;
+		QTime time;
+		QString directory;
+		Format format{Format::Png};
+	};
+
+	struct Result
+	{
+		QString fileName;
+		QString errorString;
+	};
+
+	enum class LoadMode
+	{
+		ImageAndMetaData,
+		MetaDataOnly
+	};
+
+	explicit Screenshot( const QString &fileName = {}, QObject* parent = nullptr,
+						 LoadMode loadMode = LoadMode::ImageAndMetaData );
 
 	void take( const ComputerControlInterface::Pointer& computerControlInterface );
 
+	// grabs the current framebuffers of all given computers at the same instant and annotates,
+	// encodes and writes them in the global thread pool - the returned future reports progress
+	static QFuture<Result> takeAll( const ComputerControlInterfaceList& computerControlInterfaces );
+
+	static Capture capture( const ComputerControlInterface::Pointer& computerControlInterface,
+							const QDateTime& timestamp = QDateTime::currentDateTime() );
+	static Result write( const Capture& capture );
+
+	static Format configuredFormat();
+
 	bool isValid() const
 	{
 		return !fileName().isEmpty() && !image().isNull();
@@ -70,7 +116,10 @@ public:
 
 	static QString constructFileName( const QString& user, const QString& hostAddress,
 									  QDate date = QDate::currentDate(),
-									  QTime time = QTime::currentTime() );
+									  QTime time = QTime::currentTime(),
+									  Format format = Format::Png );
+
+	static QStringList fileNameFilters();
 
 	QString user() const;
 	QString host() const;
@@ -80,11 +129,21 @@ public:
 	static QString metaDataKey( MetaData key );
 
 private:
+	static constexpr auto PngQuality = 50;
+	static constexpr auto LossyQuality = 85;
+
+	static Result save( Capture& capture );
+
+	static const char* formatName( Format format );
+	static QString fileNameExtension( Format format );
+	static void annotate( QImage& image, const QString& caption );
+
 	QString property( const QString& key, int section ) const;
 	QString fileNameSection( int n ) const;
 
 	QString m_fileName;
 	QImage m_image;
+	QMap<QString, QString> m_metaData;
 
 } ;
 
@@ -35,6 +35,7 @@ VeyonConfiguration::VeyonConfiguration() :
 	Configuration::Object(Configuration::Store::Backend::Local,
 						  Configuration::Store::Scope::System)
 {
+	connectSnapshotUpdates();
 }
 
 
@@ -42,6 +43,7 @@ VeyonConfiguration::VeyonConfiguration() :
 VeyonConfiguration::VeyonConfiguration( Configuration::Store* store ) :
 	Configuration::Object( store )
 {
+	connectSnapshotUpdates();
 }
 
 
@@ -83,3 +85,50 @@ void VeyonConfiguration::upgrade()
 		setApplicationVersion(VeyonCore::ApplicationVersion::Version_4_9);
 	}
 }
+
+
+
+void VeyonConfiguration::dataReplaced()
+{
+	publishSnapshot( true );
+}
+
+
+
+void VeyonConfiguration::connectSnapshotUpdates()
+{
+	connect( this, &VeyonConfiguration::configurationChanged, this, [this]() {
+		// rebuild the snapshot only once after all values have been loaded
+		if( isReloading() == false )
+		{
+			publishSnapshot( true );
+		}
+	}, Qt::DirectConnection );
+}
+
+
+
+VeyonConfiguration::SnapshotPointer VeyonConfiguration::publishSnapshot( bool replace ) const
+{
+	QMutexLocker locker( &m_snapshotMutex );
+
+	auto currentSnapshot = std::atomic_load( &m_snapshot );
+
+	// do not create snapshots on configuration changes as long as nobody reads them (e.g. in the configurator)
+	if( currentSnapshot && replace == false )
+	{
+		return currentSnapshot;
+	}
+	if( currentSnapshot == nullptr && replace )
+	{
+		return nullptr;
+	}
+
+	auto snapshot = std::make_shared<Snapshot>();
+	FOREACH_VEYON_CONFIG_PROPERTY(INIT_CONFIG_SNAPSHOT_VALUE)
+
+	// readers still holding the previous snapshot keep it alive until they release it
+	std::atomic_store( &m_snapshot, SnapshotPointer( snapshot ) );
+
+	return snapshot;
+}
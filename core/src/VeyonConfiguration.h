@@ -25,6 +25,10 @@
 
 #pragma once
 
+#include <QMutex>
+
+#include <memory>
+
 #include "Configuration/Object.h"
 #include "Configuration/Property.h"
 
@@ -39,12 +43,41 @@ public:
 	VeyonConfiguration();
 	explicit VeyonConfiguration( Configuration::Store* store );
 
+	// immutable copy of all typed configuration values for frequent reads without map lookups and conversions
+	struct Snapshot
+	{
+		FOREACH_VEYON_CONFIG_PROPERTY(DECLARE_CONFIG_SNAPSHOT_VALUE)
+	};
+
 	void upgrade();
 
 	static QString expandPath( QString path );
 
+	using SnapshotPointer = std::shared_ptr<const Snapshot>;
+
+	// returns the current snapshot which stays valid as long as the returned pointer is kept
+	SnapshotPointer snapshot() const
+	{
+		auto currentSnapshot = std::atomic_load( &m_snapshot );
+		if( Q_LIKELY(currentSnapshot) )
+		{
+			return currentSnapshot;
+		}
+
+		return publishSnapshot( false );
+	}
+
 	FOREACH_VEYON_CONFIG_PROPERTY(DECLARE_CONFIG_PROPERTY)
 
+protected:
+	void dataReplaced() override;
+
+private:
+	void connectSnapshotUpdates();
+	SnapshotPointer publishSnapshot( bool replace ) const;
+
+	mutable SnapshotPointer m_snapshot;
+	mutable QMutex m_snapshotMutex;
 
 } ;
 
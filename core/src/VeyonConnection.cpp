@@ -41,7 +41,8 @@ static const uint32_t __veyonSecurityTypes[2] = { rfbSecTypeVeyon, 0 };
 rfbBool handleVeyonMessage( rfbClient* client, rfbServerToClientMsg* msg )
 {
 	auto connection = reinterpret_cast<VeyonConnection *>( VncConnection::clientData( client, VeyonConnection::VeyonConnectionTag ) );
-	if( connection )
+	// leave other messages (e.g. fences) to further protocol extensions
+	if( connection && msg->type == FeatureMessage::RfbMessageType )
 	{
 		return connection->handleServerMessage( client, msg->type ) ? TRUE : FALSE;
 	}
@@ -66,7 +67,7 @@ VeyonConnection::VeyonConnection() :
 		rfbClientRegisterExtension( __veyonProtocolExt );
 	}
 
-	if( VeyonCore::config().authenticationMethod() == VeyonCore::AuthenticationMethod::KeyFileAuthentication )
+	if( VeyonCore::config().snapshot()->authenticationMethod == VeyonCore::AuthenticationMethod::KeyFileAuthentication )
 	{
 		m_veyonAuthType = RfbVeyonAuth::KeyFile;
 	}
@@ -99,11 +100,11 @@ void VeyonConnection::stopAndDeleteLater()
 
 
 
-void VeyonConnection::sendFeatureMessage(const FeatureMessage& featureMessage)
+void VeyonConnection::sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage)
 {
 	if( m_vncConnection )
 	{
-		m_vncConnection->enqueueEvent(new VncFeatureMessageEvent(featureMessage));
+		m_vncConnection->enqueueEvent(new VncFeatureMessageEvent(featureMessage, serializedMessage));
 	}
 }
 
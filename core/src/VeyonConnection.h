@@ -75,7 +75,7 @@ public:
 		m_authenticationProxy = authenticationProxy;
 	}
 
-	void sendFeatureMessage(const FeatureMessage& featureMessage);
+	void sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage = {});
 
 	bool handleServerMessage( rfbClient* client, uint8_t msg );
 
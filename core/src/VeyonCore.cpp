@@ -41,16 +41,19 @@
 
 #include "BuiltinFeatures.h"
 #include "FeatureManager.h"
+#include "FeatureProviderInterface.h"
 #include "Filesystem.h"
 #include "HostAddress.h"
 #include "Logger.h"
 #include "NetworkObjectDirectoryManager.h"
+#include "NetworkObjectDirectoryPluginInterface.h"
 #include "PasswordDialog.h"
 #include "PlatformPluginManager.h"
 #include "PlatformCoreFunctions.h"
 #include "PlatformSessionFunctions.h"
 #include "PluginManager.h"
 #include "TranslationLoader.h"
+#include "UserGroupsBackendInterface.h"
 #include "UserGroupsBackendManager.h"
 #include "VeyonConfiguration.h"
 #include "VncConnection.h"
@@ -715,10 +718,66 @@ void VeyonCore::initAuthenticationCredentials()
 
 
 
+static PluginManager::PluginFilter pluginFilter( VeyonCore::Component component, const PluginManager& pluginManager )
+{
+	const auto arguments = QCoreApplication::arguments();
+
+	// plugins which are required by the core (e.g. UserGroupsBackendManager) in every process
+	const auto isDefaultBackend = []( const PluginManager::PluginMetaData& metaData ) {
+		return metaData.flags.testFlag( Plugin::ProvidesDefaultImplementation ) &&
+				( metaData.implements( UserGroupsBackendInterface_iid ) ||
+				  metaData.implements( NetworkObjectDirectoryPluginInterface_iid ) );
+	};
+
+	switch( component )
+	{
+	case VeyonCore::Component::Worker:
+	{
+		// veyon-worker is launched by FeatureWorkerManager with the UID of the feature to run
+		// while idle workers from the worker pool may get any feature assigned later
+		const auto featureUid = Feature::Uid{arguments.value(1)};
+		if( featureUid.isNull() == false )
+		{
+			return [=]( const PluginManager::PluginMetaData& metaData ) {
+				return metaData.featureUids.contains( featureUid ) || isDefaultBackend( metaData );
+			};
+		}
+		break;
+	}
+	case VeyonCore::Component::CLI:
+	{
+		// load plugins required for plugin-provided command line modules only while
+		// built-in modules (e.g. "feature" or "config") may access all plugins
+		const auto module = arguments.value(1);
+		const auto pluginMetaData = pluginManager.pluginMetaData();
+		const auto isPluginModule = std::any_of( pluginMetaData.constBegin(), pluginMetaData.constEnd(),
+			[&module]( const PluginManager::PluginMetaData& metaData ) {
+				return metaData.commandLineModuleName == module;
+			} );
+		if( module.isEmpty() == false && isPluginModule )
+		{
+			return [=]( const PluginManager::PluginMetaData& metaData ) {
+				return metaData.commandLineModuleName == module ||
+						metaData.implements( FeatureProviderInterface_iid ) ||
+						metaData.implements( NetworkObjectDirectoryPluginInterface_iid ) ||
+						metaData.implements( UserGroupsBackendInterface_iid );
+			};
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return {};
+}
+
+
+
 void VeyonCore::initPlugins()
 {
-	// load all other (non-platform) plugins
-	m_pluginManager->loadPlugins();
+	// load all other (non-platform) plugins required by this component
+	m_pluginManager->loadPlugins( pluginFilter( component(), *m_pluginManager ) );
 	m_pluginManager->upgradePlugins();
 }
 
@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QProcessEnvironment>
+
+#include "PlatformPluginInterface.h"
+#include "PlatformUserFunctions.h"
 #include "VeyonCore.h"
 
 class FeatureMessage;
@@ -50,4 +54,26 @@ public:
 
 	virtual void setMinimumFramebufferUpdateInterval(const MessageContext& context, int interval) = 0;
 
+	// the following functions describe the session served which differs from the session
+	// of the process if a single server process serves multiple sessions
+	virtual int sessionId() const
+	{
+		return VeyonCore::sessionId();
+	}
+
+	virtual QProcessEnvironment sessionEnvironment() const
+	{
+		return QProcessEnvironment::systemEnvironment();
+	}
+
+	virtual QString sessionUser() const
+	{
+		return VeyonCore::platform().userFunctions().currentUser();
+	}
+
+	virtual bool servesProcessSession() const
+	{
+		return true;
+	}
+
 };
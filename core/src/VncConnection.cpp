@@ -31,16 +31,34 @@
 #include <QHostAddress>
 #include <QMutexLocker>
 #include <QPixmap>
+#include <QRandomGenerator>
 #include <QRegularExpression>
 #include <QTime>
 
 #include "PlatformNetworkFunctions.h"
+#include "RfbFlowControl.h"
 #include "VeyonConfiguration.h"
 #include "VncConnection.h"
 #include "SocketDevice.h"
 #include "VncEvents.h"
 
 
+static rfbClientProtocolExtension* __flowControlProtocolExt = nullptr;
+
+
+rfbBool handleFlowControlMessage( rfbClient* client, rfbServerToClientMsg* msg )
+{
+	auto connection = static_cast<VncConnection *>( VncConnection::clientData( client, VncConnection::VncConnectionTag ) );
+	if( connection )
+	{
+		return connection->handleFlowControlMessage( client, msg->type ) ? TRUE : FALSE;
+	}
+
+	return FALSE;
+}
+
+
+
 rfbBool VncConnection::hookInitFrameBuffer( rfbClient* client )
 {
 	auto connection = static_cast<VncConnection *>( clientData( client, VncConnectionTag ) );
@@ -183,6 +201,7 @@ VncConnection::VncConnection( QObject* parent ) :
 		m_connectTimeout = VeyonCore::config().vncConnectionConnectTimeout();
 		m_readTimeout = VeyonCore::config().vncConnectionReadTimeout();
 		m_connectionRetryInterval = VeyonCore::config().vncConnectionRetryInterval();
+		m_maximumConnectionRetryInterval = VeyonCore::config().vncConnectionMaximumRetryInterval();
 		m_messageWaitTimeout = VeyonCore::config().vncConnectionMessageWaitTimeout();
 		m_fastFramebufferUpdateInterval = VeyonCore::config().vncConnectionFastFramebufferUpdateInterval();
 		m_initialFramebufferUpdateTimeout = VeyonCore::config().vncConnectionInitialFramebufferUpdateTimeout();
@@ -190,6 +209,21 @@ VncConnection::VncConnection( QObject* parent ) :
 		m_socketKeepaliveIdleTime = VeyonCore::config().vncConnectionSocketKeepaliveIdleTime();
 		m_socketKeepaliveInterval = VeyonCore::config().vncConnectionSocketKeepaliveInterval();
 		m_socketKeepaliveCount = VeyonCore::config().vncConnectionSocketKeepaliveCount();
+
+		VncConnectionScheduler::instance().setMaximumConcurrentConnects( VeyonCore::config().vncConnectionMaximumConcurrentConnects() );
+	}
+
+	if( __flowControlProtocolExt == nullptr )
+	{
+		__flowControlProtocolExt = new rfbClientProtocolExtension;
+		// pseudo-encodings are announced per connection once the server is known to support them
+		__flowControlProtocolExt->encodings = nullptr;
+		__flowControlProtocolExt->handleEncoding = nullptr;
+		__flowControlProtocolExt->handleMessage = ::handleFlowControlMessage;
+		__flowControlProtocolExt->securityTypes = nullptr;
+		__flowControlProtocolExt->handleAuthentication = nullptr;
+
+		rfbClientRegisterExtension( __flowControlProtocolExt );
 	}
 }
 
@@ -209,6 +243,9 @@ VncConnection::~VncConnection()
 
 		terminate();
 		wait();
+
+		// the thread might have been terminated while waiting for or holding a handshake slot
+		VncConnectionScheduler::instance().remove( this );
 	}
 }
 
@@ -262,6 +299,7 @@ void VncConnection::stop()
 	setControlFlag( ControlFlag::TerminateThread, true );
 
 	m_updateIntervalSleeper.wakeAll();
+	VncConnectionScheduler::instance().cancel( this );
 }
 
 
@@ -347,6 +385,14 @@ void VncConnection::setQuality(VncConnectionConfiguration::Quality quality)
 
 
 
+void VncConnection::announceFlowControlSupport()
+{
+	// only processed while connected and fired with the client of the connection thread
+	enqueueEvent(new VncAnnounceFlowControlEvent);
+}
+
+
+
 void VncConnection::setUseRemoteCursor( bool enabled )
 {
 	m_useRemoteCursor = enabled;
@@ -406,6 +452,15 @@ void VncConnection::setFramebufferUpdateInterval( int interval )
 
 
 
+void VncConnection::setConnectionPriority( VncConnectionScheduler::Priority priority )
+{
+	m_connectionPriority = priority;
+
+	VncConnectionScheduler::instance().updatePriority( this );
+}
+
+
+
 void VncConnection::rescaleFramebuffer()
 {
 	if( hasValidFramebuffer() == false || m_scaledSize.isNull() )
@@ -494,6 +549,17 @@ void VncConnection::establishConnection()
 	while( isControlFlagSet( ControlFlag::TerminateThread ) == false &&
 		   state() != State::Connected ) // try to connect as long as the server allows
 	{
+		// wait for a free handshake slot so that selecting many computers at once
+		// does not result in a burst of simultaneous connects
+		if( VncConnectionScheduler::instance().acquire( this, [this]() {
+				return isControlFlagSet( ControlFlag::TerminateThread ); } ) == false )
+		{
+			return;
+		}
+
+		m_continuousUpdatesSupported = false;
+		m_continuousUpdatesEnabled = false;
+
 		m_globalMutex.lock();
 		m_client = rfbGetClient( RfbBitsPerSample, RfbSamplesPerPixel, RfbBytesPerPixel );
 		m_client->MallocFrameBuffer = hookInitFrameBuffer;
@@ -536,6 +602,8 @@ void VncConnection::establishConnection()
 			m_client = nullptr;
 		}
 
+		VncConnectionScheduler::instance().release( this );
+
 		// do not continue/sleep when already requested to stop
 		if( isControlFlagSet( ControlFlag::TerminateThread ) )
 		{
@@ -551,6 +619,8 @@ void VncConnection::establishConnection()
 					configureSocketKeepalive( static_cast<PlatformNetworkFunctions::Socket>( m_client->sock ), true,
 											  m_socketKeepaliveIdleTime, m_socketKeepaliveInterval, m_socketKeepaliveCount );
 
+			m_connectionFailureCount = 0;
+
 			setState( State::Connected );
 		}
 		else
@@ -591,15 +661,7 @@ void VncConnection::establishConnection()
 
 			// wait a bit until next connect
 			sleeperMutex.lock();
-			if( m_framebufferUpdateInterval > 0 )
-			{
-				m_updateIntervalSleeper.wait( &sleeperMutex, m_framebufferUpdateInterval );
-			}
-			else
-			{
-				// default: retry every second
-				m_updateIntervalSleeper.wait( &sleeperMutex, m_connectionRetryInterval );
-			}
+			m_updateIntervalSleeper.wait( &sleeperMutex, connectionRetryInterval() );
 			sleeperMutex.unlock();
 		}
 	}
@@ -659,6 +721,8 @@ void VncConnection::handleConnection()
 			requestFrameufferUpdate(FramebufferUpdateType::Incremental);
 		}
 
+		updateContinuousUpdates();
+
 		const auto remainingUpdateInterval = m_framebufferUpdateInterval - loopTimer.elapsed();
 
 		// compat with Veyon Server < 4.7
@@ -772,7 +836,11 @@ void VncConnection::requestFrameufferUpdate(FramebufferUpdateType updateType)
 		switch (updateType)
 		{
 		case FramebufferUpdateType::Incremental:
-			SendIncrementalFramebufferUpdateRequest(m_client);
+			// server pushes updates on its own when continuous updates are enabled
+			if (m_continuousUpdatesEnabled == false)
+			{
+				SendIncrementalFramebufferUpdateRequest(m_client);
+			}
 			break;
 		case FramebufferUpdateType::Full:
 			SendFramebufferUpdateRequest(m_client, 0, 0, m_client->width, m_client->height, false);
@@ -796,6 +864,34 @@ void VncConnection::finishFrameBufferUpdate()
 
 
 
+int VncConnection::connectionRetryInterval()
+{
+	const auto retryInterval = m_framebufferUpdateInterval > 0 ? int(m_framebufferUpdateInterval) :
+																 m_connectionRetryInterval;
+
+	switch( state() )
+	{
+	case State::HostOffline:
+	case State::HostNameResolutionFailed:
+	case State::ServerNotRunning:
+		break;
+	default:
+		return retryInterval;
+	}
+
+	// back off exponentially for hosts which are not available and add some jitter
+	// so that retries for many offline hosts do not recur in lockstep
+	static constexpr auto MaximumBackoffExponent = 16;
+	const auto backoffInterval = int( std::min<qint64>( qint64(retryInterval) << std::min( m_connectionFailureCount, MaximumBackoffExponent ),
+														std::max( retryInterval, m_maximumConnectionRetryInterval ) ) );
+
+	++m_connectionFailureCount;
+
+	return backoffInterval / 2 + QRandomGenerator::global()->bounded( backoffInterval / 2 + 1 );
+}
+
+
+
 int VncConnection::fullFramebufferUpdateTimeout() const
 {
 	return m_framebufferState == FramebufferState::Valid ?
@@ -841,6 +937,99 @@ void VncConnection::updateEncodingSettingsFromQuality()
 
 
 
+bool VncConnection::handleFlowControlMessage(rfbClient* client, uint8_t messageType)
+{
+	switch (messageType)
+	{
+	case RfbFlowControl::ContinuousUpdatesMessageType:
+		// EndOfContinuousUpdates is sent in response to SetEncodings to announce support for continuous
+		// updates as well as after continuous updates have been disabled
+		m_continuousUpdatesSupported = true;
+		if (m_continuousUpdatesEnabled)
+		{
+			m_continuousUpdatesEnabled = false;
+			setControlFlag(ControlFlag::TriggerFramebufferUpdate, true);
+		}
+		return true;
+	case RfbFlowControl::FenceMessageType:
+		return receiveFence(client);
+	default:
+		break;
+	}
+
+	return false;
+}
+
+
+
+bool VncConnection::receiveFence(rfbClient* client)
+{
+	// message type has been read already
+	QByteArray header(RfbFlowControl::FenceMessageHeaderSize, 0);
+	if (ReadFromRFBServer(client, header.data() + 1, uint(header.size() - 1)) == false)
+	{
+		return false;
+	}
+
+	const auto payloadSize = RfbFlowControl::fencePayloadSize(header);
+	if (payloadSize > RfbFlowControl::MaximumFencePayloadSize)
+	{
+		vCritical() << "received fence with invalid payload size" << payloadSize;
+		return false;
+	}
+
+	QByteArray payload(payloadSize, 0);
+	if (payloadSize > 0 && ReadFromRFBServer(client, payload.data(), uint(payloadSize)) == false)
+	{
+		return false;
+	}
+
+	const auto flags = RfbFlowControl::fenceFlags(header);
+	if (flags & RfbFlowControl::FenceRequest)
+	{
+		// messages are processed synchronously so all messages preceding the fence have
+		// been processed already and the fence can be answered immediately
+		const auto response = RfbFlowControl::fenceResponseMessage(flags, payload);
+		return WriteToRFBServer(client, response.constData(), uint(response.size()));
+	}
+
+	return true;
+}
+
+
+
+void VncConnection::updateContinuousUpdates()
+{
+	// let the server push updates when they are wanted as fast as possible so no round trip
+	// per update is required - the server throttles updates according to the bandwidth then
+	const auto enable = m_continuousUpdatesSupported &&
+						m_framebufferUpdateInterval <= 0 &&
+						m_framebufferState != FramebufferState::Invalid &&
+						isControlFlagSet(ControlFlag::SkipFramebufferUpdates) == false;
+	const QRect rect{0, 0, m_client->width, m_client->height};
+
+	if (enable == m_continuousUpdatesEnabled &&
+		(enable == false || rect == m_continuousUpdatesRect))
+	{
+		return;
+	}
+
+	const auto message = RfbFlowControl::enableContinuousUpdatesMessage(enable, rect);
+	if (WriteToRFBServer(m_client, message.constData(), uint(message.size())))
+	{
+		m_continuousUpdatesEnabled = enable;
+		m_continuousUpdatesRect = rect;
+
+		if (enable == false)
+		{
+			// request updates on our own again
+			requestFrameufferUpdate(FramebufferUpdateType::Incremental);
+		}
+	}
+}
+
+
+
 void VncConnection::sendEvents()
 {
 	m_eventQueueMutex.lock();
@@ -879,6 +1068,7 @@ void VncConnection::enqueueEvent(VncEvent* event)
 {
 	if( state() != State::Connected )
 	{
+		delete event;
 		return;
 	}
 
@@ -901,7 +1091,24 @@ bool VncConnection::isEventQueueEmpty()
 
 void VncConnection::mouseEvent( int x, int y, int buttonMask )
 {
-	enqueueEvent(new VncPointerEvent(x, y, buttonMask));
+	const auto isMove = buttonMask == m_pointerButtonMask;
+	m_pointerButtonMask = buttonMask;
+
+	if( isMove )
+	{
+		QMutexLocker lock( &m_eventQueueMutex );
+
+		// only send the latest position of subsequent pointer moves which have not been sent
+		// yet - events changing the button state are never merged so clicks keep their positions
+		auto lastPointerEvent = m_eventQueue.isEmpty() ? nullptr : dynamic_cast<VncPointerEvent *>( m_eventQueue.last() );
+		if( lastPointerEvent && lastPointerEvent->isMove() )
+		{
+			lastPointerEvent->setPosition( x, y );
+			return;
+		}
+	}
+
+	enqueueEvent(new VncPointerEvent(x, y, buttonMask, isMove));
 }
 
 
@@ -39,6 +39,7 @@
 #include "SocketDevice.h"
 #include "VeyonCore.h"
 #include "VncConnectionConfiguration.h"
+#include "VncConnectionScheduler.h"
 
 using rfbClient = struct _rfbClient;
 
@@ -108,6 +109,9 @@ public:
 
 	void setUseRemoteCursor( bool enabled );
 
+	// announces support for continuous updates and fences to servers known to handle them
+	void announceFlowControlSupport();
+
 	void setServerReachable();
 
 	void enqueueEvent(VncEvent* event);
@@ -140,6 +144,13 @@ public:
 		setControlFlag(ControlFlag::RequiresManualUpdateRateControl, on);
 	}
 
+	VncConnectionScheduler::Priority connectionPriority() const
+	{
+		return m_connectionPriority;
+	}
+
+	void setConnectionPriority( VncConnectionScheduler::Priority priority );
+
 	void rescaleFramebuffer();
 
 	static constexpr int VncConnectionTag = 0x590123;
@@ -150,6 +161,9 @@ public:
 	static qint64 libvncClientDispatcher( char * buffer, const qint64 bytes,
 										  SocketDevice::SocketOperation operation, void * user );
 
+	// called by protocol extension in connection thread for messages unknown to LibVNCClient
+	bool handleFlowControlMessage(rfbClient* client, uint8_t messageType);
+
 	void mouseEvent( int x, int y, int buttonMask );
 	void keyEvent( unsigned int key, bool pressed );
 	void clientCut( const QString& text );
@@ -201,11 +215,15 @@ private:
 	void requestFrameufferUpdate(FramebufferUpdateType updateType);
 	void finishFrameBufferUpdate();
 
+	int connectionRetryInterval();
 	int fullFramebufferUpdateTimeout() const;
 	int incrementalFramebufferUpdateTimeout() const;
 
 	void updateEncodingSettingsFromQuality();
 
+	bool receiveFence(rfbClient* client);
+	void updateContinuousUpdates();
+
 	void sendEvents();
 
 	void deleteLaterInMainThread();
@@ -226,6 +244,7 @@ private:
 	int m_connectTimeout{VncConnectionConfiguration::DefaultConnectTimeout};
 	int m_readTimeout{VncConnectionConfiguration::DefaultReadTimeout};
 	int m_connectionRetryInterval{VncConnectionConfiguration::DefaultConnectionRetryInterval};
+	int m_maximumConnectionRetryInterval{VncConnectionConfiguration::DefaultMaximumConnectionRetryInterval};
 	int m_messageWaitTimeout{VncConnectionConfiguration::DefaultMessageWaitTimeout};
 	int m_fastFramebufferUpdateInterval{VncConnectionConfiguration::DefaultFastFramebufferUpdateInterval};
 	int m_initialFramebufferUpdateTimeout{VncConnectionConfiguration::DefaultInitialFramebufferUpdateTimeout};
@@ -238,6 +257,8 @@ private:
 	std::atomic<State> m_state;
 	std::atomic<FramebufferState> m_framebufferState;
 	QAtomicInt m_controlFlags;
+	std::atomic<VncConnectionScheduler::Priority> m_connectionPriority{VncConnectionScheduler::Priority::Normal};
+	int m_connectionFailureCount{0};
 
 	// connection parameters and data
 	rfbClient* m_client;
@@ -255,8 +276,14 @@ private:
 	QElapsedTimer m_fullFramebufferUpdateTimer{};
 	QElapsedTimer m_incrementalFramebufferUpdateTimer{};
 
+	// continuous updates (only accessed by connection thread)
+	bool m_continuousUpdatesSupported{false};
+	bool m_continuousUpdatesEnabled{false};
+	QRect m_continuousUpdatesRect{};
+
 	// queue for RFB and custom events
 	QQueue<VncEvent *> m_eventQueue;
+	int m_pointerButtonMask{0};
 
 	// framebuffer data and thread synchronization objects
 	QImage m_image{};
@@ -45,6 +45,8 @@ public:
 	static constexpr int DefaultConnectTimeout = 10000;
 	static constexpr int DefaultReadTimeout = 30000;
 	static constexpr int DefaultConnectionRetryInterval = 1000;
+	static constexpr int DefaultMaximumConnectionRetryInterval = 30000;
+	static constexpr int DefaultMaximumConcurrentConnects = 32;
 	static constexpr int DefaultMessageWaitTimeout = 500;
 	static constexpr int DefaultFastFramebufferUpdateInterval = 100;
 	static constexpr int DefaultInitialFramebufferUpdateTimeout = 10000;
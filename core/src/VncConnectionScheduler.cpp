@@ -0,0 +1,173 @@
+/*
+ * VncConnectionScheduler.cpp - implementation of VncConnectionScheduler class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "VncConnection.h"
+#include "VncConnectionScheduler.h"
+
+
+VncConnectionScheduler& VncConnectionScheduler::instance()
+{
+	static VncConnectionScheduler scheduler;
+	return scheduler;
+}
+
+
+
+void VncConnectionScheduler::setMaximumConcurrentConnects( int count )
+{
+	QMutexLocker locker( &m_mutex );
+	m_maximumConcurrentConnects = qMax( 1, count );
+	wakeNextWaiter();
+}
+
+
+
+bool VncConnectionScheduler::acquire( const VncConnection* connection, const std::function<bool()>& isCancelled )
+{
+	QMutexLocker locker( &m_mutex );
+
+	// allocated on the heap so it stays valid if the thread is terminated while waiting
+	const auto waiter = new Waiter;
+	waiter->key = waiterKey( connection, m_nextSequenceNumber++ );
+	m_waitQueue[waiter->key] = waiter;
+	m_waiters[connection] = waiter;
+
+	while( m_activeConnectCount >= m_maximumConcurrentConnects || m_waitQueue.first() != waiter )
+	{
+		if( isCancelled() )
+		{
+			removeWaiter( connection );
+			// we might have been the next waiter
+			wakeNextWaiter();
+			return false;
+		}
+
+		waiter->condition.wait( &m_mutex );
+	}
+
+	removeWaiter( connection );
+	m_slotHolders.insert( connection );
+	++m_activeConnectCount;
+
+	// further slots might be available
+	wakeNextWaiter();
+
+	return true;
+}
+
+
+
+void VncConnectionScheduler::release( const VncConnection* connection )
+{
+	QMutexLocker locker( &m_mutex );
+
+	if( m_slotHolders.remove( connection ) )
+	{
+		--m_activeConnectCount;
+		wakeNextWaiter();
+	}
+}
+
+
+
+void VncConnectionScheduler::updatePriority( const VncConnection* connection )
+{
+	QMutexLocker locker( &m_mutex );
+
+	const auto waiter = m_waiters.value( connection );
+	if( waiter == nullptr )
+	{
+		return;
+	}
+
+	const auto key = waiterKey( connection, waiter->key.second );
+	if( key != waiter->key )
+	{
+		m_waitQueue.remove( waiter->key );
+		waiter->key = key;
+		m_waitQueue[waiter->key] = waiter;
+		wakeNextWaiter();
+	}
+}
+
+
+
+void VncConnectionScheduler::cancel( const VncConnection* connection )
+{
+	QMutexLocker locker( &m_mutex );
+
+	const auto waiter = m_waiters.value( connection );
+	if( waiter )
+	{
+		waiter->condition.wakeOne();
+	}
+}
+
+
+
+void VncConnectionScheduler::remove( const VncConnection* connection )
+{
+	QMutexLocker locker( &m_mutex );
+
+	if( m_waiters.contains( connection ) )
+	{
+		removeWaiter( connection );
+		wakeNextWaiter();
+	}
+
+	if( m_slotHolders.remove( connection ) )
+	{
+		--m_activeConnectCount;
+		wakeNextWaiter();
+	}
+}
+
+
+
+VncConnectionScheduler::WaiterKey VncConnectionScheduler::waiterKey( const VncConnection* connection, quint64 sequenceNumber )
+{
+	return { -int( connection->connectionPriority() ), sequenceNumber };
+}
+
+
+
+void VncConnectionScheduler::removeWaiter( const VncConnection* connection )
+{
+	const auto waiter = m_waiters.take( connection );
+	if( waiter )
+	{
+		m_waitQueue.remove( waiter->key );
+		delete waiter;
+	}
+}
+
+
+
+void VncConnectionScheduler::wakeNextWaiter()
+{
+	if( m_activeConnectCount < m_maximumConcurrentConnects && m_waitQueue.isEmpty() == false )
+	{
+		m_waitQueue.first()->condition.wakeOne();
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * VncConnectionScheduler.h - declaration of VncConnectionScheduler class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <QWaitCondition>
+
+#include "VncConnectionConfiguration.h"
+
+class VncConnection;
+
+// limits the number of concurrently running connection handshakes in a process
+// and hands out free slots to waiting connections in order of their priority
+class VEYON_CORE_EXPORT VncConnectionScheduler
+{
+public:
+	enum class Priority
+	{
+		Normal,
+		Visible,
+		Selected
+	};
+
+	static VncConnectionScheduler& instance();
+
+	void setMaximumConcurrentConnects( int count );
+
+	bool acquire( const VncConnection* connection, const std::function<bool()>& isCancelled );
+	void release( const VncConnection* connection );
+
+	void updatePriority( const VncConnection* connection );
+
+	// wakes up the connection if it is waiting for a slot so it can check for being cancelled
+	void cancel( const VncConnection* connection );
+
+	// drops a waiting connection or releases the slot of a connection whose thread
+	// has been terminated while waiting or connecting
+	void remove( const VncConnection* connection );
+
+private:
+	// waiters are ordered by descending priority and ascending sequence number
+	using WaiterKey = std::pair<int, quint64>;
+
+	struct Waiter
+	{
+		WaiterKey key;
+		QWaitCondition condition;
+	};
+
+	VncConnectionScheduler() = default;
+
+	static WaiterKey waiterKey( const VncConnection* connection, quint64 sequenceNumber );
+
+	void removeWaiter( const VncConnection* connection );
+	void wakeNextWaiter();
+
+	QMutex m_mutex;
+	int m_maximumConcurrentConnects{VncConnectionConfiguration::DefaultMaximumConcurrentConnects};
+	int m_activeConnectCount{0};
+	quint64 m_nextSequenceNumber{0};
+	QMap<WaiterKey, Waiter *> m_waitQueue;
+	QHash<const VncConnection *, Waiter *> m_waiters;
+	QSet<const VncConnection *> m_slotHolders;
+
+} ;
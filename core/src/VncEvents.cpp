@@ -24,6 +24,7 @@
 
 #include <rfb/rfbclient.h>
 
+#include "RfbFlowControl.h"
 #include "VncEvents.h"
 
 
@@ -41,10 +42,11 @@ void VncKeyEvent::fire( rfbClient* client )
 
 
 
-VncPointerEvent::VncPointerEvent(int x, int y, int buttonMask) :
+VncPointerEvent::VncPointerEvent(int x, int y, int buttonMask, bool isMove) :
 	m_x( x ),
 	m_y( y ),
-	m_buttonMask( buttonMask )
+	m_buttonMask( buttonMask ),
+	m_isMove( isMove )
 {
 }
 
@@ -75,3 +77,16 @@ void VncUpdateFormatAndEncodingsEvent::fire( rfbClient* client )
 {
 	SetFormatAndEncodings(client);
 }
+
+
+
+void VncAnnounceFlowControlEvent::fire( rfbClient* client )
+{
+	if( client == nullptr )
+	{
+		return;
+	}
+
+	const auto message = RfbFlowControl::announcementMessage();
+	WriteToRFBServer( client, message.constData(), uint(message.size()) );
+}
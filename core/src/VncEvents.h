@@ -55,14 +55,27 @@ private:
 class VncPointerEvent : public VncEvent
 {
 public:
-	VncPointerEvent( int x, int y, int buttonMask );
+	VncPointerEvent( int x, int y, int buttonMask, bool isMove = false );
 
 	void fire( rfbClient* client ) override;
 
+	// returns whether the event only changes the pointer position but not the button state
+	bool isMove() const
+	{
+		return m_isMove;
+	}
+
+	void setPosition( int x, int y )
+	{
+		m_x = x;
+		m_y = y;
+	}
+
 private:
 	int m_x;
 	int m_y;
 	int m_buttonMask;
+	bool m_isMove;
 } ;
 
 
@@ -82,3 +95,9 @@ class VncUpdateFormatAndEncodingsEvent : public VncEvent
 public:
 	void fire( rfbClient* client ) override;
 };
+
+class VncAnnounceFlowControlEvent : public VncEvent
+{
+public:
+	void fire( rfbClient* client ) override;
+};
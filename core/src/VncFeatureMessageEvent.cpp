@@ -29,8 +29,9 @@
 #include "VncFeatureMessageEvent.h"
 
 
-VncFeatureMessageEvent::VncFeatureMessageEvent( const FeatureMessage& featureMessage ) :
-	m_featureMessage( featureMessage )
+VncFeatureMessageEvent::VncFeatureMessageEvent( const FeatureMessage& featureMessage, const QByteArray& serializedMessage ) :
+	m_featureMessage( featureMessage ),
+	m_serializedMessage( serializedMessage )
 {
 }
 
@@ -43,5 +44,13 @@ void VncFeatureMessageEvent::fire( rfbClient* client )
 
 	SocketDevice socketDevice( VncConnection::libvncClientDispatcher, client );
 
-	m_featureMessage.sendAsRfbMessage(&socketDevice);
+	if( m_serializedMessage.isEmpty() )
+	{
+		m_featureMessage.sendAsRfbMessage(&socketDevice);
+	}
+	else
+	{
+		// message has been encoded once for all connections
+		socketDevice.write( m_serializedMessage.constData(), m_serializedMessage.size() );
+	}
 }
@@ -32,11 +32,12 @@
 class VncFeatureMessageEvent : public VncEvent
 {
 public:
-	explicit VncFeatureMessageEvent( const FeatureMessage& featureMessage );
+	explicit VncFeatureMessageEvent( const FeatureMessage& featureMessage, const QByteArray& serializedMessage = {} );
 
 	void fire( rfbClient* client ) override;
 
 private:
 	FeatureMessage m_featureMessage;
+	QByteArray m_serializedMessage;
 
 } ;
@@ -56,6 +56,16 @@ public:
 
 	virtual Password configuredPassword() = 0;
 
+	/*!
+	 * \brief Returns whether runServer() may be called concurrently for multiple sessions within one process -
+	 * runServer() then also has to return once interruption of the calling thread has been requested
+	 * or the event loop of the thread has been quit
+	 */
+	virtual bool supportsMultipleInstances() const
+	{
+		return false;
+	}
+
 } ;
 
 using VncServerPluginInterfaceList = QList<VncServerPluginInterface *>;
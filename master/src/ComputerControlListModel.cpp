@@ -183,6 +183,7 @@ void ComputerControlListModel::reload()
 
 	m_computerControlInterfaces.clear();
 	m_computerControlInterfaces.reserve( computerList.size() );
+	m_pendingFirstFramebuffers.clear();
 
 	for( const auto& computer : computerList )
 	{
@@ -342,13 +343,23 @@ void ComputerControlListModel::updateSessionInfo(const QModelIndex& index)
 
 void ComputerControlListModel::startComputerControlInterface( ComputerControlInterface* controlInterface )
 {
+	if( m_pendingFirstFramebuffers.isEmpty() )
+	{
+		m_firstFramebufferTimer.restart();
+		m_firstFramebufferCount = 0;
+	}
+	m_pendingFirstFramebuffers.insert( controlInterface );
+
 	controlInterface->start( computerScreenSize(), ComputerControlInterface::UpdateMode::Monitoring );
 
 	connect( controlInterface, &ComputerControlInterface::framebufferSizeChanged,
 			 this, &ComputerControlListModel::updateComputerScreenSize );
 
 	connect( controlInterface, &ComputerControlInterface::framebufferUpdated,
-			 this, [=] () { updateScreen( interfaceIndex( controlInterface ) ); } );
+			 this, [=] () {
+				 updateFirstFramebufferStatistics( controlInterface );
+				 updateScreen( interfaceIndex( controlInterface ) );
+			 } );
 
 	connect( controlInterface, &ComputerControlInterface::activeFeaturesChanged,
 			 this, [=] () { updateActiveFeatures( interfaceIndex( controlInterface ) ); } );
@@ -372,6 +383,8 @@ void ComputerControlListModel::stopComputerControlInterface( const ComputerContr
 {
 	m_master->stopAllFeatures( { controlInterface } );
 
+	m_pendingFirstFramebuffers.remove( controlInterface.data() );
+
 	controlInterface->disconnect(this);
 	controlInterface->disconnect( &m_master->computerManager() );
 
@@ -380,6 +393,29 @@ void ComputerControlListModel::stopComputerControlInterface( const ComputerContr
 
 
 
+void ComputerControlListModel::updateFirstFramebufferStatistics( ComputerControlInterface* controlInterface )
+{
+	if( m_pendingFirstFramebuffers.remove( controlInterface ) == false )
+	{
+		return;
+	}
+
+	++m_firstFramebufferCount;
+
+	if( m_firstFramebufferCount == 1 )
+	{
+		vDebug() << "first computer thumbnail received after" << m_firstFramebufferTimer.elapsed() << "ms";
+	}
+
+	if( m_pendingFirstFramebuffers.isEmpty() )
+	{
+		vDebug() << "thumbnails of all" << m_firstFramebufferCount << "computers received after"
+				 << m_firstFramebufferTimer.elapsed() << "ms";
+	}
+}
+
+
+
 double ComputerControlListModel::averageAspectRatio() const
 {
 	QSize size{ 16, 9 };
@@ -25,7 +25,9 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QSet>
 
 #include "ComputerListModel.h"
 #include "ComputerControlInterface.h"
@@ -79,6 +81,8 @@ private:
 	void startComputerControlInterface( ComputerControlInterface* controlInterface );
 	void stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface );
 
+	void updateFirstFramebufferStatistics( ComputerControlInterface* controlInterface );
+
 	double averageAspectRatio() const;
 
 	QImage scaleAndAlignIcon( const QImage& icon, QSize size ) const;
@@ -102,4 +106,8 @@ private:
 
 	ComputerControlInterfaceList m_computerControlInterfaces{};
 
+	QElapsedTimer m_firstFramebufferTimer;
+	QSet<ComputerControlInterface *> m_pendingFirstFramebuffers;
+	int m_firstFramebufferCount{0};
+
 };
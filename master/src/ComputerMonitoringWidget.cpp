@@ -67,6 +67,19 @@ ComputerMonitoringWidget::ComputerMonitoringWidget( QWidget *parent ) :
 	initializeView( this );
 
 	setModel( dataModel() );
+
+	// connect to visible and selected computers first
+	m_connectionPriorityUpdateTimer.setSingleShot( true );
+	m_connectionPriorityUpdateTimer.setInterval( ConnectionPriorityUpdateDelay );
+	connect( &m_connectionPriorityUpdateTimer, &QTimer::timeout, this, &ComputerMonitoringWidget::updateConnectionPriorities );
+
+	const auto startConnectionPriorityUpdateTimer = [this]() { m_connectionPriorityUpdateTimer.start(); };
+	connect( verticalScrollBar(), &QScrollBar::valueChanged, this, startConnectionPriorityUpdateTimer );
+	connect( horizontalScrollBar(), &QScrollBar::valueChanged, this, startConnectionPriorityUpdateTimer );
+	connect( model(), &QAbstractItemModel::rowsInserted, this, startConnectionPriorityUpdateTimer );
+	connect( model(), &QAbstractItemModel::modelReset, this, startConnectionPriorityUpdateTimer );
+	connect( model(), &QAbstractItemModel::layoutChanged, this, startConnectionPriorityUpdateTimer );
+	connect( selectionModel(), &QItemSelectionModel::selectionChanged, this, startConnectionPriorityUpdateTimer );
 }
 
 
@@ -282,6 +295,37 @@ void ComputerMonitoringWidget::addSubFeaturesToMenu( const Feature& parentFeatur
 
 
 
+void ComputerMonitoringWidget::updateConnectionPriorities()
+{
+	const auto viewportRect = viewport()->rect();
+
+	for( int row = 0, rowCount = model()->rowCount(); row < rowCount; ++row )
+	{
+		const auto index = model()->index( row, 0 );
+		const auto computerControlInterface = model()->data( index, ComputerControlListModel::ControlInterfaceRole )
+												  .value<ComputerControlInterface::Pointer>();
+		if( computerControlInterface.isNull() )
+		{
+			continue;
+		}
+
+		if( selectionModel()->isSelected( index ) )
+		{
+			computerControlInterface->setConnectionPriority( ComputerControlInterface::ConnectionPriority::Selected );
+		}
+		else if( isRowHidden( row ) == false && visualRect( index ).intersects( viewportRect ) )
+		{
+			computerControlInterface->setConnectionPriority( ComputerControlInterface::ConnectionPriority::Visible );
+		}
+		else
+		{
+			computerControlInterface->setConnectionPriority( ComputerControlInterface::ConnectionPriority::Normal );
+		}
+	}
+}
+
+
+
 void ComputerMonitoringWidget::runDoubleClickFeature( const QModelIndex& index )
 {
 	const Feature& feature = VeyonCore::featureManager().feature( VeyonCore::config().computerDoubleClickFeature() );
@@ -386,6 +430,8 @@ void ComputerMonitoringWidget::resizeEvent( QResizeEvent* event )
 {
 	FlexibleListView::resizeEvent( event );
 
+	m_connectionPriorityUpdateTimer.start();
+
 	if( m_ignoreResizeEvent == false )
 	{
 		initiateIconSizeAutoAdjust();
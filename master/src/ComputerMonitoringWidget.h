@@ -69,6 +69,8 @@ private:
 	void addFeatureToMenu( const Feature& feature, const QString& label );
 	void addSubFeaturesToMenu( const Feature& parentFeature, const FeatureList& subFeatures, const QString& label );
 
+	void updateConnectionPriorities();
+
 	void runDoubleClickFeature( const QModelIndex& index );
 	void runMousePressAndHoldFeature( );
 	void stopMousePressAndHoldFeature( );
@@ -88,6 +90,9 @@ private:
 	int m_ignoreNumberOfMouseEvents = 0;
 
 	static constexpr auto IgnoredNumberOfMouseEventsWhileHold = 3;
+	static constexpr auto ConnectionPriorityUpdateDelay = 100;
+
+	QTimer m_connectionPriorityUpdateTimer{this};
 
 	ComputerZoomWidget* m_computerZoomWidget{nullptr};
 
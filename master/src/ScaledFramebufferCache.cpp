@@ -0,0 +1,189 @@
+/*
+ * ScaledFramebufferCache.cpp - implementation of ScaledFramebufferCache
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include "ComputerControlInterface.h"
+#include "ComputerListModel.h"
+#include "ScaledFramebufferCache.h"
+
+
+ScaledFramebufferCache::ScaledFramebufferCache( QAbstractItemModel* sourceModel, QObject* parent ) :
+	QObject( parent ),
+	m_sourceModel( sourceModel )
+{
+	connect( sourceModel, &QAbstractItemModel::dataChanged, this, &ScaledFramebufferCache::invalidate );
+	connect( sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ScaledFramebufferCache::removeRows );
+	connect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &ScaledFramebufferCache::clear );
+}
+
+
+
+void ScaledFramebufferCache::setSize( QSize size )
+{
+	if( size != m_size )
+	{
+		m_size = size;
+		clear();
+	}
+}
+
+
+
+QImage ScaledFramebufferCache::image( const QModelIndex& sourceIndex )
+{
+	const auto controlInterface = key( sourceIndex );
+	if( controlInterface == nullptr || m_size.isEmpty() )
+	{
+		return {};
+	}
+
+	auto& entry = m_entries[controlInterface];
+
+	if( entry.upToDate == false && entry.scaling == false )
+	{
+		auto framebuffer = m_sourceModel->data( sourceIndex, ComputerListModel::FramebufferRole ).value<QImage>();
+		if( framebuffer.isNull() )
+		{
+			framebuffer = m_sourceModel->data( sourceIndex, Qt::DecorationRole ).value<QImage>();
+		}
+
+		entry.sourceIndex = sourceIndex;
+
+		// show a quickly scaled image until the smoothly scaled one is available
+		if( entry.image.isNull() )
+		{
+			entry.image = framebuffer.scaled( m_size, Qt::KeepAspectRatio, Qt::FastTransformation );
+		}
+
+		startScaling( controlInterface, entry, framebuffer );
+	}
+
+	return entry.image;
+}
+
+
+
+void ScaledFramebufferCache::remove( const ComputerControlInterface* controlInterface )
+{
+	m_entries.remove( controlInterface );
+}
+
+
+
+ScaledFramebufferCache::Key ScaledFramebufferCache::key( const QModelIndex& sourceIndex ) const
+{
+	return m_sourceModel->data( sourceIndex, ComputerListModel::ControlInterfaceRole )
+			.value<ComputerControlInterface::Pointer>().data();
+}
+
+
+
+void ScaledFramebufferCache::invalidate( const QModelIndex& topLeft, const QModelIndex& bottomRight,
+										 const QVector<int>& roles )
+{
+	if( roles.isEmpty() == false &&
+		roles.contains( Qt::DecorationRole ) == false &&
+		roles.contains( ComputerListModel::FramebufferRole ) == false )
+	{
+		return;
+	}
+
+	for( int row = topLeft.row(); row <= bottomRight.row(); ++row )
+	{
+		const auto entry = m_entries.find( key( m_sourceModel->index( row, 0, topLeft.parent() ) ) );
+		if( entry != m_entries.end() )
+		{
+			entry->upToDate = false;
+			entry->outdated = entry->scaling;
+		}
+	}
+}
+
+
+
+void ScaledFramebufferCache::removeRows( const QModelIndex& parent, int first, int last )
+{
+	for( int row = first; row <= last; ++row )
+	{
+		m_entries.remove( key( m_sourceModel->index( row, 0, parent ) ) );
+	}
+}
+
+
+
+void ScaledFramebufferCache::clear()
+{
+	// results of running scaling jobs are discarded
+	++m_generation;
+
+	m_entries.clear();
+}
+
+
+
+void ScaledFramebufferCache::startScaling( Key key, Entry& entry, const QImage& framebuffer )
+{
+	entry.scaling = true;
+	entry.outdated = false;
+
+	const auto generation = m_generation;
+
+	auto watcher = new QFutureWatcher<QImage>( this );
+	connect( watcher, &QFutureWatcherBase::finished, this, [=]() {
+		finishScaling( key, generation, watcher->result() );
+		watcher->deleteLater();
+	} );
+
+	watcher->setFuture( QtConcurrent::run( [framebuffer, size = m_size]() {
+		return framebuffer.scaled( size, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+	} ) );
+}
+
+
+
+void ScaledFramebufferCache::finishScaling( Key key, int generation, const QImage& image )
+{
+	if( generation != m_generation )
+	{
+		return;
+	}
+
+	const auto entry = m_entries.find( key );
+	if( entry == m_entries.end() )
+	{
+		return;
+	}
+
+	entry->image = image;
+	entry->scaling = false;
+	// framebuffer has been updated while scaling so rescale on next request
+	entry->upToDate = entry->outdated == false;
+
+	if( entry->sourceIndex.isValid() )
+	{
+		Q_EMIT imageChanged( entry->sourceIndex );
+	}
+}
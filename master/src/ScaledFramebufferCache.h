@@ -0,0 +1,78 @@
+/*
+ * ScaledFramebufferCache.h - header file for ScaledFramebufferCache
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QImage>
+
+class ComputerControlInterface;
+
+// keeps framebuffers of the computers of a ComputerListModel scaled to a given size -
+// images are rescaled in background only after the framebuffer of a computer has been
+// updated or the size has changed, so repainting views does not rescale anything
+class ScaledFramebufferCache : public QObject
+{
+	Q_OBJECT
+public:
+	explicit ScaledFramebufferCache( QAbstractItemModel* sourceModel, QObject* parent = nullptr );
+
+	void setSize( QSize size );
+
+	QImage image( const QModelIndex& sourceIndex );
+
+	void remove( const ComputerControlInterface* controlInterface );
+
+Q_SIGNALS:
+	void imageChanged( const QModelIndex& sourceIndex );
+
+private:
+	struct Entry
+	{
+		QImage image;
+		QPersistentModelIndex sourceIndex;
+		bool upToDate{false};
+		bool scaling{false};
+		bool outdated{false};
+	};
+
+	using Key = const ComputerControlInterface*;
+
+	Key key( const QModelIndex& sourceIndex ) const;
+
+	void invalidate( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles );
+	void removeRows( const QModelIndex& parent, int first, int last );
+	void clear();
+
+	void startScaling( Key key, Entry& entry, const QImage& framebuffer );
+	void finishScaling( Key key, int generation, const QImage& image );
+
+	QAbstractItemModel* m_sourceModel;
+	QSize m_size;
+	int m_generation{0};
+
+	QHash<Key, Entry> m_entries;
+
+};
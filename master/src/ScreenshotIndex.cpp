@@ -0,0 +1,370 @@
+/*
+ * ScreenshotIndex.cpp - implementation of ScreenshotIndex
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QImageReader>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocale>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+#include <utility>
+
+#include "Screenshot.h"
+#include "ScreenshotIndex.h"
+
+
+ScreenshotIndex::ScreenshotIndex( QObject* parent ) :
+	QObject( parent ),
+	m_thumbnailDirectory( QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) +
+						  QDir::separator() + QStringLiteral("Screenshots") )
+{
+	connect( &m_indexer, &QFutureWatcherBase::finished, this, &ScreenshotIndex::finishIndexer );
+
+	loadIndex();
+}
+
+
+
+ScreenshotIndex::~ScreenshotIndex()
+{
+	m_indexer.waitForFinished();
+}
+
+
+
+const ScreenshotIndex::Entries& ScreenshotIndex::update( const QString& directory )
+{
+	const auto fileInfos = QDir( directory ).entryInfoList( Screenshot::fileNameFilters(),
+															QDir::Filter::Files, QDir::SortFlag::Name );
+
+	Entries entries;
+	Entries pendingEntries;
+	entries.reserve( fileInfos.size() );
+
+	for( const auto& fileInfo : fileInfos )
+	{
+		const auto filePath = fileInfo.absoluteFilePath();
+		const auto lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+		const auto size = fileInfo.size();
+
+		auto entry = m_index.value( filePath );
+		if( entry.indexed == false || entry.lastModified != lastModified || entry.size != size )
+		{
+			entry = {};
+			entry.filePath = filePath;
+			entry.lastModified = lastModified;
+			entry.size = size;
+			pendingEntries.append( entry );
+		}
+
+		entries.append( entry );
+	}
+
+	m_entries = entries;
+
+	// also run the indexer if screenshots have been removed so that their thumbnails get removed as well
+	if( pendingEntries.isEmpty() == false || m_index.size() != m_entries.size() )
+	{
+		if( m_indexer.isRunning() )
+		{
+			m_pendingDirectory = directory;
+		}
+		else
+		{
+			startIndexer( pendingEntries );
+		}
+	}
+
+	return m_entries;
+}
+
+
+
+QFuture<QImage> ScreenshotIndex::thumbnail( const QString& filePath ) const
+{
+	const QFileInfo fileInfo( filePath );
+	const auto cachedThumbnailFilePath = thumbnailFilePath( fileInfo.absoluteFilePath(),
+															fileInfo.lastModified().toMSecsSinceEpoch(),
+															fileInfo.size() );
+
+	return QtConcurrent::run( [filePath, cachedThumbnailFilePath]() {
+		QImage thumbnail;
+		if( thumbnail.load( cachedThumbnailFilePath ) )
+		{
+			return thumbnail;
+		}
+
+		return createThumbnail( filePath, cachedThumbnailFilePath );
+	} );
+}
+
+
+
+void ScreenshotIndex::startIndexer( const Entries& pendingEntries )
+{
+	QSet<QString> thumbnailFileNames;
+	thumbnailFileNames.reserve( m_entries.size() );
+	for( const auto& entry : std::as_const(m_entries) )
+	{
+		thumbnailFileNames.insert( thumbnailFileName( entry.filePath, entry.lastModified, entry.size ) );
+	}
+
+	const auto thumbnailDirectory = m_thumbnailDirectory;
+
+	m_indexer.setFuture( QtConcurrent::run( [pendingEntries, thumbnailFileNames, thumbnailDirectory]() {
+		Entries indexedEntries;
+		indexedEntries.reserve( pendingEntries.size() );
+
+		for( const auto& entry : pendingEntries )
+		{
+			indexedEntries.append( indexFile( entry, thumbnailDirectory + QDir::separator() +
+												thumbnailFileName( entry.filePath, entry.lastModified, entry.size ) ) );
+		}
+
+		removeStaleThumbnails( thumbnailDirectory, thumbnailFileNames );
+
+		return indexedEntries;
+	} ) );
+}
+
+
+
+void ScreenshotIndex::finishIndexer()
+{
+	const auto indexedEntries = m_indexer.result();
+
+	QHash<QString, Entry> indexedEntriesByFilePath;
+	indexedEntriesByFilePath.reserve( indexedEntries.size() );
+	for( const auto& entry : indexedEntries )
+	{
+		indexedEntriesByFilePath.insert( entry.filePath, entry );
+	}
+
+	m_index.clear();
+	m_index.reserve( m_entries.size() );
+
+	for( auto& entry : m_entries )
+	{
+		const auto indexedEntry = indexedEntriesByFilePath.constFind( entry.filePath );
+		if( indexedEntry != indexedEntriesByFilePath.constEnd() &&
+			indexedEntry->lastModified == entry.lastModified &&
+			indexedEntry->size == entry.size )
+		{
+			entry = *indexedEntry;
+		}
+
+		if( entry.indexed )
+		{
+			m_index.insert( entry.filePath, entry );
+		}
+	}
+
+	saveIndex();
+
+	Q_EMIT updated();
+
+	if( m_pendingDirectory.isEmpty() == false )
+	{
+		update( std::exchange( m_pendingDirectory, {} ) );
+	}
+}
+
+
+
+void ScreenshotIndex::loadIndex()
+{
+	QFile indexFile( indexFilePath() );
+	if( indexFile.open( QFile::ReadOnly ) == false )
+	{
+		return;
+	}
+
+	const auto index = QJsonDocument::fromJson( indexFile.readAll() ).object();
+
+	// dates are stored formatted according to the system locale
+	if( index[QStringLiteral("version")].toInt() != IndexVersion ||
+		index[QStringLiteral("locale")].toString() != QLocale::system().name() )
+	{
+		return;
+	}
+
+	const auto entries = index[QStringLiteral("entries")].toArray();
+	m_index.reserve( entries.size() );
+
+	for( const auto& entryValue : entries )
+	{
+		const auto entryObject = entryValue.toObject();
+
+		Entry entry;
+		entry.filePath = entryObject[QStringLiteral("filePath")].toString();
+		entry.lastModified = entryObject[QStringLiteral("lastModified")].toVariant().toLongLong();
+		entry.size = entryObject[QStringLiteral("size")].toVariant().toLongLong();
+		entry.indexed = true;
+		entry.user = entryObject[QStringLiteral("user")].toString();
+		entry.host = entryObject[QStringLiteral("host")].toString();
+		entry.date = entryObject[QStringLiteral("date")].toString();
+		entry.time = entryObject[QStringLiteral("time")].toString();
+
+		if( entry.filePath.isEmpty() == false )
+		{
+			m_index.insert( entry.filePath, entry );
+		}
+	}
+}
+
+
+
+void ScreenshotIndex::saveIndex() const
+{
+	QJsonArray entries;
+	for( const auto& entry : m_index )
+	{
+		entries.append( QJsonObject{
+			{ QStringLiteral("filePath"), entry.filePath },
+			{ QStringLiteral("lastModified"), entry.lastModified },
+			{ QStringLiteral("size"), entry.size },
+			{ QStringLiteral("user"), entry.user },
+			{ QStringLiteral("host"), entry.host },
+			{ QStringLiteral("date"), entry.date },
+			{ QStringLiteral("time"), entry.time },
+		} );
+	}
+
+	if( QDir().mkpath( m_thumbnailDirectory ) == false )
+	{
+		vDebug() << "could not create cache directory" << m_thumbnailDirectory;
+		return;
+	}
+
+	QSaveFile indexFile( indexFilePath() );
+	if( indexFile.open( QFile::WriteOnly ) == false )
+	{
+		vDebug() << "could not write screenshot index" << indexFile.fileName();
+		return;
+	}
+
+	indexFile.write( QJsonDocument( QJsonObject{
+									   { QStringLiteral("version"), IndexVersion },
+									   { QStringLiteral("locale"), QLocale::system().name() },
+									   { QStringLiteral("entries"), entries }
+								   } ).toJson( QJsonDocument::Compact ) );
+	indexFile.commit();
+}
+
+
+
+QString ScreenshotIndex::indexFilePath() const
+{
+	return m_thumbnailDirectory + QDir::separator() + QStringLiteral("Index.json");
+}
+
+
+
+QString ScreenshotIndex::thumbnailFilePath( const QString& filePath, qint64 lastModified, qint64 size ) const
+{
+	return m_thumbnailDirectory + QDir::separator() + thumbnailFileName( filePath, lastModified, size );
+}
+
+
+
+QString ScreenshotIndex::thumbnailFileName( const QString& filePath, qint64 lastModified, qint64 size )
+{
+	const auto key = QStringLiteral("%1|%2|%3").arg( filePath ).arg( lastModified ).arg( size );
+
+	return QString::fromLatin1( QCryptographicHash::hash( key.toUtf8(), QCryptographicHash::Sha1 ).toHex() ) +
+			QStringLiteral(".png");
+}
+
+
+
+ScreenshotIndex::Entry ScreenshotIndex::indexFile( const Entry& entry, const QString& thumbnailFilePath )
+{
+	const Screenshot screenshot( entry.filePath, nullptr, Screenshot::LoadMode::MetaDataOnly );
+
+	auto indexedEntry = entry;
+	indexedEntry.indexed = true;
+	indexedEntry.user = screenshot.user();
+	indexedEntry.host = screenshot.host();
+	indexedEntry.date = screenshot.date();
+	indexedEntry.time = screenshot.time();
+
+	if( QFileInfo::exists( thumbnailFilePath ) == false )
+	{
+		createThumbnail( entry.filePath, thumbnailFilePath );
+	}
+
+	return indexedEntry;
+}
+
+
+
+QImage ScreenshotIndex::createThumbnail( const QString& filePath, const QString& thumbnailFilePath )
+{
+	QImageReader imageReader( filePath );
+
+	const auto imageSize = imageReader.size();
+	if( imageSize.width() > ThumbnailWidth || imageSize.height() > ThumbnailHeight )
+	{
+		imageReader.setScaledSize( imageSize.scaled( ThumbnailWidth, ThumbnailHeight, Qt::KeepAspectRatio ) );
+	}
+
+	const auto thumbnail = imageReader.read();
+	if( thumbnail.isNull() )
+	{
+		vDebug() << "could not read screenshot" << filePath << imageReader.errorString();
+		return {};
+	}
+
+	QDir().mkpath( QFileInfo( thumbnailFilePath ).absolutePath() );
+
+	// write atomically as thumbnails may be created by the indexer and for previews concurrently
+	QSaveFile thumbnailFile( thumbnailFilePath );
+	if( thumbnailFile.open( QFile::WriteOnly ) && thumbnail.save( &thumbnailFile, "PNG" ) )
+	{
+		thumbnailFile.commit();
+	}
+
+	return thumbnail;
+}
+
+
+
+void ScreenshotIndex::removeStaleThumbnails( const QString& thumbnailDirectory, const QSet<QString>& thumbnailFileNames )
+{
+	const auto fileNames = QDir( thumbnailDirectory ).entryList( { QStringLiteral("*.png") }, QDir::Filter::Files );
+
+	for( const auto& fileName : fileNames )
+	{
+		if( thumbnailFileNames.contains( fileName ) == false )
+		{
+			QFile::remove( thumbnailDirectory + QDir::separator() + fileName );
+		}
+	}
+}
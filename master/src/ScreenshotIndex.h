@@ -0,0 +1,97 @@
+/*
+ * ScreenshotIndex.h - header file for ScreenshotIndex
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QSet>
+
+// indexes meta data of screenshots and maintains an on-disk thumbnail cache so that
+// listing, filtering and previewing screenshots does not require decoding full images
+class ScreenshotIndex : public QObject
+{
+	Q_OBJECT
+public:
+	struct Entry
+	{
+		QString filePath;
+		qint64 lastModified{0};
+		qint64 size{0};
+		bool indexed{false};
+		QString user;
+		QString host;
+		QString date;
+		QString time;
+	};
+	using Entries = QVector<Entry>;
+
+	explicit ScreenshotIndex( QObject* parent = nullptr );
+	~ScreenshotIndex() override;
+
+	// lists all screenshots in the given directory based on the index and indexes
+	// new or modified files in background, emitting updated() when finished
+	const Entries& update( const QString& directory );
+
+	const Entries& entries() const
+	{
+		return m_entries;
+	}
+
+	// loads the thumbnail of the given screenshot from the cache or creates it in background
+	QFuture<QImage> thumbnail( const QString& filePath ) const;
+
+Q_SIGNALS:
+	void updated();
+
+private:
+	static constexpr auto ThumbnailWidth = 640;
+	static constexpr auto ThumbnailHeight = 360;
+	static constexpr auto IndexVersion = 1;
+
+	void startIndexer( const Entries& pendingEntries );
+	void finishIndexer();
+
+	void loadIndex();
+	void saveIndex() const;
+
+	QString indexFilePath() const;
+	QString thumbnailFilePath( const QString& filePath, qint64 lastModified, qint64 size ) const;
+	static QString thumbnailFileName( const QString& filePath, qint64 lastModified, qint64 size );
+
+	static Entry indexFile( const Entry& entry, const QString& thumbnailFilePath );
+	static QImage createThumbnail( const QString& filePath, const QString& thumbnailFilePath );
+	static void removeStaleThumbnails( const QString& thumbnailDirectory, const QSet<QString>& thumbnailFileNames );
+
+	QString m_thumbnailDirectory;
+
+	QHash<QString, Entry> m_index;
+	Entries m_entries;
+
+	QFutureWatcher<Entries> m_indexer;
+	QString m_pendingDirectory;
+
+};
@@ -53,7 +53,16 @@ ScreenshotManagementPanel::ScreenshotManagementPanel( QWidget *parent ) :
 	connect( &VeyonCore::filesystem(), &Filesystem::screenshotDirectoryModified,
 			 &m_reloadTimer, QOverload<>::of(&QTimer::start) );
 
-	ui->list->setModel( &m_model );
+	m_filterModel.setSourceModel( &m_model );
+	m_filterModel.setFilterRole( FilterRole );
+	m_filterModel.setFilterCaseSensitivity( Qt::CaseInsensitive );
+
+	ui->list->setModel( &m_filterModel );
+
+	connect( ui->filterLineEdit, &QLineEdit::textChanged, &m_filterModel, &QSortFilterProxyModel::setFilterFixedString );
+
+	connect( &m_index, &ScreenshotIndex::updated, this, &ScreenshotManagementPanel::updateModel );
+	connect( &m_previewLoader, &QFutureWatcherBase::finished, this, &ScreenshotManagementPanel::updatePreview );
 
 	connect( ui->list->selectionModel(), &QItemSelectionModel::currentRowChanged,
 			 this, &ScreenshotManagementPanel::updateScreenshot );
@@ -105,29 +114,93 @@ void ScreenshotManagementPanel::resizeEvent( QResizeEvent* event )
 
 void ScreenshotManagementPanel::updateModel()
 {
-	const auto currentFile = m_model.data( ui->list->currentIndex(), Qt::DisplayRole ).toString();
+	const auto currentFile = ui->list->currentIndex().data().toString();
+
+	// list screenshots based on the index only so that no images have to be decoded
+	const auto& entries = m_index.update( VeyonCore::filesystem().screenshotDirectoryPath() );
 
-	const QDir dir{ VeyonCore::filesystem().screenshotDirectoryPath() };
-	const auto files = dir.entryList( { QStringLiteral("*.png") },
-									  QDir::Filter::Files, QDir::SortFlag::Name );
+	QList<QStandardItem *> items;
+	items.reserve( entries.size() );
+
+	for( const auto& entry : entries )
+	{
+		const auto fileName = QFileInfo( entry.filePath ).fileName();
+
+		auto item = new QStandardItem( fileName );
+		if( entry.indexed )
+		{
+			item->setData( entry.user, UserRole );
+			item->setData( entry.host, HostRole );
+			item->setData( entry.date, DateRole );
+			item->setData( entry.time, TimeRole );
+		}
+		item->setData( QStringList{ fileName, entry.user, entry.host, entry.date, entry.time }.join( QLatin1Char(' ') ),
+					   FilterRole );
+		items.append( item );
+	}
 
-	m_model.setStringList( files );
+	m_model.clear();
+	m_model.invisibleRootItem()->appendRows( items );
 
-	ui->list->setCurrentIndex( m_model.index( files.indexOf( currentFile ) ) );
+	const auto currentIndices = m_filterModel.match( m_filterModel.index( 0, 0 ), Qt::DisplayRole, currentFile, 1, Qt::MatchExactly );
+	ui->list->setCurrentIndex( currentIndices.value( 0 ) );
+}
+
+
+
+void ScreenshotManagementPanel::updatePreview()
+{
+	const auto preview = m_previewLoader.future();
+	if( preview.resultCount() > 0 )
+	{
+		ui->previewLbl->setPixmap( QPixmap::fromImage( preview.result() ) );
+	}
+	else
+	{
+		ui->previewLbl->clear();
+	}
 }
 
 
 
 QString ScreenshotManagementPanel::filePath( const QModelIndex& index ) const
 {
-	return VeyonCore::filesystem().screenshotDirectoryPath() + QDir::separator() + m_model.data( index, Qt::DisplayRole ).toString();
+	return VeyonCore::filesystem().screenshotDirectoryPath() + QDir::separator() + index.data().toString();
 }
 
 
 
 void ScreenshotManagementPanel::updateScreenshot( const QModelIndex& index )
 {
-	setPreview( Screenshot( filePath( index ) ) );
+	if( index.isValid() == false )
+	{
+		m_previewLoader.setFuture( {} );
+		ui->previewLbl->clear();
+		ui->userLbl->clear();
+		ui->hostLbl->clear();
+		ui->dateLbl->clear();
+		ui->timeLbl->clear();
+		return;
+	}
+
+	if( index.data( UserRole ).isValid() )
+	{
+		ui->userLbl->setText( index.data( UserRole ).toString() );
+		ui->hostLbl->setText( index.data( HostRole ).toString() );
+		ui->dateLbl->setText( index.data( DateRole ).toString() );
+		ui->timeLbl->setText( index.data( TimeRole ).toString() );
+	}
+	else
+	{
+		// not indexed yet so read embedded meta data directly which does not require decoding the image
+		const Screenshot screenshot( filePath( index ), nullptr, Screenshot::LoadMode::MetaDataOnly );
+		ui->userLbl->setText( screenshot.user() );
+		ui->hostLbl->setText( screenshot.host() );
+		ui->dateLbl->setText( screenshot.date() );
+		ui->timeLbl->setText( screenshot.time() );
+	}
+
+	m_previewLoader.setFuture( m_index.thumbnail( filePath( index ) ) );
 }
 
 
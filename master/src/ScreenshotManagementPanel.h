@@ -25,10 +25,13 @@
 #pragma once
 
 #include <QFileSystemWatcher>
-#include <QStringListModel>
+#include <QSortFilterProxyModel>
+#include <QStandardItemModel>
 #include <QTimer>
 #include <QWidget>
 
+#include "ScreenshotIndex.h"
+
 class QModelIndex;
 class Screenshot;
 
@@ -49,7 +52,16 @@ protected:
 	void resizeEvent( QResizeEvent* event ) override;
 
 private:
+	enum Roles {
+		UserRole = Qt::UserRole,
+		HostRole,
+		DateRole,
+		TimeRole,
+		FilterRole
+	};
+
 	void updateModel();
+	void updatePreview();
 
 	QString filePath( const QModelIndex& index ) const;
 
@@ -61,9 +73,13 @@ private:
 
 	Ui::ScreenshotManagementPanel* ui;
 
-	QStringListModel m_model{this};
+	ScreenshotIndex m_index{this};
+	QStandardItemModel m_model{this};
+	QSortFilterProxyModel m_filterModel{this};
 	QFileSystemWatcher m_fsWatcher{this};
 
+	QFutureWatcher<QImage> m_previewLoader{this};
+
 	QTimer m_reloadTimer{this};
 
 	static constexpr auto FsModelResetDelay = 1000;
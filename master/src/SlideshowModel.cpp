@@ -23,43 +23,42 @@
  */
 
 #include "ComputerListModel.h"
+#include "ScaledFramebufferCache.h"
 #include "SlideshowModel.h"
 
 
 SlideshowModel::SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent ) :
-	QSortFilterProxyModel( parent )
+	QSortFilterProxyModel( parent ),
+	m_framebufferCache( new ScaledFramebufferCache( sourceModel, this ) )
 {
 	setSourceModel( sourceModel );
 
-	connect( sourceModel, &QAbstractItemModel::rowsInserted, this,
-			 [this]( const QModelIndex &parent, int start, int end )
-			 {
-				 Q_UNUSED(parent)
-				 Q_UNUSED(end)
-				 if( start <= m_currentRow )
+	connect( m_framebufferCache, &ScaledFramebufferCache::imageChanged, this,
+			 [this]( const QModelIndex& sourceIndex ) {
+				 const auto index = mapFromSource( sourceIndex );
+				 if( index.isValid() )
 				 {
-					 showNext();
-				 }
-			 } );
-	connect( sourceModel, &QAbstractItemModel::rowsRemoved, this,
-			 [this]( const QModelIndex &parent, int start, int end )
-			 {
-				 Q_UNUSED(parent)
-				 Q_UNUSED(end)
-				 if( start <= m_currentRow )
-				 {
-					 showPrevious();
+					 Q_EMIT dataChanged( index, index, { Qt::DecorationRole } );
 				 }
 			 } );
 
+	connect( sourceModel, &QAbstractItemModel::dataChanged, this, &SlideshowModel::updateEligibility );
+	connect( sourceModel, &QAbstractItemModel::rowsInserted, this, &SlideshowModel::updateEligibleControlInterfaces );
+	connect( sourceModel, &QAbstractItemModel::rowsRemoved, this, &SlideshowModel::updateEligibleControlInterfaces );
+	connect( sourceModel, &QAbstractItemModel::rowsMoved, this, &SlideshowModel::updateEligibleControlInterfaces );
+	connect( sourceModel, &QAbstractItemModel::layoutChanged, this, &SlideshowModel::updateEligibleControlInterfaces );
+	connect( sourceModel, &QAbstractItemModel::modelReset, this, &SlideshowModel::updateEligibleControlInterfaces );
+
 	connect( &m_timer, &QTimer::timeout, this, &SlideshowModel::showNext );
+
+	updateEligibleControlInterfaces();
 }
 
 
 
 void SlideshowModel::setIconSize( QSize size )
 {
-	m_iconSize = size;
+	m_framebufferCache->setSize( size );
 
 	Q_EMIT dataChanged( index( 0, 0 ), index( rowCount() - 1, 0 ), { Qt::DisplayRole, Qt::DecorationRole } );
 }
@@ -81,13 +80,7 @@ QVariant SlideshowModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto framebuffer = sourceModel()->data(sourceIndex, ComputerListModel::FramebufferRole).value<QImage>();
-		if (framebuffer.isNull())
-		{
-			framebuffer = sourceModel()->data(sourceIndex, Qt::DecorationRole).value<QImage>();
-		}
-
-		return framebuffer.scaled(m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		return m_framebufferCache->image( sourceIndex );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
@@ -110,97 +103,137 @@ void SlideshowModel::setRunning( bool running, int duration )
 
 void SlideshowModel::showPrevious()
 {
-	auto valid = false;
-
-	for( int i = 0; i < sourceModel()->rowCount(); ++i )
+	auto index = m_currentIndex;
+	if( m_eligibleControlInterfaceSet.contains( m_currentControlInterface ) )
 	{
-		setCurrentRow( m_currentRow - 1 );
-
-		if( m_currentControlInterface &&
-			m_currentControlInterface->state() == ComputerControlInterface::State::Connected &&
-			m_currentControlInterface->hasValidFramebuffer() )
-		{
-			valid = true;
-			break;
-		}
+		--index;
 	}
 
-	if( valid == false )
-	{
-		m_currentRow = 0;
-		m_currentControlInterface.clear();
-	}
+	setCurrentIndex( index < 0 ? m_eligibleControlInterfaces.size() - 1 : index );
 
-	if( m_timer.isActive() )
-	{
-		m_timer.stop();
-		m_timer.start();
-	}
+	restartTimer();
 }
 
 
 
 void SlideshowModel::showNext()
 {
-	auto valid = false;
+	setCurrentIndex( m_eligibleControlInterfaces.isEmpty() ?
+						 -1 : ( m_currentIndex + 1 ) % m_eligibleControlInterfaces.size() );
+
+	restartTimer();
+}
+
+
+
+bool SlideshowModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
+{
+	return sourceRow < sourceModel()->rowCount() &&
+		   m_currentControlInterface == sourceModel()->data( sourceModel()->index( sourceRow, 0, sourceParent ),
+															 ComputerListModel::ControlInterfaceRole )
+											.value<ComputerControlInterface::Pointer>();
+}
+
+
+
+ComputerControlInterface::Pointer SlideshowModel::controlInterface( int sourceRow ) const
+{
+	return sourceModel()->data( sourceModel()->index( sourceRow, 0 ), ComputerListModel::ControlInterfaceRole )
+			.value<ComputerControlInterface::Pointer>();
+}
+
+
+
+bool SlideshowModel::isEligible( const ComputerControlInterface::Pointer& controlInterface )
+{
+	return controlInterface &&
+		   controlInterface->state() == ComputerControlInterface::State::Connected &&
+		   controlInterface->hasValidFramebuffer();
+}
+
+
 
-	for( int i = 0; i < sourceModel()->rowCount(); ++i )
+void SlideshowModel::updateEligibility( const QModelIndex& topLeft, const QModelIndex& bottomRight,
+									   const QVector<int>& roles )
+{
+	// framebuffer updates are signalled far more often than state changes so only
+	// rebuild the list of eligible computers if eligibility actually changed
+	if( roles.isEmpty() == false &&
+		roles.contains( Qt::DecorationRole ) == false &&
+		roles.contains( ComputerListModel::FramebufferRole ) == false )
 	{
-		setCurrentRow( m_currentRow + 1 );
+		return;
+	}
 
-		if( m_currentControlInterface &&
-			m_currentControlInterface->state() == ComputerControlInterface::State::Connected &&
-			m_currentControlInterface->hasValidFramebuffer() )
+	for( int row = topLeft.row(); row <= bottomRight.row(); ++row )
+	{
+		const auto rowControlInterface = controlInterface( row );
+		if( isEligible( rowControlInterface ) != m_eligibleControlInterfaceSet.contains( rowControlInterface ) )
 		{
-			valid = true;
-			break;
+			updateEligibleControlInterfaces();
+			return;
 		}
 	}
+}
+
+
 
-	if( valid == false )
+void SlideshowModel::updateEligibleControlInterfaces()
+{
+	m_eligibleControlInterfaces.clear();
+	m_eligibleControlInterfaceSet.clear();
+	m_currentIndex = -1;
+
+	const auto rowCount = sourceModel()->rowCount();
+	m_eligibleControlInterfaces.reserve( rowCount );
+
+	bool currentControlInterfaceFound = false;
+
+	for( int row = 0; row < rowCount; ++row )
 	{
-		m_currentRow = 0;
-		m_currentControlInterface.clear();
+		const auto rowControlInterface = controlInterface( row );
+		if( isEligible( rowControlInterface ) )
+		{
+			m_eligibleControlInterfaces.append( rowControlInterface );
+			m_eligibleControlInterfaceSet.insert( rowControlInterface );
+		}
+
+		if( rowControlInterface && rowControlInterface == m_currentControlInterface )
+		{
+			m_currentIndex = m_eligibleControlInterfaces.size() - 1;
+			currentControlInterfaceFound = true;
+		}
 	}
 
-	if( m_timer.isActive() )
+	// keep showing the current computer until the next step even if it's not eligible anymore
+	// unless it has been removed, and start showing computers as soon as one is eligible
+	if( currentControlInterfaceFound == false )
 	{
-		m_timer.stop();
-		m_timer.start();
+		showNext();
 	}
 }
 
 
 
-bool SlideshowModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
+void SlideshowModel::setCurrentIndex( int index )
 {
-	return sourceRow < sourceModel()->rowCount() &&
-		   m_currentControlInterface == sourceModel()->data( sourceModel()->index( sourceRow, 0, sourceParent ),
-															 ComputerListModel::ControlInterfaceRole )
-											.value<ComputerControlInterface::Pointer>();
-}
+	const auto controlInterface = index >= 0 && index < m_eligibleControlInterfaces.size() ?
+									  m_eligibleControlInterfaces[index] : ComputerControlInterface::Pointer{};
+
+	m_currentIndex = controlInterface ? index : -1;
 
+	if( controlInterface == m_currentControlInterface )
+	{
+		return;
+	}
 
+	m_framebufferCache->remove( m_currentControlInterface.data() );
 
-void SlideshowModel::setCurrentRow( int row )
-{
 #if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
 	beginFilterChange();
 #endif
 
-	if( sourceModel()->rowCount() > 0 )
-	{
-		m_currentRow = qMax( 0, row ) % qMax( 1, sourceModel()->rowCount() );
-
-		m_currentControlInterface = sourceModel()->data( sourceModel()->index( m_currentRow, 0 ),
-														 ComputerListModel::ControlInterfaceRole )
-										.value<ComputerControlInterface::Pointer>();
-	}
-	else
-	{
-		m_currentRow = 0;
-		m_currentControlInterface.clear();
-	}
+	m_currentControlInterface = controlInterface;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
 	endFilterChange(Direction::Rows);
@@ -210,3 +243,14 @@ void SlideshowModel::setCurrentRow( int row )
 	invalidateFilter();
 #endif
 }
+
+
+
+void SlideshowModel::restartTimer()
+{
+	if( m_timer.isActive() )
+	{
+		m_timer.stop();
+		m_timer.start();
+	}
+}
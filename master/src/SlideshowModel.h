@@ -24,11 +24,14 @@
 
 #pragma once
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include <QTimer>
 
 #include "ComputerControlInterface.h"
 
+class ScaledFramebufferCache;
+
 class SlideshowModel : public QSortFilterProxyModel
 {
 	Q_OBJECT
@@ -48,13 +51,26 @@ protected:
 	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
 
 private:
-	void setCurrentRow( int row );
+	ComputerControlInterface::Pointer controlInterface( int sourceRow ) const;
+	static bool isEligible( const ComputerControlInterface::Pointer& controlInterface );
+
+	void updateEligibility( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles );
+	void updateEligibleControlInterfaces();
 
-	QSize m_iconSize;
+	void setCurrentIndex( int index );
+	void restartTimer();
+
+	ScaledFramebufferCache* m_framebufferCache;
 
 	QTimer m_timer;
 
-	int m_currentRow{0};
+	// connected computers with valid framebuffers in order of the source model
+	QVector<ComputerControlInterface::Pointer> m_eligibleControlInterfaces;
+	QSet<ComputerControlInterface::Pointer> m_eligibleControlInterfaceSet;
+
+	// position of the current computer in m_eligibleControlInterfaces - if the current
+	// computer is not eligible anymore, position of the eligible computer preceding it
+	int m_currentIndex{-1};
 	ComputerControlInterface::Pointer m_currentControlInterface;
 
 };
@@ -22,20 +22,31 @@
  *
  */
 
+#include "ScaledFramebufferCache.h"
 #include "SpotlightModel.h"
 
 
 SpotlightModel::SpotlightModel( QAbstractItemModel* sourceModel, QObject* parent ) :
-	QSortFilterProxyModel( parent )
+	QSortFilterProxyModel( parent ),
+	m_framebufferCache( new ScaledFramebufferCache( sourceModel, this ) )
 {
 	setSourceModel( sourceModel );
+
+	connect( m_framebufferCache, &ScaledFramebufferCache::imageChanged, this,
+			 [this]( const QModelIndex& sourceIndex ) {
+				 const auto index = mapFromSource( sourceIndex );
+				 if( index.isValid() )
+				 {
+					 Q_EMIT dataChanged( index, index, { Qt::DecorationRole } );
+				 }
+			 } );
 }
 
 
 
 void SpotlightModel::setIconSize( QSize size )
 {
-	m_iconSize = size;
+	m_framebufferCache->setSize( size );
 
 	Q_EMIT dataChanged( index( 0, 0 ), index( rowCount() - 1, 0 ), { Qt::DisplayRole, Qt::DecorationRole } );
 }
@@ -62,7 +73,7 @@ void SpotlightModel::add( const ComputerControlInterface::Pointer& controlInterf
 	beginFilterChange();
 #endif
 
-	m_controlInterfaces.append( controlInterface );
+	m_controlInterfaces.insert( controlInterface );
 
 	controlInterface->setUpdateMode( m_updateInRealtime
 										 ? ComputerControlInterface::UpdateMode::Live
@@ -85,7 +96,8 @@ void SpotlightModel::remove( const ComputerControlInterface::Pointer& controlInt
 	beginFilterChange();
 #endif
 
-	m_controlInterfaces.removeAll( controlInterface );
+	m_controlInterfaces.remove( controlInterface );
+	m_framebufferCache->remove( controlInterface.data() );
 
 	controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Monitoring );
 
@@ -110,13 +122,7 @@ QVariant SpotlightModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto framebuffer = sourceModel()->data(sourceIndex, ComputerListModel::FramebufferRole).value<QImage>();
-		if (framebuffer.isNull())
-		{
-			framebuffer = sourceModel()->data(sourceIndex, Qt::DecorationRole).value<QImage>();
-		}
-
-		return framebuffer.scaled(m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		return m_framebufferCache->image( sourceIndex );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
@@ -24,10 +24,13 @@
 
 #pragma once
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 #include "ComputerControlListModel.h"
 
+class ScaledFramebufferCache;
+
 class SpotlightModel : public QSortFilterProxyModel
 {
 	Q_OBJECT
@@ -48,9 +51,9 @@ protected:
 	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
 
 private:
-	QSize m_iconSize;
+	ScaledFramebufferCache* m_framebufferCache;
 	bool m_updateInRealtime{false};
 
-	ComputerControlInterfaceList m_controlInterfaces;
+	QSet<ComputerControlInterface::Pointer> m_controlInterfaces;
 
 };
@@ -22,8 +22,11 @@
  *
  */
 
+#include <QElapsedTimer>
 #include <QFile>
-#include <QRegularExpression>
+#include <QJsonObject>
+
+#include <cstring>
 
 #include "BuiltinDirectoryConfigurationPage.h"
 #include "BuiltinDirectory.h"
@@ -565,57 +568,125 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 										 const QString& regExWithPlaceholders,
 										 const QString& location )
 {
-	int lineCount = 0;
-	QMap<QString, NetworkObjectList > networkObjects;
-	while( inputFile.atEnd() == false )
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
+	const auto pattern = compileImportPattern( regExWithPlaceholders );
+
+	// map the whole file instead of reading it line by line and only fall back
+	// to reading it at once if mapping is not possible (e.g. for pipes)
+	QByteArray fileData;
+	const char* data = nullptr;
+	qint64 dataSize = inputFile.size();
+	if( dataSize > 0 )
 	{
-		++lineCount;
+		data = reinterpret_cast<const char *>( inputFile.map( 0, dataSize ) );
+	}
+	if( data == nullptr )
+	{
+		fileData = inputFile.readAll();
+		data = fileData.constData();
+		dataSize = fileData.size();
+	}
 
-		auto targetLocation = location;
+	const auto existingObjects = m_configuration.networkObjects();
 
-		const auto line = inputFile.readLine();
-		const auto networkObject = toNetworkObject( QString::fromUtf8( line ), regExWithPlaceholders, targetLocation );
+	QVector<QJsonObject> networkObjects;
+	QHash<NetworkObject::Uid, int> networkObjectIndices;
+	QHash<QString, NetworkObject::Uid> locationUids;
 
-		if( networkObject.isValid() )
+	networkObjects.reserve( existingObjects.size() );
+	networkObjectIndices.reserve( existingObjects.size() );
+
+	for( const auto& networkObjectValue : existingObjects )
+	{
+		const auto networkObjectJson = networkObjectValue.toObject();
+		const NetworkObject networkObject{networkObjectJson};
+
+		networkObjectIndices.insert( networkObject.uid(), networkObjects.size() );
+		networkObjects.append( networkObjectJson );
+
+		if( networkObject.type() == NetworkObject::Type::Location && locationUids.contains( networkObject.name() ) == false )
 		{
-			networkObjects[targetLocation].append( networkObject );
+			locationUids.insert( networkObject.name(), networkObject.uid() );
+		}
+	}
+
+	const auto updateNetworkObject = [&]( const NetworkObject& networkObject ) {
+		const auto index = networkObjectIndices.constFind( networkObject.uid() );
+		if( index != networkObjectIndices.constEnd() )
+		{
+			networkObjects[*index] = networkObject.toJson();
 		}
 		else
 		{
-			error( tr( "Error while parsing line %1." ).arg( lineCount ) );
-			return false;
+			networkObjectIndices.insert( networkObject.uid(), networkObjects.size() );
+			networkObjects.append( networkObject.toJson() );
 		}
-	}
 
-	ObjectManager<NetworkObject> objectManager( m_configuration.networkObjects() );
+		if( networkObject.type() == NetworkObject::Type::Location && locationUids.contains( networkObject.name() ) == false )
+		{
+			locationUids.insert( networkObject.name(), networkObject.uid() );
+		}
+	};
 
-	for( auto it = networkObjects.constBegin(), end = networkObjects.constEnd(); it != end; ++it )
+	int lineCount = 0;
+	for( qint64 lineStart = 0; lineStart < dataSize; )
 	{
-		auto parentLocation = objectManager.findByName( it.key() );
-		auto parentLocationUid = parentLocation.uid();
-		if( it.key().isEmpty() )
+		++lineCount;
+
+		const auto lineEnd = static_cast<const char *>( std::memchr( data + lineStart, '\n', size_t(dataSize - lineStart) ) );
+		auto lineLength = ( lineEnd ? lineEnd - data : dataSize ) - lineStart;
+		const auto nextLineStart = lineStart + lineLength + 1;
+		if( lineLength > 0 && data[lineStart + lineLength - 1] == '\r' )
 		{
-			parentLocationUid = QUuid();
+			--lineLength;
 		}
-		else if( parentLocation.isValid() == false )
+
+		auto targetLocation = location;
+
+		const auto networkObject = toNetworkObject( QString::fromUtf8( data + lineStart, int(lineLength) ),
+												   pattern, targetLocation );
+
+		if( networkObject.isValid() == false )
 		{
-			parentLocation = NetworkObject( NetworkObject::Type::Location, it.key() );
-			objectManager.update( parentLocation, true );
-			parentLocationUid = parentLocation.uid();
+			error( tr( "Error while parsing line %1." ).arg( lineCount ) );
+			return false;
 		}
 
-		for( const NetworkObject& networkObject : std::as_const(it.value()) )
+		NetworkObject::Uid parentLocationUid;
+		if( targetLocation.isEmpty() == false )
 		{
-			objectManager.update( NetworkObject( networkObject.type(),
-												 networkObject.name(),
-												 networkObject.hostAddress(),
-												 networkObject.macAddress(),
-												 {}, NetworkObject::Uid(),
-												 parentLocationUid ), true );
+			parentLocationUid = locationUids.value( targetLocation );
+			if( parentLocationUid.isNull() )
+			{
+				const NetworkObject parentLocation( NetworkObject::Type::Location, targetLocation );
+				updateNetworkObject( parentLocation );
+				parentLocationUid = parentLocation.uid();
+			}
 		}
+
+		updateNetworkObject( NetworkObject( networkObject.type(),
+											networkObject.name(),
+											networkObject.hostAddress(),
+											networkObject.macAddress(),
+											{}, NetworkObject::Uid(),
+											parentLocationUid ) );
+
+		lineStart = nextLineStart;
 	}
 
-	m_configuration.setNetworkObjects( objectManager.objects() );
+	QJsonArray networkObjectsArray;
+	for( const auto& networkObject : std::as_const(networkObjects) )
+	{
+		networkObjectsArray.append( networkObject );
+	}
+
+	m_configuration.setNetworkObjects( networkObjectsArray );
+
+	const auto elapsed = qMax<qint64>( 1, elapsedTimer.elapsed() );
+	vDebug() << "imported" << lineCount << "lines in" << elapsed << "ms ="
+			 << lineCount * 1000 / elapsed << "lines per second";
 
 	return true;
 }
@@ -624,53 +695,61 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 
 bool BuiltinDirectoryPlugin::exportFile( QFile& outputFile, const QString& formatString, const QString& location )
 {
-	ObjectManager<NetworkObject> objectManager( m_configuration.networkObjects() );
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
 
-	const auto& networkObjects = objectManager.objects();
+	const auto networkObjects = m_configuration.networkObjects();
 
-	NetworkObject locationObject;
-	if( location.isEmpty() == false )
+	QHash<NetworkObject::Uid, QString> locationNames;
+	NetworkObject::Uid locationUid;
+
+	for( const auto& networkObjectValue : networkObjects )
 	{
-		locationObject = objectManager.findByName( location );
-		if (locationObject.isValid() == false)
+		const NetworkObject networkObject{networkObjectValue.toObject()};
+		if( networkObject.type() == NetworkObject::Type::Location )
 		{
-			error(tr("Location \"%1\" not found." ).arg(location));
-			return false;
+			locationNames.insert( networkObject.uid(), networkObject.name() );
+			if( locationUid.isNull() && location.isEmpty() == false && networkObject.name() == location )
+			{
+				locationUid = networkObject.uid();
+			}
 		}
 	}
 
-	QStringList lines;
-	lines.reserve( networkObjects.count() );
+	if( location.isEmpty() == false && locationUid.isNull() )
+	{
+		error(tr("Location \"%1\" not found." ).arg(location));
+		return false;
+	}
 
-	for( auto it = networkObjects.constBegin(), end = networkObjects.constEnd(); it != end; ++it )
+	QByteArray outputData;
+	int lineCount = 0;
+
+	for( const auto& networkObjectValue : networkObjects )
 	{
-		const NetworkObject networkObject{it->toObject()};
+		const NetworkObject networkObject{networkObjectValue.toObject()};
 		if (networkObject.type() != NetworkObject::Type::Host)
 		{
 			continue;
 		}
 
-		auto currentLocation = location;
-
-		if( locationObject.isValid() )
+		if( locationUid.isNull() == false && networkObject.parentUid() != locationUid )
 		{
-			if( networkObject.parentUid() != locationObject.uid() )
-			{
-				continue;
-			}
-		}
-		else
-		{
-			currentLocation = objectManager.findByUid( networkObject.parentUid() ).name();
+			continue;
 		}
 
-		lines.append( toFormattedString( networkObject, formatString, currentLocation ) );
+		const auto& currentLocation = location.isEmpty() ? locationNames.value( networkObject.parentUid() ) : location;
+
+		outputData += toFormattedString( networkObject, formatString, currentLocation ).toUtf8();
+		outputData += '\n';
+		++lineCount;
 	}
 
-	// append empty string to generate final newline at end of file
-	lines += QString();
+	outputFile.write( outputData );
 
-	outputFile.write(lines.join(QLatin1Char('\n')).toUtf8());
+	const auto elapsed = qMax<qint64>( 1, elapsedTimer.elapsed() );
+	vDebug() << "exported" << lineCount << "lines in" << elapsed << "ms ="
+			 << lineCount * 1000 / elapsed << "lines per second";
 
 	return true;
 }
@@ -692,8 +771,7 @@ NetworkObject BuiltinDirectoryPlugin::findNetworkObject( const QString& uidOrNam
 
 
 
-NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const QString& regExWithPlaceholders,
-													   QString& location )
+BuiltinDirectoryPlugin::ImportPattern BuiltinDirectoryPlugin::compileImportPattern( const QString& regExWithPlaceholders )
 {
 	QStringList placeholders;
 	static const QRegularExpression varDetectionRX{QStringLiteral("\\((%\\w+%):[^)]+\\)")};
@@ -710,33 +788,50 @@ NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, cons
 		rxString.replace( QStringLiteral("%1:").arg( var ), QString() );
 	}
 
-	auto match = QRegularExpression( rxString ).match( line );
+	ImportPattern pattern;
+	pattern.regularExpression.setPattern( rxString );
+	pattern.regularExpression.optimize();
+
+	const auto captureIndex = [&placeholders]( const QString& placeholder ) {
+		const auto index = placeholders.indexOf( placeholder );
+		return index != -1 ? 1 + index : -1;
+	};
+
+	pattern.typeIndex = captureIndex( QStringLiteral("%type%") );
+	pattern.locationIndex = captureIndex( QStringLiteral("%location%") );
+	pattern.nameIndex = captureIndex( QStringLiteral("%name%") );
+	pattern.hostIndex = captureIndex( QStringLiteral("%host%") );
+	pattern.macIndex = captureIndex( QStringLiteral("%mac%") );
+
+	return pattern;
+}
+
+
+
+NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const ImportPattern& pattern,
+													   QString& location )
+{
+	auto match = pattern.regularExpression.match( line );
 	if( match.hasMatch() )
 	{
 		auto objectType = NetworkObject::Type::Host;
-		const auto typeIndex = placeholders.indexOf( QStringLiteral("%type%") );
-		if( typeIndex != -1 )
+		if( pattern.typeIndex != -1 )
 		{
-			objectType = parseNetworkObjectType( match.captured( 1 + typeIndex ) );
+			objectType = parseNetworkObjectType( match.captured( pattern.typeIndex ) );
 		}
 
-		const auto locationIndex = placeholders.indexOf( QStringLiteral("%location%") );
-		const auto nameIndex = placeholders.indexOf( QStringLiteral("%name%") );
-		const auto hostIndex = placeholders.indexOf( QStringLiteral("%host%") );
-		const auto macIndex = placeholders.indexOf( QStringLiteral("%mac%") );
-
-		auto name = ( nameIndex != -1 ) ? match.captured( 1 + nameIndex ).trimmed() : QString();
-		auto host = ( hostIndex != -1 ) ? match.captured( 1 + hostIndex ).trimmed() : QString();
-		auto mac = ( macIndex != -1 ) ? match.captured( 1 + macIndex ).trimmed() : QString();
+		auto name = ( pattern.nameIndex != -1 ) ? match.captured( pattern.nameIndex ).trimmed() : QString();
+		auto host = ( pattern.hostIndex != -1 ) ? match.captured( pattern.hostIndex ).trimmed() : QString();
+		auto mac = ( pattern.macIndex != -1 ) ? match.captured( pattern.macIndex ).trimmed() : QString();
 
 		if( objectType == NetworkObject::Type::Location )
 		{
 			return NetworkObject( NetworkObject::Type::Location, name );
 		}
 
-		if( location.isEmpty() && locationIndex != -1 )
+		if( location.isEmpty() && pattern.locationIndex != -1 )
 		{
-			location = match.captured( 1 + locationIndex ).trimmed();
+			location = match.captured( pattern.locationIndex ).trimmed();
 		}
 
 		if( host.isEmpty() )
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QRegularExpression>
+
 #include "CommandLinePluginInterface.h"
 #include "CommandLineIO.h"
 #include "ConfigurationPagePluginInterface.h"
@@ -133,7 +135,18 @@ private:
 
 	NetworkObject findNetworkObject( const QString& uidOrName ) const;
 
-	static NetworkObject toNetworkObject( const QString& line, const QString& regExWithVariables, QString& location );
+	struct ImportPattern
+	{
+		QRegularExpression regularExpression;
+		int typeIndex{-1};
+		int locationIndex{-1};
+		int nameIndex{-1};
+		int hostIndex{-1};
+		int macIndex{-1};
+	};
+
+	static ImportPattern compileImportPattern( const QString& regExWithVariables );
+	static NetworkObject toNetworkObject( const QString& line, const ImportPattern& pattern, QString& location );
 	static QString toFormattedString( const NetworkObject& networkObject, const QString& formatString, const QString& location );
 
 	static QStringList importExportPlaceholders();
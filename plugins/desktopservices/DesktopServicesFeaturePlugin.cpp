@@ -159,7 +159,7 @@ bool DesktopServicesFeaturePlugin::handleFeatureMessage( VeyonServerInterface& s
 		const auto apps = message.argument( Argument::Applications ).toStringList();
 		for( const auto& app : apps )
 		{
-			runApplicationAsUser( app );
+			runApplicationAsUser( app, server.sessionUser(), server.sessionEnvironment() );
 		}
 	}
 	else if( message.featureUid() == m_openWebsiteFeature.uid() )
@@ -362,7 +362,8 @@ void DesktopServicesFeaturePlugin::openWebsite( const QString& website, const QS
 
 
 
-void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandLine )
+void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandLine, const QString& user,
+												   const QProcessEnvironment& environment )
 {
 	vDebug() << "launching" << commandLine;
 
@@ -389,9 +390,9 @@ void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandL
 		program = commandLine;
 	}
 
-	VeyonCore::platform().coreFunctions().runProgramAsUser( program, parameters,
-															VeyonCore::platform().userFunctions().currentUser(),
-															VeyonCore::platform().coreFunctions().activeDesktopName() );
+	VeyonCore::platform().coreFunctions().runProgramAsUser( program, parameters, user,
+															VeyonCore::platform().coreFunctions().activeDesktopName(),
+															environment );
 }
 
 
@@ -416,7 +417,8 @@ bool DesktopServicesFeaturePlugin::openWebsite( const QString& urlString )
 
 		runApplicationAsUser( QStringLiteral("%1 %2").arg(
 							  VeyonCore::platform().coreFunctions().genericUrlHandler(),
-							  url.toString() ) );
+							  url.toString() ),
+							  VeyonCore::platform().userFunctions().currentUser() );
 	}
 
 	return true;
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QProcessEnvironment>
+
 #include "ConfigurationPagePluginInterface.h"
 #include "DesktopServicesConfiguration.h"
 #include "DesktopServiceObject.h"
@@ -120,7 +122,8 @@ private:
 	void openWebsite( const QString& website, const QString& saveItemName,
 					 VeyonMasterInterface& master, const ComputerControlInterfaceList& computerControlInterfaces );
 
-	void runApplicationAsUser( const QString& commandLine );
+	void runApplicationAsUser( const QString& commandLine, const QString& user,
+							   const QProcessEnvironment& environment = {} );
 	bool openWebsite( const QString& urlString );
 
 	void updatePredefinedApplications();
@@ -308,7 +308,8 @@ bool LinuxCoreFunctions::runProgramAsAdmin( const QString& program, const QStrin
 
 
 bool LinuxCoreFunctions::runProgramAsUser( const QString& program, const QStringList& parameters,
-										   const QString& username, const QString& desktop )
+										   const QString& username, const QString& desktop,
+										   const QProcessEnvironment& environment )
 {
 	Q_UNUSED(desktop);
 
@@ -368,6 +369,11 @@ bool LinuxCoreFunctions::runProgramAsUser( const QString& program, const QString
 	auto process = new UserProcess(adjustChildProcessPrivileges);
 #endif
 
+	if( environment.isEmpty() == false )
+	{
+		process->setProcessEnvironment( environment );
+	}
+
 	QObject::connect( process, QOverload<int, QProcess::ExitStatus>::of( &QProcess::finished ), &QProcess::deleteLater );
 	process->start( program, parameters );
 
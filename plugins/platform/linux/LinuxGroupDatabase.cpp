@@ -0,0 +1,268 @@
+/*
+ * LinuxGroupDatabase.cpp - implementation of LinuxGroupDatabase class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QFileInfo>
+#include <QVector>
+
+#include "LinuxGroupDatabase.h"
+#include "VeyonCore.h"
+
+#include <cerrno>
+#include <pwd.h>
+
+
+LinuxGroupDatabase& LinuxGroupDatabase::instance()
+{
+	static LinuxGroupDatabase database;
+
+	return database;
+}
+
+
+
+QStringList LinuxGroupDatabase::groupNames()
+{
+	QMutexLocker locker(&m_mutex);
+
+	validate();
+
+	return groups().names;
+}
+
+
+
+QStringList LinuxGroupDatabase::groupsOfUser(const QString& username)
+{
+	QMutexLocker locker(&m_mutex);
+
+	validate();
+
+	const auto it = m_groupsByUser.constFind(username);
+	if (it != m_groupsByUser.constEnd())
+	{
+		return *it;
+	}
+
+	const auto userGroups = resolveGroupsOfUser(username);
+	m_groupsByUser.insert(username, userGroups);
+
+	return userGroups;
+}
+
+
+
+void LinuxGroupDatabase::validate()
+{
+	const auto modificationTime = groupFileModificationTime();
+
+	if (m_age.isValid() == false ||
+		m_age.hasExpired(TimeToLive) ||
+		modificationTime != m_groupFileModificationTime)
+	{
+		invalidate();
+
+		m_groupFileModificationTime = modificationTime;
+		m_age.start();
+	}
+}
+
+
+
+void LinuxGroupDatabase::invalidate()
+{
+	m_groups = {};
+	m_groupsByUser.clear();
+}
+
+
+
+const LinuxGroupDatabase::Groups& LinuxGroupDatabase::groups()
+{
+	if (m_groups.valid == false)
+	{
+		QElapsedTimer elapsedTimer;
+		elapsedTimer.start();
+
+		m_groups = enumerateGroups();
+
+		vDebug() << "enumerated" << m_groups.names.size() << "groups in" << elapsedTimer.elapsed() << "ms";
+	}
+
+	return m_groups;
+}
+
+
+
+LinuxGroupDatabase::Groups LinuxGroupDatabase::enumerateGroups()
+{
+	Groups groups;
+	groups.valid = true;
+
+	QByteArray buffer(InitialBufferSize, Qt::Uninitialized);
+	struct group entry{};
+	struct group* result = nullptr;
+
+	// getgrent_r() operates on a process-wide iterator which is protected by m_mutex
+	setgrent();
+
+	while (true)
+	{
+		const auto error = getgrent_r(&entry, buffer.data(), size_t(buffer.size()), &result);
+		if (error == ERANGE && buffer.size() < MaximumBufferSize)
+		{
+			// entry is returned again with the next call
+			buffer.resize(buffer.size() * 2);
+			continue;
+		}
+
+		if (error != 0 || result == nullptr)
+		{
+			if (error != 0 && error != ENOENT)
+			{
+				vWarning() << "failed to enumerate groups:" << qt_error_string(error);
+			}
+			break;
+		}
+
+		const auto name = QString::fromUtf8(entry.gr_name);
+		groups.names.append(name);
+		groups.namesById.insert(entry.gr_gid, name);
+
+		for (auto member = entry.gr_mem; member && *member; ++member)
+		{
+			groups.membershipsByUser[QString::fromUtf8(*member)].append(name);
+		}
+	}
+
+	endgrent();
+
+	return groups;
+}
+
+
+
+QStringList LinuxGroupDatabase::resolveGroupsOfUser(const QString& username)
+{
+	const auto name = username.toUtf8();
+
+	QByteArray buffer(InitialBufferSize, Qt::Uninitialized);
+	struct passwd entry{};
+	struct passwd* result = nullptr;
+
+	int error = 0;
+	while ((error = getpwnam_r(name.constData(), &entry, buffer.data(), size_t(buffer.size()), &result)) == ERANGE &&
+		   buffer.size() < MaximumBufferSize)
+	{
+		buffer.resize(buffer.size() * 2);
+	}
+
+	if (error != 0 || result == nullptr)
+	{
+		// not a known user account (e.g. a name only listed as group member) so fall back to
+		// memberships from the enumerated group database
+		return groups().membershipsByUser.value(username);
+	}
+
+	// getgrouplist() also takes memberships into account which can't be enumerated
+	// (e.g. SSSD with enumerate=false) but always includes the primary group of the user
+	int groupCount = InitialGroupCount;
+	QVector<gid_t> groupIds(groupCount);
+	while (getgrouplist(name.constData(), entry.pw_gid, groupIds.data(), &groupCount) < 0)
+	{
+		// glibc reports the required number of groups, other implementations may not
+		if (groupCount <= groupIds.size())
+		{
+			groupCount = groupIds.size() * 2;
+		}
+
+		if (groupIds.size() >= MaximumGroupCount || groupCount > MaximumGroupCount)
+		{
+			vWarning() << "could not determine groups of user" << username;
+			return groups().membershipsByUser.value(username);
+		}
+
+		groupIds.resize(groupCount);
+	}
+
+	// as before, the primary group only counts if the user is listed as its member explicitly
+	// so access control decisions do not change for existing deployments
+	const auto enumeratedMemberships = groups().membershipsByUser.value(username);
+
+	QStringList groupNames;
+	groupNames.reserve(groupCount);
+
+	for (int i = 0; i < groupCount; ++i)
+	{
+		const auto groupName = this->groupName(groupIds[i]);
+		if (groupName.isEmpty() ||
+			groupNames.contains(groupName) ||
+			(groupIds[i] == entry.pw_gid && enumeratedMemberships.contains(groupName) == false))
+		{
+			continue;
+		}
+
+		groupNames.append(groupName);
+	}
+
+	return groupNames;
+}
+
+
+
+QString LinuxGroupDatabase::groupName(gid_t groupId)
+{
+	if (m_groups.valid)
+	{
+		const auto it = m_groups.namesById.constFind(groupId);
+		if (it != m_groups.namesById.constEnd())
+		{
+			return *it;
+		}
+	}
+
+	QByteArray buffer(InitialBufferSize, Qt::Uninitialized);
+	struct group entry{};
+	struct group* result = nullptr;
+
+	int error = 0;
+	while ((error = getgrgid_r(groupId, &entry, buffer.data(), size_t(buffer.size()), &result)) == ERANGE &&
+		   buffer.size() < MaximumBufferSize)
+	{
+		buffer.resize(buffer.size() * 2);
+	}
+
+	if (error != 0 || result == nullptr)
+	{
+		return {};
+	}
+
+	return QString::fromUtf8(entry.gr_name);
+}
+
+
+
+qint64 LinuxGroupDatabase::groupFileModificationTime()
+{
+	return QFileInfo(groupFilePath()).lastModified().toMSecsSinceEpoch();
+}
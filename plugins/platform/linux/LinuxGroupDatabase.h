@@ -0,0 +1,84 @@
+/*
+ * LinuxGroupDatabase.h - declaration of LinuxGroupDatabase class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+#include <grp.h>
+
+// resolves groups and group memberships in-process through NSS (getgrent_r/getgrouplist)
+// and caches the results - like nscd the cache is dropped once its time to live has
+// expired or the local group database file has been modified
+class LinuxGroupDatabase
+{
+public:
+	static LinuxGroupDatabase& instance();
+
+	QStringList groupNames();
+	QStringList groupsOfUser(const QString& username);
+
+private:
+	static constexpr auto TimeToLive = 60 * 1000;
+	static constexpr auto InitialBufferSize = 16 * 1024;
+	static constexpr auto MaximumBufferSize = 16 * 1024 * 1024;
+	static constexpr auto InitialGroupCount = 64;
+	static constexpr auto MaximumGroupCount = 65536; // NGROUPS_MAX on Linux
+
+	struct Groups
+	{
+		bool valid{false};
+		QStringList names;
+		QHash<gid_t, QString> namesById;
+		QHash<QString, QStringList> membershipsByUser;
+	};
+
+	LinuxGroupDatabase() = default;
+
+	void validate();
+	void invalidate();
+	const Groups& groups();
+
+	static Groups enumerateGroups();
+	QStringList resolveGroupsOfUser(const QString& username);
+	QString groupName(gid_t groupId);
+
+	static qint64 groupFileModificationTime();
+
+	static QString groupFilePath()
+	{
+		return QStringLiteral("/etc/group");
+	}
+
+	QMutex m_mutex;
+	QElapsedTimer m_age;
+	qint64 m_groupFileModificationTime{-1};
+
+	Groups m_groups;
+	QHash<QString, QStringList> m_groupsByUser;
+
+};
@@ -26,17 +26,39 @@
 #include <QEventLoop>
 #include <QFileInfo>
 #include <QTimer>
+#include <QtConcurrent>
 
 #include "LinuxPlatformConfiguration.h"
 #include "LinuxServerProcess.h"
 #include "LinuxServiceCore.h"
 #include "LinuxSessionFunctions.h"
+#include "LinuxUserFunctions.h"
+#include "MultiSessionServerControl.h"
+#include "PluginManager.h"
 #include "VeyonConfiguration.h"
+#include "VncServerPluginInterface.h"
 
 
 LinuxServiceCore::LinuxServiceCore( QObject* parent ) :
 	QObject( parent )
 {
+	if( LinuxPlatformConfiguration(&VeyonCore::config()).sharedServerProcessEnabled() )
+	{
+		if( m_sessionManager.mode() != PlatformSessionManager::Mode::Multi )
+		{
+			vWarning() << "a single server process can serve multiple sessions in multi session mode only";
+		}
+		else if( isSharedServerProcessSupported() == false )
+		{
+			vWarning() << "the configured VNC server does not support serving multiple sessions by a single process";
+		}
+		else
+		{
+			vInfo() << "serving all sessions by a single server process";
+			m_sharedServerProcessEnabled = true;
+		}
+	}
+
 	connectToLoginManager();
 }
 
@@ -80,7 +102,9 @@ void LinuxServiceCore::stopServer( const QString& login1SessionId, const QDBusOb
 
 	vDebug() << "session removed" << sessionPath;
 
-	if( m_serverProcesses.contains( sessionPath ) )
+	m_sessionEnvironmentLookups.remove( sessionPath );
+
+	if( hasServer( sessionPath ) )
 	{
 		stopServer( sessionPath );
 
@@ -129,9 +153,11 @@ void LinuxServiceCore::startServers()
 
 	for( const auto& s : sessions )
 	{
-		if( m_serverProcesses.contains( s ) == false &&
+		if( hasServer( s ) == false &&
 			m_deferredServerSessions.contains( s ) == false &&
-			( m_sessionManager.mode() == PlatformSessionManager::Mode::Multi || m_serverProcesses.isEmpty() ) )
+			m_sessionEnvironmentLookups.contains( s ) == false &&
+			( m_sessionManager.mode() == PlatformSessionManager::Mode::Multi ||
+			  ( m_serverProcesses.isEmpty() && m_sessionEnvironmentLookups.isEmpty() ) ) )
 		{
 			startServer( s );
 		}
@@ -186,7 +212,39 @@ void LinuxServiceCore::startServer( const QString& sessionPath )
 		return;
 	}
 
-	auto sessionEnvironment = LinuxSessionFunctions::getSessionEnvironment( sessionLeader );
+	if( m_sessionEnvironmentLookups.contains( sessionPath ) )
+	{
+		return;
+	}
+
+	// walking the processes of the session may take a while on busy systems so do it
+	// outside the event loop and continue once the environment is available
+	auto lookup = new QFutureWatcher<QProcessEnvironment>( this );
+	connect( lookup, &QFutureWatcherBase::finished, this, [=]() {
+		// lookup is discarded if the session has been stopped in the meantime
+		if( m_sessionEnvironmentLookups.value( sessionPath ) == lookup )
+		{
+			m_sessionEnvironmentLookups.remove( sessionPath );
+			finishServerStart( sessionPath, lookup->result() );
+		}
+		lookup->deleteLater();
+	} );
+
+	m_sessionEnvironmentLookups[sessionPath] = lookup;
+
+	lookup->setFuture( QtConcurrent::run( [sessionLeader]() {
+		return LinuxSessionFunctions::getSessionEnvironment( sessionLeader );
+	} ) );
+}
+
+
+
+void LinuxServiceCore::finishServerStart( const QString& sessionPath, QProcessEnvironment sessionEnvironment )
+{
+	if( hasServer( sessionPath ) )
+	{
+		return;
+	}
 
 	if( sessionEnvironment.isEmpty() )
 	{
@@ -242,6 +300,13 @@ void LinuxServiceCore::startServer( const QString& sessionPath )
 	sessionEnvironment.insert( QLatin1String( ServiceDataManager::serviceDataTokenEnvironmentVariable() ),
 							   QString::fromUtf8( m_dataManager.token().toByteArray() ) );
 
+	if( m_sharedServerProcessEnabled )
+	{
+		startSharedServerSession( sessionPath, sessionId, sessionEnvironment );
+		m_deferredServerSessions.removeAll( sessionPath );
+		return;
+	}
+
 	auto serverProcess = new LinuxServerProcess( sessionEnvironment, sessionPath, sessionId, this );
 	serverProcess->start();
 
@@ -269,6 +334,12 @@ void LinuxServiceCore::stopServer( const QString& sessionPath )
 {
 	m_sessionManager.closeSession( sessionPath );
 
+	if( m_sharedServerSessions.contains( sessionPath ) )
+	{
+		stopSharedServerSession( sessionPath );
+		return;
+	}
+
 	if( m_serverProcesses.contains( sessionPath ) == false )
 	{
 		return;
@@ -292,6 +363,11 @@ void LinuxServiceCore::stopAllServers()
 	{
 		stopServer( m_serverProcesses.firstKey() );
 	}
+
+	while( m_sharedServerSessions.isEmpty() == false )
+	{
+		stopServer( m_sharedServerSessions.firstKey() );
+	}
 }
 
 
@@ -315,3 +391,120 @@ void LinuxServiceCore::checkSessionState( const QString& sessionPath )
 		}
 	}
 }
+
+
+
+bool LinuxServiceCore::isSharedServerProcessSupported()
+{
+	const auto vncServerPluginUid = VeyonCore::config().vncServerPlugin();
+
+	for( auto pluginObject : std::as_const( VeyonCore::pluginManager().pluginObjects() ) )
+	{
+		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
+		auto vncServerPluginInterface = qobject_cast<VncServerPluginInterface *>( pluginObject );
+
+		if( pluginInterface && vncServerPluginInterface && pluginInterface->uid() == vncServerPluginUid )
+		{
+			return vncServerPluginInterface->supportsMultipleInstances();
+		}
+	}
+
+	return false;
+}
+
+
+
+void LinuxServiceCore::startSharedServerSession( const QString& sessionPath, PlatformSessionManager::SessionId sessionId,
+												 const QProcessEnvironment& sessionEnvironment )
+{
+	QString sessionUser;
+	if( LinuxSessionFunctions::getSessionClass( sessionPath ) == LinuxSessionFunctions::Class::User )
+	{
+		const auto sessionUserPath = LinuxSessionFunctions::getSessionUser( sessionPath );
+		if( sessionUserPath.isEmpty() == false )
+		{
+			sessionUser = LinuxUserFunctions::getUserProperty( sessionUserPath, QStringLiteral("Name") ).toString();
+		}
+	}
+
+	m_sharedServerSessions[sessionPath] = { sessionId, sessionUser, sessionEnvironment };
+
+	if( m_sharedServerProcess == nullptr )
+	{
+		// opens all sessions once started
+		startSharedServerProcess();
+	}
+	else if( m_sharedServerProcess->state() == QProcess::Running )
+	{
+		m_sharedServerProcess->write( MultiSessionServerControl::openSessionCommand( sessionId, sessionUser,
+																					 sessionEnvironment ) );
+	}
+}
+
+
+
+void LinuxServiceCore::stopSharedServerSession( const QString& sessionPath )
+{
+	vInfo() << "stopping server for removed session" << sessionPath;
+
+	const auto session = m_sharedServerSessions.take( sessionPath );
+
+	if( m_sharedServerProcess == nullptr )
+	{
+		return;
+	}
+
+	if( m_sharedServerSessions.isEmpty() )
+	{
+		// do not keep an idle server process around
+		m_sharedServerProcess->disconnect( this );
+		m_sharedServerProcess->stop();
+		m_sharedServerProcess->deleteLater();
+		m_sharedServerProcess = nullptr;
+	}
+	else if( m_sharedServerProcess->state() == QProcess::Running )
+	{
+		m_sharedServerProcess->write( MultiSessionServerControl::closeSessionCommand( session.sessionId ) );
+	}
+}
+
+
+
+void LinuxServiceCore::startSharedServerProcess()
+{
+	auto environment = QProcessEnvironment::systemEnvironment();
+	environment.insert( QLatin1String( MultiSessionServerControl::environmentVariable() ), QStringLiteral("1") );
+	// the process is not bound to the display of any session
+	environment.insert( QStringLiteral("QT_QPA_PLATFORM"), QStringLiteral("offscreen") );
+	environment.insert( QLatin1String( ServiceDataManager::serviceDataTokenEnvironmentVariable() ),
+						QString::fromUtf8( m_dataManager.token().toByteArray() ) );
+
+	vInfo() << "Starting shared server process";
+
+	m_sharedServerProcess = new LinuxServerProcess( environment, {}, PlatformSessionFunctions::DefaultSessionId, this );
+
+	connect( m_sharedServerProcess, &QProcess::started, this, [this]() {
+		for( const auto& session : std::as_const(m_sharedServerSessions) )
+		{
+			m_sharedServerProcess->write( MultiSessionServerControl::openSessionCommand( session.sessionId,
+																						 session.sessionUser,
+																						 session.sessionEnvironment ) );
+		}
+	} );
+	connect( m_sharedServerProcess, &QProcess::stateChanged, this, &LinuxServiceCore::checkSharedServerProcessState );
+
+	m_sharedServerProcess->start();
+}
+
+
+
+void LinuxServiceCore::checkSharedServerProcessState()
+{
+	// restart server if crashed - all sessions are opened again once it has been started
+	const auto serverProcess = m_sharedServerProcess;
+	if( serverProcess && serverProcess->state() == QProcess::NotRunning )
+	{
+		vWarning() << "shared server process is not running - restarting in" << ServerRestartInterval << "msecs";
+		QTimer::singleShot( ServerRestartInterval, serverProcess, [serverProcess]() { serverProcess->start(); } );
+	}
+}
@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include <QFutureWatcher>
+#include <QProcessEnvironment>
+
 #include "LinuxCoreFunctions.h"
 #include "PlatformSessionManager.h"
 #include "ServiceDataManager.h"
@@ -54,15 +57,40 @@ private:
 	void connectToLoginManager();
 	void startServers();
 	void startServer( const QString& sessionPath );
+	void finishServerStart( const QString& sessionPath, QProcessEnvironment sessionEnvironment );
 	void deferServerStart( const QString& sessionPath, int delay );
 	void stopServer( const QString& sessionPath );
 	void stopAllServers();
 
 	void checkSessionState( const QString& sessionPath );
 
+	bool hasServer( const QString& sessionPath ) const
+	{
+		return m_serverProcesses.contains( sessionPath ) || m_sharedServerSessions.contains( sessionPath );
+	}
+
+	static bool isSharedServerProcessSupported();
+	void startSharedServerSession( const QString& sessionPath, PlatformSessionManager::SessionId sessionId,
+								   const QProcessEnvironment& sessionEnvironment );
+	void stopSharedServerSession( const QString& sessionPath );
+	void startSharedServerProcess();
+	void checkSharedServerProcessState();
+
 	LinuxCoreFunctions::DBusInterfacePointer m_loginManager{LinuxCoreFunctions::systemdLoginManager()};
 	QMap<QString, LinuxServerProcess *> m_serverProcesses;
 	QStringList m_deferredServerSessions;
+	QMap<QString, QFutureWatcher<QProcessEnvironment> *> m_sessionEnvironmentLookups;
+
+	// sessions served by a single server process if enabled
+	struct SharedServerSession
+	{
+		PlatformSessionManager::SessionId sessionId;
+		QString sessionUser;
+		QProcessEnvironment sessionEnvironment;
+	};
+	bool m_sharedServerProcessEnabled{false};
+	LinuxServerProcess* m_sharedServerProcess{nullptr};
+	QMap<QString, SharedServerSession> m_sharedServerSessions;
 
 	ServiceDataManager m_dataManager{};
 	PlatformSessionManager m_sessionManager{};
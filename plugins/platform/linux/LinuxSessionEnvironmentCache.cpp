@@ -0,0 +1,349 @@
+/*
+ * LinuxSessionEnvironmentCache.cpp - implementation of LinuxSessionEnvironmentCache class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+
+#include "LinuxSessionEnvironmentCache.h"
+
+
+LinuxSessionEnvironmentCache::LinuxSessionEnvironmentCache(const QString& procPath) :
+	m_procPath(procPath)
+{
+}
+
+
+
+LinuxSessionEnvironmentCache* LinuxSessionEnvironmentCache::instance()
+{
+	static auto cache = new LinuxSessionEnvironmentCache;
+
+	return cache;
+}
+
+
+
+QProcessEnvironment LinuxSessionEnvironmentCache::environment(int sessionLeaderPid)
+{
+	qint64 leaderStartTime = -1;
+	if (sessionLeaderPid <= 0 || readStat(sessionLeaderPid, &leaderStartTime) == false)
+	{
+		return {};
+	}
+
+	Session previousSession;
+
+	{
+		QMutexLocker locker(&m_sessionsMutex);
+
+		removeStaleSessions();
+
+		const auto session = m_sessions.constFind(sessionLeaderPid);
+		if (session != m_sessions.constEnd() && session->leaderStartTime == leaderStartTime)
+		{
+			previousSession = *session;
+		}
+	}
+
+	// walk the process tree without holding the lock so lookups for other sessions are not blocked
+	auto session = update(sessionLeaderPid, leaderStartTime, previousSession);
+
+	QMutexLocker locker(&m_sessionsMutex);
+	m_sessions[sessionLeaderPid] = session;
+
+	return session.environment;
+}
+
+
+
+void LinuxSessionEnvironmentCache::clear()
+{
+	QMutexLocker locker(&m_sessionsMutex);
+	m_sessions.clear();
+}
+
+
+
+LinuxSessionEnvironmentCache::Session LinuxSessionEnvironmentCache::update(int sessionLeaderPid, qint64 leaderStartTime,
+																		   const Session& previousSession)
+{
+	Session session;
+	session.leaderStartTime = leaderStartTime;
+
+	ParentMap parentMap;
+	bool parentMapLoaded = false;
+
+	auto pendingPids = childProcesses(sessionLeaderPid, parentMap, parentMapLoaded);
+
+	while (pendingPids.isEmpty() == false)
+	{
+		const auto pid = pendingPids.takeLast();
+		if (pid == sessionLeaderPid || session.processes.contains(pid))
+		{
+			continue;
+		}
+
+		Process process;
+		if (readStat(pid, &process.startTime, nullptr, &process.executionId) == false)
+		{
+			// process exited in the meantime
+			continue;
+		}
+
+		const auto cachedProcess = previousSession.processes.constFind(pid);
+		if (cachedProcess != previousSession.processes.constEnd() &&
+			cachedProcess->startTime == process.startTime &&
+			cachedProcess->executionId == process.executionId)
+		{
+			process = *cachedProcess;
+		}
+		else
+		{
+			process.readable = readEnvironment(pid, process.environment);
+			++m_environmentReadCount;
+		}
+
+		session.processes[pid] = process;
+
+		// do not descend into processes we're not allowed to inspect
+		if (process.readable)
+		{
+			pendingPids.append(childProcesses(pid, parentMap, parentMapLoaded));
+		}
+	}
+
+	session.environment = hasSameProcesses(session, previousSession) ? previousSession.environment
+																	 : mergeEnvironments(session);
+
+	return session;
+}
+
+
+
+bool LinuxSessionEnvironmentCache::hasSameProcesses(const Session& a, const Session& b)
+{
+	if (a.processes.size() != b.processes.size())
+	{
+		return false;
+	}
+
+	for (auto it = a.processes.constBegin(), end = a.processes.constEnd(); it != end; ++it)
+	{
+		const auto other = b.processes.constFind(it.key());
+		if (other == b.processes.constEnd() ||
+			other->startTime != it->startTime ||
+			other->executionId != it->executionId)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+QProcessEnvironment LinuxSessionEnvironmentCache::mergeEnvironments(const Session& session)
+{
+	// merge in order of process IDs so variables of newer processes usually take precedence
+	auto pids = session.processes.keys();
+	std::sort(pids.begin(), pids.end());
+
+	QProcessEnvironment environment;
+
+	for (const auto pid : std::as_const(pids))
+	{
+		const auto& process = session.processes[pid];
+		if (process.readable)
+		{
+			environment.insert(process.environment);
+		}
+	}
+
+	return environment;
+}
+
+
+
+void LinuxSessionEnvironmentCache::removeStaleSessions()
+{
+	for (auto it = m_sessions.begin(); it != m_sessions.end(); )
+	{
+		qint64 leaderStartTime = -1;
+		if (readStat(it.key(), &leaderStartTime) == false || leaderStartTime != it->leaderStartTime)
+		{
+			it = m_sessions.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+
+QList<int> LinuxSessionEnvironmentCache::childProcesses(int pid, ParentMap& parentMap, bool& parentMapLoaded) const
+{
+	const auto taskPath = processPath(pid) + QStringLiteral("/task");
+
+	// children files are not available if the kernel has been built without CONFIG_PROC_CHILDREN
+	if (parentMapLoaded == false &&
+		QFileInfo::exists(QStringLiteral("%1/%2/children").arg(taskPath).arg(pid)))
+	{
+		QList<int> children;
+
+		// each thread of a process has its own list of children
+		const auto tids = QDir(taskPath).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+		for (const auto& tid : tids)
+		{
+			QFile childrenFile(taskPath + QLatin1Char('/') + tid + QStringLiteral("/children"));
+			if (childrenFile.open(QFile::ReadOnly) == false)
+			{
+				continue;
+			}
+
+			const auto childPids = childrenFile.readAll().split(' ');
+			for (const auto& childPid : childPids)
+			{
+				bool ok = false;
+				const auto child = childPid.trimmed().toInt(&ok);
+				if (ok && child > 0)
+				{
+					children.append(child);
+				}
+			}
+		}
+
+		return children;
+	}
+
+	if (parentMapLoaded == false)
+	{
+		parentMap = readParentMap();
+		parentMapLoaded = true;
+	}
+
+	return parentMap.values(pid);
+}
+
+
+
+LinuxSessionEnvironmentCache::ParentMap LinuxSessionEnvironmentCache::readParentMap() const
+{
+	ParentMap parentMap;
+
+	// only the stat files are read which is still much cheaper than reading all environ files
+	const auto entries = QDir(m_procPath).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	for (const auto& entry : entries)
+	{
+		bool ok = false;
+		const auto pid = entry.toInt(&ok);
+		int parentPid = -1;
+		qint64 startTime = -1;
+		if (ok && readStat(pid, &startTime, &parentPid))
+		{
+			parentMap.insert(parentPid, pid);
+		}
+	}
+
+	return parentMap;
+}
+
+
+
+bool LinuxSessionEnvironmentCache::readStat(int pid, qint64* startTime, int* parentPid, QByteArray* executionId) const
+{
+	// fields after the command name (which may contain spaces and parentheses), see proc(5)
+	static constexpr auto ParentPidFieldIndex = 1;
+	static constexpr auto StartTimeFieldIndex = 19;
+	static constexpr auto EnvironmentStartFieldIndex = 47;
+	static constexpr auto EnvironmentEndFieldIndex = 48;
+
+	QFile statFile(processPath(pid) + QStringLiteral("/stat"));
+	if (statFile.open(QFile::ReadOnly) == false)
+	{
+		return false;
+	}
+
+	const auto stat = statFile.readAll();
+	const auto commandEnd = stat.lastIndexOf(')');
+	if (commandEnd < 0)
+	{
+		return false;
+	}
+
+	const auto fields = stat.mid(commandEnd + 2).split(' ');
+	if (fields.size() <= StartTimeFieldIndex)
+	{
+		return false;
+	}
+
+	bool ok = false;
+	*startTime = fields[StartTimeFieldIndex].toLongLong(&ok);
+
+	if (parentPid)
+	{
+		*parentPid = fields[ParentPidFieldIndex].toInt();
+	}
+
+	if (executionId)
+	{
+		// exec() sets up a new stack so the command name and (due to address space layout
+		// randomization) the location of the environment change - the latter is only
+		// provided for processes whose environment we're allowed to read (Linux >= 3.5)
+		const auto commandStart = stat.indexOf('(');
+		*executionId = stat.mid(commandStart + 1, commandEnd - commandStart - 1) + ' ' +
+					   fields.value(EnvironmentStartFieldIndex) + '-' + fields.value(EnvironmentEndFieldIndex);
+	}
+
+	return ok;
+}
+
+
+
+bool LinuxSessionEnvironmentCache::readEnvironment(int pid, QProcessEnvironment& environment) const
+{
+	QFile environFile(processPath(pid) + QStringLiteral("/environ"));
+	if (environFile.open(QFile::ReadOnly) == false)
+	{
+		return false;
+	}
+
+	const auto variables = environFile.readAll().split('\0');
+	for (const auto& variable : variables)
+	{
+		const auto env = QString::fromUtf8(variable);
+		const auto separatorPos = env.indexOf(QLatin1Char('='));
+		if (separatorPos > 0)
+		{
+			environment.insert(env.left(separatorPos), env.mid(separatorPos+1));
+		}
+	}
+
+	return true;
+}
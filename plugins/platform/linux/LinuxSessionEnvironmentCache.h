@@ -0,0 +1,102 @@
+/*
+ * LinuxSessionEnvironmentCache.h - declaration of LinuxSessionEnvironmentCache class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QProcessEnvironment>
+
+#include <atomic>
+
+// determines the environment of a session by merging the environments of all processes below
+// the session leader - only the process subtree of the session is walked (via the children
+// files of the tasks) and the environment of a process is read again only if it has been
+// replaced by exec(); lookups are thread-safe and may run outside the main thread
+class LinuxSessionEnvironmentCache
+{
+public:
+	explicit LinuxSessionEnvironmentCache(const QString& procPath = defaultProcPath());
+
+	static LinuxSessionEnvironmentCache* instance();
+
+	QProcessEnvironment environment(int sessionLeaderPid);
+
+	void clear();
+
+	// total number of environ files read so far
+	qint64 environmentReadCount() const
+	{
+		return m_environmentReadCount;
+	}
+
+	static QString defaultProcPath()
+	{
+		return QStringLiteral("/proc");
+	}
+
+private:
+	struct Process
+	{
+		qint64 startTime{-1};
+		// changes with every exec() which keeps PID and start time but replaces the environment
+		QByteArray executionId;
+		bool readable{false};
+		QProcessEnvironment environment;
+	};
+
+	struct Session
+	{
+		qint64 leaderStartTime{-1};
+		QHash<int, Process> processes;
+		QProcessEnvironment environment;
+	};
+
+	using ParentMap = QMultiHash<int, int>;
+
+	Session update(int sessionLeaderPid, qint64 leaderStartTime, const Session& previousSession);
+	static bool hasSameProcesses(const Session& a, const Session& b);
+	static QProcessEnvironment mergeEnvironments(const Session& session);
+
+	void removeStaleSessions();
+
+	QList<int> childProcesses(int pid, ParentMap& parentMap, bool& parentMapLoaded) const;
+	ParentMap readParentMap() const;
+
+	bool readStat(int pid, qint64* startTime, int* parentPid = nullptr, QByteArray* executionId = nullptr) const;
+	bool readEnvironment(int pid, QProcessEnvironment& environment) const;
+
+	QString processPath(int pid) const
+	{
+		return m_procPath + QLatin1Char('/') + QString::number(pid);
+	}
+
+	const QString m_procPath;
+
+	QMutex m_sessionsMutex;
+	QHash<int, Session> m_sessions;
+
+	std::atomic<qint64> m_environmentReadCount{0};
+
+};
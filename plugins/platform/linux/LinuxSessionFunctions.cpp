@@ -29,12 +29,10 @@
 #include <QProcessEnvironment>
 #include <QSettings>
 
-#ifdef HAVE_LIBPROCPS
-#include <proc/readproc.h>
-#endif
-
 #include "LinuxCoreFunctions.h"
+#include "LinuxSessionEnvironmentCache.h"
 #include "LinuxSessionFunctions.h"
+#include "LinuxSessionPropertyCache.h"
 #include "PlatformSessionManager.h"
 
 
@@ -126,6 +124,24 @@ QVariant LinuxSessionFunctions::querySettingsValueInCurrentSession(const QString
 
 
 
+LinuxSessionFunctions::SessionInfo LinuxSessionFunctions::querySessionInfo(const QProcessEnvironment& sessionEnvironment) const
+{
+	const auto sessionPath = sessionEnvironment.value(sessionPathEnvVarName());
+	if (sessionPath.isEmpty())
+	{
+		return PlatformSessionFunctions::querySessionInfo(sessionEnvironment);
+	}
+
+	SessionInfo sessionInfo;
+	sessionInfo.uptime = getSessionUptimeSeconds(sessionPath);
+	sessionInfo.clientAddress = getSessionProperty(sessionPath, QStringLiteral("RemoteHost")).toString();
+	sessionInfo.clientName = sessionInfo.clientAddress;
+	sessionInfo.hostName = QHostInfo::localHostName();
+	return sessionInfo;
+}
+
+
+
 QStringList LinuxSessionFunctions::listSessions()
 {
 	QStringList sessions;
@@ -159,33 +175,7 @@ QStringList LinuxSessionFunctions::listSessions()
 
 QVariant LinuxSessionFunctions::getSessionProperty(const QString& session, const QString& property, bool logErrors)
 {
-	QDBusInterface loginManager( QStringLiteral("org.freedesktop.login1"),
-								 session,
-								 QStringLiteral("org.freedesktop.DBus.Properties"),
-								 QDBusConnection::systemBus() );
-
-	if (loginManager.connection().isConnected() == false)
-	{
-		vDebug() << "system bus not connected";
-		return {};
-	}
-
-	const QDBusReply<QDBusVariant> reply = loginManager.call( QStringLiteral("Get"),
-															  QStringLiteral("org.freedesktop.login1.Session"),
-															  property );
-
-	if( reply.isValid() == false )
-	{
-		if (logErrors)
-		{
-			vCritical() << "Could not query property" << property
-						<< "of session" << session
-						<< "error:" << reply.error().message();
-		}
-		return {};
-	}
-
-	return reply.value().variant();
+	return LinuxSessionPropertyCache::instance()->value(session, property, logErrors);
 }
 
 
@@ -293,18 +283,11 @@ QString LinuxSessionFunctions::getSessionId(const QString& session, bool logErro
 
 QString LinuxSessionFunctions::getSessionUser(const QString& session)
 {
-	quint32 uid{0};
-	QString userObjectPath;
-
-	const auto reply = getSessionProperty(session, QStringLiteral("User"));
-	if (reply.isValid())
+	// structure (uo) with UID and user object path
+	const auto user = getSessionProperty(session, QStringLiteral("User")).toList();
+	if (user.size() >= 2)
 	{
-		const auto replyData = reply.value<QDBusArgument>();
-		replyData.beginStructure();
-		replyData >> uid >> userObjectPath;
-		replyData.endStructure();
-
-		return userObjectPath;
+		return user.at(1).value<QDBusObjectPath>().path();
 	}
 
 	return {};
@@ -337,13 +320,15 @@ LinuxSessionFunctions::State LinuxSessionFunctions::getSessionState( const QStri
 
 LinuxSessionFunctions::LoginDBusSessionSeat LinuxSessionFunctions::getSessionSeat( const QString& session )
 {
-	const auto seatArgument = getSessionProperty( session, QStringLiteral("Seat") ).value<QDBusArgument>();
+	// structure (so) with seat ID and seat object path
+	const auto seatFields = getSessionProperty( session, QStringLiteral("Seat") ).toList();
 
 	LoginDBusSessionSeat seat;
-	seatArgument.beginStructure();
-	seatArgument >> seat.id;
-	seatArgument >> seat.path;
-	seatArgument.endStructure();
+	if( seatFields.size() >= 2 )
+	{
+		seat.id = seatFields.at(0).toString();
+		seat.path = seatFields.at(1).value<QDBusObjectPath>().path();
+	}
 
 	return seat;
 }
@@ -352,56 +337,7 @@ LinuxSessionFunctions::LoginDBusSessionSeat LinuxSessionFunctions::getSessionSea
 
 QProcessEnvironment LinuxSessionFunctions::getSessionEnvironment( int sessionLeaderPid )
 {
-	QProcessEnvironment sessionEnv;
-
-#ifdef HAVE_LIBPROCPS
-	LinuxCoreFunctions::forEachChildProcess(
-		[&sessionEnv]( proc_t* procInfo ) {
-			if( procInfo->environ != nullptr )
-			{
-				for( int i = 0; procInfo->environ[i]; ++i )
-				{
-					const auto env = QString::fromUtf8( procInfo->environ[i] );
-					const auto separatorPos = env.indexOf( QLatin1Char('=') );
-					if( separatorPos > 0 )
-					{
-						sessionEnv.insert( env.left( separatorPos ), env.mid( separatorPos+1 ) );
-					}
-				}
-
-				return true;
-			}
-
-			return false;
-		},
-		sessionLeaderPid, PROC_FILLENV, true );
-#elif defined(HAVE_LIBPROC2)
-	LinuxCoreFunctions::forEachChildProcess([&sessionEnv](const pids_stack* stack)
-	{
-		static constexpr auto EnvironItemIndex = 2;
-		const auto environ = PIDS_VAL(EnvironItemIndex, strv, stack);
-
-		if (environ != nullptr)
-		{
-			for (int i = 0; environ[i]; ++i)
-			{
-				const auto env = QString::fromUtf8(environ[i]);
-				const auto separatorPos = env.indexOf(QLatin1Char('='));
-				if (separatorPos > 0)
-				{
-					sessionEnv.insert(env.left(separatorPos), env.mid(separatorPos+1));
-				}
-			}
-
-			return true;
-		}
-
-		return false;
-	},
-	sessionLeaderPid, {PIDS_ENVIRON_V}, true);
-#endif
-
-	return sessionEnv;
+	return LinuxSessionEnvironmentCache::instance()->environment( sessionLeaderPid );
 }
 
 
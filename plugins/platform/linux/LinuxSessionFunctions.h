@@ -92,6 +92,8 @@ public:
 	EnvironmentVariables currentSessionEnvironmentVariables() const override;
 	QVariant querySettingsValueInCurrentSession(const QString& key) const override;
 
+	SessionInfo querySessionInfo(const QProcessEnvironment& sessionEnvironment) const override;
+
 	static QStringList listSessions();
 
 	static QVariant getSessionProperty(const QString& session, const QString& property, bool logErrors = true);
@@ -0,0 +1,266 @@
+/*
+ * LinuxSessionPropertyCache.cpp - implementation of LinuxSessionPropertyCache class
+ *
+ * Copyright (c) 2017-2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusReply>
+
+#include "LinuxSessionPropertyCache.h"
+#include "VeyonCore.h"
+
+
+LinuxSessionPropertyCache::LinuxSessionPropertyCache(QObject* parent) :
+	QObject(parent)
+{
+	// make sure D-Bus signals are delivered through the main event loop regardless
+	// of which thread triggered the creation of the cache
+	if (QCoreApplication::instance())
+	{
+		moveToThread(QCoreApplication::instance()->thread());
+	}
+
+	connectToLoginManager();
+}
+
+
+
+LinuxSessionPropertyCache* LinuxSessionPropertyCache::instance()
+{
+	static auto cache = new LinuxSessionPropertyCache;
+
+	return cache;
+}
+
+
+
+QVariant LinuxSessionPropertyCache::value(const QString& session, const QString& property, bool logErrors)
+{
+	auto snapshot = std::atomic_load(&m_snapshot);
+	auto entry = snapshot->constFind(session);
+
+	if (entry == snapshot->constEnd() ||
+		(isPolledProperty(property) && entry->age.hasExpired(PolledPropertyMaximumAge)))
+	{
+		if (fetch(session, logErrors) == false)
+		{
+			return {};
+		}
+
+		snapshot = std::atomic_load(&m_snapshot);
+		entry = snapshot->constFind(session);
+		if (entry == snapshot->constEnd())
+		{
+			return {};
+		}
+	}
+
+	const auto value = entry->properties.value(property);
+	if (value.isNull() && logErrors)
+	{
+		vDebug() << "session" << session << "does not provide property" << property;
+	}
+
+	return value;
+}
+
+
+
+void LinuxSessionPropertyCache::invalidate(const QString& session)
+{
+	update([&session](Snapshot& snapshot) {
+		snapshot.remove(session);
+	});
+}
+
+
+
+void LinuxSessionPropertyCache::handlePropertiesChanged(const QString& interface, const QVariantMap& changedProperties,
+														const QStringList& invalidatedProperties, const QDBusMessage& message)
+{
+	if (interface != sessionInterface())
+	{
+		return;
+	}
+
+	const auto session = message.path();
+	const auto properties = normalizeProperties(changedProperties);
+
+	update([&](Snapshot& snapshot) {
+		const auto entry = snapshot.find(session);
+		if (entry == snapshot.end())
+		{
+			// session not cached yet - the next lookup will fetch all properties anyway
+			return;
+		}
+
+		if (invalidatedProperties.isEmpty() == false)
+		{
+			// login1 does not send new values for invalidated properties so refetch all of them on next lookup
+			snapshot.erase(entry);
+			return;
+		}
+
+		for (auto it = properties.constBegin(), end = properties.constEnd(); it != end; ++it)
+		{
+			entry->properties[it.key()] = it.value();
+		}
+	});
+
+	Q_EMIT sessionPropertiesChanged(session, changedProperties.keys() + invalidatedProperties);
+}
+
+
+
+void LinuxSessionPropertyCache::handleSessionRemoved(const QString& login1SessionId,
+													 const QDBusObjectPath& sessionObjectPath)
+{
+	Q_UNUSED(login1SessionId)
+
+	invalidate(sessionObjectPath.path());
+}
+
+
+
+void LinuxSessionPropertyCache::connectToLoginManager()
+{
+	const auto service = QStringLiteral("org.freedesktop.login1");
+
+	auto bus = QDBusConnection::systemBus();
+
+	bool success = bus.isConnected();
+
+	// subscribe to property changes of all login1 objects with a single match rule
+	success &= bus.connect(service, {}, QStringLiteral("org.freedesktop.DBus.Properties"),
+						   QStringLiteral("PropertiesChanged"), this,
+						   SLOT(handlePropertiesChanged(QString,QVariantMap,QStringList,QDBusMessage)));
+
+	success &= bus.connect(service, QStringLiteral("/org/freedesktop/login1"),
+						   QStringLiteral("org.freedesktop.login1.Manager"),
+						   QStringLiteral("SessionRemoved"), this,
+						   SLOT(handleSessionRemoved(QString,QDBusObjectPath)));
+
+	if (success == false)
+	{
+		vWarning() << "could not subscribe to login manager signals - all session properties will be polled";
+	}
+
+	m_connectedToLoginManager = success;
+}
+
+
+
+bool LinuxSessionPropertyCache::fetch(const QString& session, bool logErrors)
+{
+	auto bus = QDBusConnection::systemBus();
+	if (bus.isConnected() == false)
+	{
+		vDebug() << "system bus not connected";
+		return false;
+	}
+
+	auto message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.login1"), session,
+												  QStringLiteral("org.freedesktop.DBus.Properties"),
+												  QStringLiteral("GetAll"));
+	message << sessionInterface();
+
+	const QDBusReply<QVariantMap> reply = bus.call(message);
+	if (reply.isValid() == false)
+	{
+		if (logErrors)
+		{
+			vCritical() << "Could not query properties of session" << session
+						<< "error:" << reply.error().message();
+		}
+
+		invalidate(session);
+
+		return false;
+	}
+
+	const auto properties = normalizeProperties(reply.value());
+
+	update([&](Snapshot& snapshot) {
+		auto& entry = snapshot[session];
+		entry.properties = properties;
+		entry.age.start();
+	});
+
+	return true;
+}
+
+
+
+void LinuxSessionPropertyCache::update(const std::function<void(Snapshot&)>& modify)
+{
+	QMutexLocker locker(&m_updateMutex);
+
+	// copy-on-write so that readers can keep using the previous snapshot while it is being replaced
+	auto snapshot = std::make_shared<Snapshot>(*std::atomic_load(&m_snapshot));
+	modify(*snapshot);
+
+	std::atomic_store(&m_snapshot, SnapshotPointer(std::move(snapshot)));
+}
+
+
+
+bool LinuxSessionPropertyCache::isPolledProperty(const QString& property) const
+{
+	return m_connectedToLoginManager == false ||
+		   property == QLatin1String("State");
+}
+
+
+
+QVariantMap LinuxSessionPropertyCache::normalizeProperties(const QVariantMap& properties)
+{
+	QVariantMap normalizedProperties;
+
+	for (auto it = properties.constBegin(), end = properties.constEnd(); it != end; ++it)
+	{
+		auto value = it.value();
+
+		// decode structures such as "User" or "Seat" into plain lists so that cached values
+		// do not reference the originating D-Bus message and can be read from any thread
+		if (value.userType() == qMetaTypeId<QDBusArgument>())
+		{
+			const auto argument = value.value<QDBusArgument>();
+			if (argument.currentType() == QDBusArgument::StructureType)
+			{
+				QVariantList fields;
+				argument.beginStructure();
+				while (argument.atEnd() == false)
+				{
+					fields.append(argument.asVariant());
+				}
+				argument.endStructure();
+				value = fields;
+			}
+		}
+
+		normalizedProperties[it.key()] = value;
+	}
+
+	return normalizedProperties;
+}
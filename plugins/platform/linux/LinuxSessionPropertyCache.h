@@ -0,0 +1,95 @@
+/*
+ * LinuxSessionPropertyCache.h - declaration of LinuxSessionPropertyCache class
+ *
+ * Copyright (c) 2017-2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QVariantMap>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// caches the properties of login1 sessions which are fetched with a single GetAll call
+// and kept up to date via PropertiesChanged signals - lookups do not block on the system bus
+// and do not wait for concurrent updates as long as the requested session has been cached
+// already (note that the atomic shared_ptr accessors are not lock-free with libstdc++
+// but only hold an internal lock while copying the pointer)
+class LinuxSessionPropertyCache : public QObject
+{
+	Q_OBJECT
+public:
+	static LinuxSessionPropertyCache* instance();
+
+	QVariant value(const QString& session, const QString& property, bool logErrors = true);
+
+	void invalidate(const QString& session);
+
+Q_SIGNALS:
+	void sessionPropertiesChanged(const QString& session, const QStringList& properties);
+
+private Q_SLOTS:
+	void handlePropertiesChanged(const QString& interface, const QVariantMap& changedProperties,
+								 const QStringList& invalidatedProperties, const QDBusMessage& message);
+	void handleSessionRemoved(const QString& login1SessionId, const QDBusObjectPath& sessionObjectPath);
+
+private:
+	// login1 does not emit PropertiesChanged signals for some properties (e.g. "State")
+	// so these are refetched once the cached value is older than this interval
+	static constexpr auto PolledPropertyMaximumAge = 1000;
+
+	struct Entry
+	{
+		QVariantMap properties;
+		QElapsedTimer age;
+	};
+
+	using Snapshot = QHash<QString, Entry>;
+	using SnapshotPointer = std::shared_ptr<const Snapshot>;
+
+	explicit LinuxSessionPropertyCache(QObject* parent = nullptr);
+
+	void connectToLoginManager();
+
+	bool fetch(const QString& session, bool logErrors);
+	void update(const std::function<void(Snapshot&)>& modify);
+
+	bool isPolledProperty(const QString& property) const;
+	static QVariantMap normalizeProperties(const QVariantMap& properties);
+
+	static QString sessionInterface()
+	{
+		return QStringLiteral("org.freedesktop.login1.Session");
+	}
+
+	SnapshotPointer m_snapshot{std::make_shared<const Snapshot>()};
+	QMutex m_updateMutex;
+
+	std::atomic_bool m_connectedToLoginManager{false};
+
+};
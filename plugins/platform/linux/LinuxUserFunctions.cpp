@@ -29,6 +29,7 @@
 
 #include "LinuxCoreFunctions.h"
 #include "LinuxDesktopIntegration.h"
+#include "LinuxGroupDatabase.h"
 #include "LinuxKeyboardInput.h"
 #include "LinuxPlatformConfiguration.h"
 #include "LinuxSessionFunctions.h"
@@ -72,20 +73,7 @@ QStringList LinuxUserFunctions::userGroups( bool queryDomainGroups )
 {
 	Q_UNUSED(queryDomainGroups)
 
-	QStringList groupList;
-
-	QProcess getentProcess;
-	getentProcess.start( QStringLiteral("getent"), { QStringLiteral("group") } );
-	getentProcess.waitForFinished();
-
-	const auto groups = QString::fromUtf8( getentProcess.readAll() ).split( QLatin1Char('\n') );
-
-	groupList.reserve( groups.size() );
-
-	for( const auto& group : groups )
-	{
-		groupList += group.split( QLatin1Char(':') ).first();
-	}
+	auto groupList = LinuxGroupDatabase::instance().groupNames();
 
 	const QStringList ignoredGroups( {
 		QStringLiteral("daemon"),
@@ -178,26 +166,7 @@ QStringList LinuxUserFunctions::groupsOfUser( const QString& username, bool quer
 {
 	Q_UNUSED(queryDomainGroups)
 
-	QStringList groupList;
-
-	QProcess getentProcess;
-	getentProcess.start( QStringLiteral("getent"), { QStringLiteral("group") } );
-	getentProcess.waitForFinished();
-
-	const auto groups = QString::fromUtf8( getentProcess.readAll() ).split( QLatin1Char('\n') );
-	for( const auto& group : groups )
-	{
-		const auto groupComponents = group.split( QLatin1Char(':') );
-		if( groupComponents.size() == 4 &&
-			groupComponents.last().split( QLatin1Char(',') ).contains(username))
-		{
-			groupList += groupComponents.first(); // clazy:exclude=reserve-candidates
-		}
-	}
-
-	groupList.removeAll( QString() );
-
-	return groupList;
+	return LinuxGroupDatabase::instance().groupsOfUser( username );
 }
 
 
@@ -0,0 +1,37 @@
+/*
+ * PowerControlConfiguration.h - configuration values for PowerControl plugin
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "VeyonConfiguration.h"
+#include "Configuration/Proxy.h"
+
+#define FOREACH_POWER_CONTROL_CONFIG_PROPERTY(OP) \
+	OP( PowerControlConfiguration, m_configuration, int, wakeOnLanBatchSize, setWakeOnLanBatchSize, "WakeOnLanBatchSize", "PowerControl", 10, Configuration::Property::Flag::Advanced )	\
+	OP( PowerControlConfiguration, m_configuration, int, wakeOnLanBatchInterval, setWakeOnLanBatchInterval, "WakeOnLanBatchInterval", "PowerControl", 1000, Configuration::Property::Flag::Advanced )	\
+	OP( PowerControlConfiguration, m_configuration, int, wakeOnLanRetryInterval, setWakeOnLanRetryInterval, "WakeOnLanRetryInterval", "PowerControl", 30000, Configuration::Property::Flag::Advanced )	\
+	OP( PowerControlConfiguration, m_configuration, int, wakeOnLanMaximumAttempts, setWakeOnLanMaximumAttempts, "WakeOnLanMaximumAttempts", "PowerControl", 3, Configuration::Property::Flag::Advanced )	\
+	OP( PowerControlConfiguration, m_configuration, int, wakeOnLanBootTimeout, setWakeOnLanBootTimeout, "WakeOnLanBootTimeout", "PowerControl", 300000, Configuration::Property::Flag::Advanced )	\
+
+DECLARE_CONFIG_PROXY(PowerControlConfiguration, FOREACH_POWER_CONTROL_CONFIG_PROPERTY)
@@ -22,10 +22,8 @@
  *
  */
 
-#include <QtConcurrent>
 #include <QEvent>
 #include <QMessageBox>
-#include <QNetworkInterface>
 #include <QProgressBar>
 #include <QProgressDialog>
 #include <QUdpSocket>
@@ -33,14 +31,15 @@
 #include "Computer.h"
 #include "ComputerControlInterface.h"
 #include "FeatureWorkerManager.h"
-#include "NetworkObjectDirectoryManager.h"
 #include "PlatformCoreFunctions.h"
 #include "PlatformUserFunctions.h"
+#include "PowerControlConfiguration.h"
 #include "PowerControlFeaturePlugin.h"
 #include "PowerDownTimeInputDialog.h"
 #include "VeyonConfiguration.h"
 #include "VeyonMasterInterface.h"
 #include "VeyonServerInterface.h"
+#include "WakeOnLanScheduler.h"
 
 
 PowerControlFeaturePlugin::PowerControlFeaturePlugin( QObject* parent ) :
@@ -131,35 +130,7 @@ bool PowerControlFeaturePlugin::controlFeature( Feature::Uid featureUid,
 
 	if( featureUid == m_powerOnFeature.uid() )
 	{
-		QList<Computer> hosts;
-		hosts.reserve(computerControlInterfaces.size());
-		for (const auto& controlInterface : computerControlInterfaces)
-		{
-			hosts.append(controlInterface->computer());
-		}
-
-		(void) QtConcurrent::run([hosts]() {
-			const auto directory = VeyonCore::networkObjectDirectoryManager().configuredDirectory();
-
-			for (const auto& host : hosts)
-			{
-				auto macAddress = host.macAddress();
-				if (macAddress.isEmpty())
-				{
-					macAddress = directory->queryObjectAttribute(host.networkObjectUid(),
-																 NetworkObject::Attribute::MacAddress).toString();
-				}
-
-				if (macAddress.isEmpty() == false)
-				{
-					broadcastWOLPacket(macAddress);
-				}
-				else
-				{
-					vWarning() << "no MAC address available for host" << host.hostName() << "with ID" << host.networkObjectUid();
-				}
-			}
-		});
+		powerOn( computerControlInterfaces );
 	}
 	else if( featureUid == m_powerDownDelayedFeature.uid() )
 	{
@@ -184,7 +155,29 @@ bool PowerControlFeaturePlugin::startFeature( VeyonMasterInterface& master, cons
 {
 	if( feature == m_powerOnFeature )
 	{
-		return controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces );
+		auto scheduler = powerOn( computerControlInterfaces );
+
+		auto progressDialog = new QProgressDialog( master.mainWindow() );
+		progressDialog->setAttribute( Qt::WA_DeleteOnClose );
+		progressDialog->setWindowTitle( feature.displayName() );
+		progressDialog->setAutoClose( false );
+		progressDialog->setAutoReset( false );
+		progressDialog->setMinimumDuration( 0 );
+		progressDialog->setRange( 0, computerControlInterfaces.size() );
+		progressDialog->setValue( 0 );
+		progressDialog->setLabelText( tr( "Powering on computers..." ) );
+
+		connect( scheduler, &WakeOnLanScheduler::progressChanged, progressDialog, [=]( int reachableCount, int hostCount ) {
+			progressDialog->setMaximum( hostCount );
+			progressDialog->setValue( reachableCount );
+			progressDialog->setLabelText( tr( "%1 of %2 computers have been powered on." ).arg( reachableCount ).arg( hostCount ) );
+		} );
+		connect( scheduler, &WakeOnLanScheduler::finished, progressDialog, &QProgressDialog::close );
+		connect( progressDialog, &QProgressDialog::canceled, scheduler, &WakeOnLanScheduler::cancel );
+
+		progressDialog->show();
+
+		return true;
 	}
 
 	if( feature == m_powerDownDelayedFeature )
@@ -360,59 +353,37 @@ bool PowerControlFeaturePlugin::confirmFeatureExecution( const Feature& feature,
 
 
 
-bool PowerControlFeaturePlugin::broadcastWOLPacket( QString macAddress )
+WakeOnLanScheduler* PowerControlFeaturePlugin::powerOn( const ComputerControlInterfaceList& computerControlInterfaces )
 {
-	if (macAddress.isEmpty())
-	{
-		return false;
-	}
+	auto scheduler = new WakeOnLanScheduler( this );
+	scheduler->start( computerControlInterfaces );
 
-	const auto originalMacAddress = macAddress;
+	return scheduler;
+}
 
-	// remove all possible delimiters
-	macAddress.replace( QLatin1Char(':'), QString() );
-	macAddress.replace( QLatin1Char('-'), QString() );
-	macAddress.replace( QLatin1Char('.'), QString() );
 
-	const auto macAddressBytes = QByteArray::fromHex(macAddress.toUtf8());
-	static constexpr auto MacAddressSize = 6;
 
-	if (macAddressBytes.size() != MacAddressSize)
+bool PowerControlFeaturePlugin::broadcastWOLPacket( const QString& macAddress )
+{
+	if (macAddress.isEmpty())
 	{
-		CommandLineIO::error( tr( "Invalid MAC address specified!" ) );
-		vWarning() << "invalid MAC address" << originalMacAddress;
 		return false;
 	}
 
-	static constexpr auto MagicPacketFieldCount = 17;
-
-	QByteArray datagram(MacAddressSize * MagicPacketFieldCount, char(0xff));
-
-	for (int i = 1; i < MagicPacketFieldCount; ++i)
+	const auto packet = WakeOnLanScheduler::magicPacket( macAddress );
+	if( packet.isEmpty() )
 	{
-		datagram.replace(i * MacAddressSize, MacAddressSize, macAddressBytes);
+		CommandLineIO::error( tr( "Invalid MAC address specified!" ) );
+		return false;
 	}
 
-	QUdpSocket udpSocket;
+	const auto addresses = WakeOnLanScheduler::broadcastAddresses();
 
-	vDebug() << "broadcasting WOL packet for" << originalMacAddress;
-	bool success = ( udpSocket.writeDatagram( datagram, QHostAddress::Broadcast, 9 ) == datagram.size() );
+	vDebug() << "broadcasting WOL packet for" << macAddress << "via" << addresses;
 
-	const auto networkInterfaces = QNetworkInterface::allInterfaces();
-	for( const auto& networkInterface : networkInterfaces )
-	{
-		const auto addressEntries = networkInterface.addressEntries();
-		for( const auto& addressEntry : addressEntries )
-		{
-			if( addressEntry.broadcast().isNull() == false )
-			{
-				vDebug() << "broadcasting WOL packet for" << originalMacAddress << "via" << addressEntry.broadcast().toString();
-				success &= ( udpSocket.writeDatagram( datagram, addressEntry.broadcast(), 9 ) == datagram.size() );
-			}
-		}
-	}
+	QUdpSocket udpSocket;
 
-	return success;
+	return WakeOnLanScheduler::sendPackets( udpSocket, { packet }, addresses );
 }
 
 
@@ -484,3 +455,6 @@ void PowerControlFeaturePlugin::displayShutdownTimeout( int shutdownTimeout )
 
 	VeyonCore::platform().coreFunctions().powerDown(false);
 }
+
+
+IMPLEMENT_CONFIG_PROXY(PowerControlConfiguration)
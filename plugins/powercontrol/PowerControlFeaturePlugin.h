@@ -29,6 +29,8 @@
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
+class WakeOnLanScheduler;
+
 class PowerControlFeaturePlugin : public QObject,
 		PluginInterface,
 		CommandLineIO,
@@ -114,7 +116,8 @@ protected:
 
 private:
 	bool confirmFeatureExecution( const Feature& feature, bool all, QWidget* parent );
-	static bool broadcastWOLPacket( QString macAddress );
+	WakeOnLanScheduler* powerOn( const ComputerControlInterfaceList& computerControlInterfaces );
+	static bool broadcastWOLPacket( const QString& macAddress );
 
 	void confirmShutdown();
 	void displayShutdownTimeout( int shutdownTimeout );
@@ -0,0 +1,504 @@
+/*
+ * WakeOnLanScheduler.cpp - implementation of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QFutureWatcher>
+#include <QNetworkInterface>
+#include <QtConcurrent>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "NetworkObjectDirectoryManager.h"
+#include "PowerControlConfiguration.h"
+#include "WakeOnLanScheduler.h"
+
+
+WakeOnLanScheduler::WakeOnLanScheduler( QObject* parent ) :
+	QObject( parent )
+{
+	const PowerControlConfiguration configuration( &VeyonCore::config() );
+
+	m_batchSize = qMax( 1, configuration.wakeOnLanBatchSize() );
+	m_batchInterval = qMax( MinimumBatchInterval, configuration.wakeOnLanBatchInterval() );
+	m_retryInterval = qMax( m_batchInterval, configuration.wakeOnLanRetryInterval() );
+	m_maximumAttempts = qMax( 1, configuration.wakeOnLanMaximumAttempts() );
+	m_bootTimeout = qMax( m_retryInterval, configuration.wakeOnLanBootTimeout() );
+
+	connect( &m_sendTimer, &QTimer::timeout, this, &WakeOnLanScheduler::sendBatch );
+}
+
+
+
+void WakeOnLanScheduler::start( const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	QList<Computer> computers;
+	computers.reserve( computerControlInterfaces.size() );
+
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		if( controlInterface.isNull() || m_hostIndices.contains( controlInterface.data() ) )
+		{
+			continue;
+		}
+
+		m_hostIndices[controlInterface.data()] = m_hosts.size();
+		m_hosts.append( Host{ controlInterface } );
+		computers.append( controlInterface->computer() );
+	}
+
+	vInfo() << "powering on" << m_hosts.size() << "computers in batches of" << m_batchSize
+			<< "every" << m_batchInterval << "ms";
+
+	// MAC addresses may have to be queried from a remote directory
+	auto watcher = new QFutureWatcher<Setup>( this );
+	connect( watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+		run( watcher->result() );
+		watcher->deleteLater();
+	} );
+	watcher->setFuture( QtConcurrent::run( [computers]() { return prepare( computers ); } ) );
+}
+
+
+
+void WakeOnLanScheduler::cancel()
+{
+	if( m_finished )
+	{
+		return;
+	}
+
+	vInfo() << "powering on computers canceled";
+
+	finish();
+}
+
+
+
+QList<WakeOnLanScheduler::HostStatistics> WakeOnLanScheduler::hostStatistics() const
+{
+	QList<HostStatistics> statistics;
+	statistics.reserve( m_hosts.size() );
+
+	for( const auto& host : m_hosts )
+	{
+		statistics.append( { host.controlInterface->computer().hostName(), host.attempts, host.bootTime } );
+	}
+
+	return statistics;
+}
+
+
+
+QByteArray WakeOnLanScheduler::magicPacket( const QString& macAddress )
+{
+	static constexpr auto MacAddressSize = 6;
+	static constexpr auto MagicPacketFieldCount = 17;
+
+	auto address = macAddress;
+
+	// remove all possible delimiters
+	address.replace( QLatin1Char(':'), QString() );
+	address.replace( QLatin1Char('-'), QString() );
+	address.replace( QLatin1Char('.'), QString() );
+
+	const auto macAddressBytes = QByteArray::fromHex( address.toUtf8() );
+	if( macAddressBytes.size() != MacAddressSize )
+	{
+		vWarning() << "invalid MAC address" << macAddress;
+		return {};
+	}
+
+	QByteArray packet( MacAddressSize * MagicPacketFieldCount, char(0xff) );
+
+	for( int i = 1; i < MagicPacketFieldCount; ++i )
+	{
+		packet.replace( i * MacAddressSize, MacAddressSize, macAddressBytes );
+	}
+
+	return packet;
+}
+
+
+
+QList<QHostAddress> WakeOnLanScheduler::broadcastAddresses()
+{
+	QList<QHostAddress> addresses{ QHostAddress( QHostAddress::Broadcast ) };
+
+	const auto networkInterfaces = QNetworkInterface::allInterfaces();
+	for( const auto& networkInterface : networkInterfaces )
+	{
+		const auto addressEntries = networkInterface.addressEntries();
+		for( const auto& addressEntry : addressEntries )
+		{
+			const auto broadcast = addressEntry.broadcast();
+			if( broadcast.protocol() == QAbstractSocket::IPv4Protocol && addresses.contains( broadcast ) == false )
+			{
+				addresses.append( broadcast );
+			}
+		}
+	}
+
+	return addresses;
+}
+
+
+
+bool WakeOnLanScheduler::sendPackets( QUdpSocket& socket, const QList<QByteArray>& packets,
+									  const QList<QHostAddress>& addresses )
+{
+	if( socket.state() != QAbstractSocket::BoundState &&
+		socket.bind( QHostAddress( QHostAddress::AnyIPv4 ), 0 ) == false )
+	{
+		vWarning() << "failed to bind socket:" << socket.errorString();
+	}
+
+#ifdef Q_OS_LINUX
+	const auto socketDescriptor = int( socket.socketDescriptor() );
+	if( socketDescriptor >= 0 )
+	{
+		// hand all packets of a batch to the kernel with as few system calls as possible
+		static constexpr auto MaximumMessagesPerCall = 1024;
+
+		const auto messageCount = int( packets.size() * addresses.size() );
+
+		std::vector<sockaddr_in> destinations;
+		std::vector<iovec> vectors;
+		std::vector<mmsghdr> messages;
+		destinations.reserve( size_t(messageCount) );
+		vectors.reserve( size_t(messageCount) );
+		messages.reserve( size_t(messageCount) );
+
+		for( const auto& packet : packets )
+		{
+			for( const auto& address : addresses )
+			{
+				sockaddr_in destination{};
+				destination.sin_family = AF_INET;
+				destination.sin_port = htons( WakeOnLanPort );
+				destination.sin_addr.s_addr = htonl( address.toIPv4Address() );
+				destinations.push_back( destination );
+
+				vectors.push_back( iovec{ const_cast<char *>( packet.constData() ), size_t(packet.size()) } );
+
+				mmsghdr message{};
+				message.msg_hdr.msg_name = &destinations.back();
+				message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+				message.msg_hdr.msg_iov = &vectors.back();
+				message.msg_hdr.msg_iovlen = 1;
+				messages.push_back( message );
+			}
+		}
+
+		int sentCount = 0;
+		while( sentCount < messageCount )
+		{
+			const auto result = ::sendmmsg( socketDescriptor, messages.data() + sentCount,
+											 unsigned( qMin( messageCount - sentCount, MaximumMessagesPerCall ) ), 0 );
+			if( result < 0 && errno == EINTR )
+			{
+				continue;
+			}
+			if( result <= 0 )
+			{
+				vWarning() << "failed to send" << messageCount - sentCount << "WOL packets, error" << errno;
+				return false;
+			}
+
+			sentCount += result;
+		}
+
+		return true;
+	}
+#endif
+
+	bool success = true;
+
+	for( const auto& packet : packets )
+	{
+		for( const auto& address : addresses )
+		{
+			success &= socket.writeDatagram( packet, address, WakeOnLanPort ) == packet.size();
+		}
+	}
+
+	return success;
+}
+
+
+
+WakeOnLanScheduler::Setup WakeOnLanScheduler::prepare( const QList<Computer>& computers )
+{
+	Setup setup;
+	setup.packets.reserve( computers.size() );
+
+	// enumerate network interfaces only once for all computers
+	setup.broadcastAddresses = broadcastAddresses();
+
+	const auto directory = VeyonCore::networkObjectDirectoryManager().configuredDirectory();
+
+	for( const auto& computer : computers )
+	{
+		auto macAddress = computer.macAddress();
+		if( macAddress.isEmpty() )
+		{
+			macAddress = directory->queryObjectAttribute( computer.networkObjectUid(),
+														  NetworkObject::Attribute::MacAddress ).toString();
+		}
+
+		if( macAddress.isEmpty() )
+		{
+			vWarning() << "no MAC address available for host" << computer.hostName()
+					   << "with ID" << computer.networkObjectUid();
+		}
+
+		setup.packets.append( macAddress.isEmpty() ? QByteArray{} : magicPacket( macAddress ) );
+	}
+
+	return setup;
+}
+
+
+
+void WakeOnLanScheduler::run( const Setup& setup )
+{
+	if( m_finished )
+	{
+		return;
+	}
+
+	m_broadcastAddresses = setup.broadcastAddresses;
+
+	for( int i = 0; i < m_hosts.size(); ++i )
+	{
+		auto& host = m_hosts[i];
+		host.packet = setup.packets.value( i );
+
+		connect( host.controlInterface.data(), &ComputerControlInterface::stateChanged, this,
+				 [this, controlInterface = host.controlInterface.data()]() { updateState( controlInterface ); } );
+
+		if( isReachable( host.controlInterface ) )
+		{
+			host.state = HostState::Reachable;
+			++m_reachableCount;
+			++m_resolvedCount;
+		}
+		else if( host.packet.isEmpty() )
+		{
+			host.state = HostState::Failed;
+			++m_resolvedCount;
+		}
+		else
+		{
+			m_queue.enqueue( i );
+		}
+	}
+
+	Q_EMIT progressChanged( m_reachableCount, m_hosts.size() );
+
+	m_sendTimer.start( m_batchInterval );
+	sendBatch();
+}
+
+
+
+void WakeOnLanScheduler::sendBatch()
+{
+	for( auto& host : m_hosts )
+	{
+		if( host.state != HostState::Sent )
+		{
+			continue;
+		}
+
+		if( host.bootTimer.hasExpired( m_bootTimeout ) )
+		{
+			vWarning() << "computer" << host.controlInterface->computer().hostName()
+					   << "has not become reachable after" << host.attempts << "WOL packets";
+			host.state = HostState::Failed;
+			++m_resolvedCount;
+		}
+		else if( host.attempts < m_maximumAttempts && host.sendTimer.hasExpired( m_retryInterval ) )
+		{
+			host.state = HostState::Pending;
+			m_queue.enqueue( m_hostIndices.value( host.controlInterface.data() ) );
+		}
+	}
+
+	QList<int> batch;
+	QList<QByteArray> packets;
+
+	while( m_queue.isEmpty() == false && batch.size() < m_batchSize )
+	{
+		const auto index = m_queue.dequeue();
+		if( m_hosts[index].state == HostState::Pending )
+		{
+			batch.append( index );
+			packets.append( m_hosts[index].packet );
+		}
+	}
+
+	if( batch.isEmpty() == false )
+	{
+		vDebug() << "sending WOL packets for" << batch.size() << "computers via"
+				 << m_broadcastAddresses.size() << "broadcast addresses";
+
+		if( sendPackets( m_socket, packets, m_broadcastAddresses ) == false )
+		{
+			vWarning() << "not all WOL packets could be sent";
+		}
+
+		for( const auto index : std::as_const( batch ) )
+		{
+			auto& host = m_hosts[index];
+			if( host.attempts == 0 )
+			{
+				host.bootTimer.start();
+			}
+			++host.attempts;
+			host.sendTimer.start();
+			host.state = HostState::Sent;
+		}
+	}
+
+	checkFinished();
+}
+
+
+
+void WakeOnLanScheduler::updateState( ComputerControlInterface* controlInterface )
+{
+	const auto it = m_hostIndices.constFind( controlInterface );
+	if( it == m_hostIndices.constEnd() || m_finished )
+	{
+		return;
+	}
+
+	auto& host = m_hosts[*it];
+
+	if( ( host.state == HostState::Pending || host.state == HostState::Sent ) &&
+		isReachable( host.controlInterface ) )
+	{
+		if( host.attempts > 0 )
+		{
+			host.bootTime = host.bootTimer.elapsed();
+		}
+
+		host.state = HostState::Reachable;
+		++m_reachableCount;
+		++m_resolvedCount;
+
+		Q_EMIT progressChanged( m_reachableCount, m_hosts.size() );
+
+		checkFinished();
+	}
+}
+
+
+
+bool WakeOnLanScheduler::isReachable( const ComputerControlInterface::Pointer& controlInterface )
+{
+	// any answer of the computer means that it has been powered on
+	switch( controlInterface->state() )
+	{
+	case ComputerControlInterface::State::ServerNotRunning:
+	case ComputerControlInterface::State::AuthenticationFailed:
+	case ComputerControlInterface::State::AccessControlFailed:
+	case ComputerControlInterface::State::Connected:
+		return true;
+	default:
+		break;
+	}
+
+	return false;
+}
+
+
+
+void WakeOnLanScheduler::checkFinished()
+{
+	if( m_resolvedCount >= m_hosts.size() )
+	{
+		finish();
+	}
+}
+
+
+
+void WakeOnLanScheduler::finish()
+{
+	if( m_finished )
+	{
+		return;
+	}
+
+	m_finished = true;
+	m_sendTimer.stop();
+
+	QVector<qint64> bootTimes;
+	QStringList unreachableHosts;
+
+	for( const auto& host : std::as_const( m_hosts ) )
+	{
+		if( host.bootTime >= 0 )
+		{
+			bootTimes.append( host.bootTime );
+			vDebug() << "computer" << host.controlInterface->computer().hostName() << "became reachable after"
+					 << host.bootTime << "ms and" << host.attempts << "WOL packets";
+		}
+		else if( host.state != HostState::Reachable )
+		{
+			unreachableHosts.append( host.controlInterface->computer().hostName() );
+		}
+	}
+
+	if( unreachableHosts.isEmpty() == false )
+	{
+		vWarning() << "computers not powered on:" << unreachableHosts;
+	}
+
+	if( bootTimes.isEmpty() == false )
+	{
+		std::sort( bootTimes.begin(), bootTimes.end() );
+
+		vInfo() << m_reachableCount << "of" << m_hosts.size() << "computers reachable, boot time min/median/avg/max:"
+				<< bootTimes.first() << bootTimes.value( bootTimes.size() / 2 )
+				<< std::accumulate( bootTimes.constBegin(), bootTimes.constEnd(), qint64(0) ) / bootTimes.size()
+				<< bootTimes.last() << "ms";
+	}
+	else
+	{
+		vInfo() << m_reachableCount << "of" << m_hosts.size() << "computers reachable";
+	}
+
+	Q_EMIT finished();
+
+	deleteLater();
+}
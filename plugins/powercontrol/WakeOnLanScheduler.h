@@ -0,0 +1,133 @@
+/*
+ * WakeOnLanScheduler.h - declaration of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QQueue>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include "ComputerControlInterface.h"
+
+// powers on computers by sending Wake-on-LAN packets in batches with a configurable interval
+// in order to limit the inrush current when powering on many computers at once - packets are
+// sent again until the computer control interface reports the computer to be reachable; the
+// object deletes itself once all computers are reachable or have not booted in time
+class WakeOnLanScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	struct HostStatistics
+	{
+		QString hostName;
+		int attempts{0};
+		qint64 bootTime{-1};
+	};
+
+	explicit WakeOnLanScheduler( QObject* parent = nullptr );
+
+	void start( const ComputerControlInterfaceList& computerControlInterfaces );
+	void cancel();
+
+	int hostCount() const
+	{
+		return m_hosts.size();
+	}
+
+	int reachableCount() const
+	{
+		return m_reachableCount;
+	}
+
+	QList<HostStatistics> hostStatistics() const;
+
+	static QByteArray magicPacket( const QString& macAddress );
+	static QList<QHostAddress> broadcastAddresses();
+	static bool sendPackets( QUdpSocket& socket, const QList<QByteArray>& packets,
+							 const QList<QHostAddress>& addresses );
+
+Q_SIGNALS:
+	void progressChanged( int reachableCount, int hostCount );
+	void finished();
+
+private:
+	static constexpr auto WakeOnLanPort = 9;
+	static constexpr auto MinimumBatchInterval = 10;
+
+	enum class HostState
+	{
+		Pending,
+		Sent,
+		Reachable,
+		Failed
+	};
+
+	struct Host
+	{
+		ComputerControlInterface::Pointer controlInterface;
+		QByteArray packet;
+		HostState state{HostState::Pending};
+		int attempts{0};
+		QElapsedTimer bootTimer;
+		QElapsedTimer sendTimer;
+		qint64 bootTime{-1};
+	};
+
+	struct Setup
+	{
+		QList<QByteArray> packets;
+		QList<QHostAddress> broadcastAddresses;
+	};
+
+	static Setup prepare( const QList<Computer>& computers );
+	void run( const Setup& setup );
+
+	void sendBatch();
+	void updateState( ComputerControlInterface* controlInterface );
+	static bool isReachable( const ComputerControlInterface::Pointer& controlInterface );
+
+	void checkFinished();
+	void finish();
+
+	int m_batchSize;
+	int m_batchInterval;
+	int m_retryInterval;
+	int m_maximumAttempts;
+	int m_bootTimeout;
+
+	QUdpSocket m_socket{this};
+	QList<QHostAddress> m_broadcastAddresses;
+
+	QList<Host> m_hosts;
+	QHash<ComputerControlInterface *, int> m_hostIndices;
+	QQueue<int> m_queue;
+	int m_reachableCount{0};
+	int m_resolvedCount{0};
+
+	QTimer m_sendTimer{this};
+	bool m_finished{false};
+
+};
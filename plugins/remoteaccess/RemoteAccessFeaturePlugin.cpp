@@ -28,6 +28,7 @@
 #include <QInputDialog>
 
 #include "AuthenticationCredentials.h"
+#include "FeatureManager.h"
 #include "FeatureWorkerManager.h"
 #include "RemoteAccessFeaturePlugin.h"
 #include "RemoteAccessWidget.h"
@@ -459,6 +460,7 @@ void RemoteAccessFeaturePlugin::updateClipboardData()
 
 	m_clipboardDataMutex.lock();
 
+	const auto previousClipboardDataVersion = m_clipboardDataVersion;
 	const auto clipboard = QGuiApplication::clipboard();
 
 	if (m_clipboardText != clipboard->text())
@@ -474,5 +476,12 @@ void RemoteAccessFeaturePlugin::updateClipboardData()
 		++m_clipboardDataVersion;
 	}
 
+	const auto clipboardDataVersion = m_clipboardDataVersion;
+
 	m_clipboardDataMutex.unlock();
+
+	if (clipboardDataVersion != previousClipboardDataVersion)
+	{
+		VeyonCore::featureManager().notifyAsyncFeatureMessagesPending();
+	}
 }
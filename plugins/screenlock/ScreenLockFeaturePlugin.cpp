@@ -80,14 +80,14 @@ bool ScreenLockFeaturePlugin::controlFeature( Feature::Uid featureUid, Operation
 
 	if( operation == Operation::Start )
 	{
-		sendFeatureMessage( FeatureMessage{ featureUid, StartLockCommand }, computerControlInterfaces );
+		sendTrackedFeatureMessage( FeatureMessage{ featureUid, StartLockCommand }, computerControlInterfaces );
 
 		return true;
 	}
 
 	if( operation == Operation::Stop )
 	{
-		sendFeatureMessage( FeatureMessage{ featureUid, StopLockCommand }, computerControlInterfaces );
+		sendTrackedFeatureMessage( FeatureMessage{ featureUid, StopLockCommand }, computerControlInterfaces );
 
 		return true;
 	}
@@ -22,10 +22,13 @@
  *
  */
 
+#include <QFutureWatcher>
 #include <QMessageBox>
+#include <QProgressDialog>
 
 #include "ScreenshotFeaturePlugin.h"
 #include "ComputerControlInterface.h"
+#include "Filesystem.h"
 #include "VeyonMasterInterface.h"
 #include "Screenshot.h"
 
@@ -60,11 +63,19 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 
 	if( hasFeature( featureUid ) && operation == Operation::Start )
 	{
-		for( const auto& controlInterface : computerControlInterfaces )
+		auto screenshots = Screenshot::takeAll( computerControlInterfaces );
+		screenshots.waitForFinished();
+
+		for( const auto& result : screenshots.results() )
 		{
-			Screenshot().take( controlInterface );
+			if( result.errorString.isEmpty() == false )
+			{
+				vCritical() << result.errorString.toUtf8().constData();
+			}
 		}
 
+		Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+
 		return true;
 	}
 
@@ -76,15 +87,51 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const Feature& feature,
 											const ComputerControlInterfaceList& computerControlInterfaces )
 {
-	if( controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces ) )
+	if( hasFeature( feature.uid() ) == false )
 	{
+		return false;
+	}
+
+	// annotate, encode and write screenshots in background while showing progress
+	auto progressDialog = new QProgressDialog( tr( "Taking screenshots..." ), {},
+											   0, computerControlInterfaces.count(), master.mainWindow() );
+	progressDialog->setWindowModality( Qt::NonModal );
+	progressDialog->setMinimumDuration( ProgressDialogMinimumDuration );
+	progressDialog->setAttribute( Qt::WA_DeleteOnClose );
+
+	auto watcher = new QFutureWatcher<Screenshot::Result>( this );
+
+	connect( watcher, &QFutureWatcherBase::progressValueChanged, progressDialog, &QProgressDialog::setValue );
+	connect( watcher, &QFutureWatcherBase::finished, this, [=, &master]() {
+		progressDialog->close();
+
+		QStringList errors;
+		for( const auto& result : watcher->future().results() )
+		{
+			if( result.errorString.isEmpty() == false )
+			{
+				vCritical() << result.errorString.toUtf8().constData();
+				errors.append( result.errorString );
+			}
+		}
+
+		watcher->deleteLater();
+
+		Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+
+		if( errors.isEmpty() == false )
+		{
+			QMessageBox::critical( master.mainWindow(), tr( "Screenshot" ), errors.join( QLatin1Char('\n') ) );
+			return;
+		}
+
 		QMessageBox::information( master.mainWindow(),
 								  tr( "Screenshots taken" ),
 								  tr( "Screenshot of %1 computer have been taken successfully." ).
-								  arg( computerControlInterfaces.count() ) );
+								  arg( watcher->future().resultCount() ) );
+	} );
 
-		return true;
-	}
+	watcher->setFuture( Screenshot::takeAll( computerControlInterfaces ) );
 
-	return false;
+	return true;
 }
@@ -76,6 +76,8 @@ public:
 
 
 private:
+	static constexpr auto ProgressDialogMinimumDuration = 500;
+
 	const Feature m_screenshotFeature;
 	const FeatureList m_features;
 
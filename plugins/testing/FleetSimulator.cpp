@@ -0,0 +1,657 @@
+/*
+ * FleetSimulator.cpp - implementation of FleetSimulator class
+ *
+ * Copyright (c) 2017-2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QFile>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include "ConfigurationManager.h"
+#include "FleetSimulator.h"
+#include "Filesystem.h"
+#include "FramebufferTimestamp.h"
+#include "MultiSessionServerControl.h"
+#include "NetworkObject.h"
+#include "ObjectManager.h"
+#include "PlatformPluginInterface.h"
+#include "PlatformUserFunctions.h"
+#include "VeyonConfiguration.h"
+#include "VncConnection.h"
+
+
+FleetSimulator::FleetSimulator( int hostCount, int duration, bool sharedServerProcess, QObject* parent ) :
+	QObject( parent ),
+	m_hostCount( hostCount ),
+	m_duration( duration ),
+	m_sharedServerProcess( sharedServerProcess )
+{
+	m_result.hostCount = m_hostCount;
+	m_result.sharedServerProcess = m_sharedServerProcess;
+}
+
+
+
+FleetSimulator::~FleetSimulator()
+{
+	disconnectHosts();
+	stopServers();
+	restoreConfiguration();
+}
+
+
+
+bool FleetSimulator::checkPrerequisites()
+{
+	auto& config = VeyonCore::config();
+
+	if( config.multiSessionModeEnabled() == false )
+	{
+		m_errorString = tr( "Multi session mode has to be enabled in order to run multiple servers on this computer." );
+		return false;
+	}
+
+	if( config.vncServerPlugin() != headlessVncServerPluginUid() )
+	{
+		m_errorString = tr( "The headless VNC server has to be selected as VNC server." );
+		return false;
+	}
+
+	// servers use the session ID as offset to the configured port numbers so make sure the ranges do not overlap
+	QList<int> basePorts{ config.veyonServerPort(), config.vncServerPort(), config.featureWorkerManagerPort() };
+	std::sort( basePorts.begin(), basePorts.end() );
+	for( int i = 1; i < basePorts.count(); ++i )
+	{
+		if( basePorts[i-1] + m_hostCount >= basePorts[i] )
+		{
+			m_errorString = tr( "The configured network ports are too close to each other for %1 hosts. "
+								"Please increase the distance between the port numbers to at least %2." ).
+							arg( m_hostCount ).arg( m_hostCount + 1 );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+bool FleetSimulator::run()
+{
+	if( VeyonCore::instance()->initAuthentication() == false )
+	{
+		m_errorString = tr( "Failed to initialize credentials" );
+		return false;
+	}
+
+	if( registerLocation() == false )
+	{
+		return false;
+	}
+
+	QElapsedTimer serverStartupTimer;
+	serverStartupTimer.start();
+
+	if( startServers() == false || waitForServers() == false )
+	{
+		stopServers();
+		restoreConfiguration();
+		return false;
+	}
+
+	m_result.serverStartupTime = serverStartupTimer.elapsed();
+
+	connectHosts();
+	waitForConnections();
+
+	// measure framebuffer latencies and resource usage in steady state only
+	m_framebufferLatencies.clear();
+	m_framebufferLatencies.reserve( m_hostCount * m_duration / SyntheticUpdateInterval );
+
+	const auto serverUsageBefore = serverResourceUsage();
+	const auto masterUsageBefore = resourceUsage( QCoreApplication::applicationPid() );
+
+	m_inputLatencies.clear();
+	m_inputLatencies.reserve( m_hostCount * m_duration / InputProbeInterval );
+
+	QElapsedTimer measurementTimer;
+	measurementTimer.start();
+
+	QTimer inputProbeTimer;
+	connect( &inputProbeTimer, &QTimer::timeout, this, &FleetSimulator::sendInputProbes );
+	inputProbeTimer.start( InputProbeInterval );
+
+	QEventLoop eventLoop;
+	QTimer::singleShot( m_duration, &eventLoop, &QEventLoop::quit );
+	eventLoop.exec();
+
+	inputProbeTimer.stop();
+
+	evaluate( serverUsageBefore, masterUsageBefore, measurementTimer.elapsed() );
+
+	disconnectHosts();
+	stopServers();
+	restoreConfiguration();
+
+	return true;
+}
+
+
+
+int FleetSimulator::serverPort( const Host& host ) const
+{
+	return VeyonCore::config().veyonServerPort() + host.sessionId;
+}
+
+
+
+bool FleetSimulator::startServers()
+{
+	auto environment = QProcessEnvironment::systemEnvironment();
+	environment.insert( QStringLiteral("QT_QPA_PLATFORM"), QStringLiteral("offscreen") );
+
+	m_hosts.resize( m_hostCount );
+
+	if( m_sharedServerProcess )
+	{
+		auto serverEnvironment = environment;
+		serverEnvironment.insert( QLatin1String( MultiSessionServerControl::environmentVariable() ), QStringLiteral("1") );
+
+		m_serverProcess = new QProcess( this );
+		m_serverProcess->setProcessEnvironment( serverEnvironment );
+		m_serverProcess->setStandardOutputFile( QProcess::nullDevice() );
+		m_serverProcess->setStandardErrorFile( QProcess::nullDevice() );
+		m_serverProcess->start( VeyonCore::filesystem().serverFilePath(), QStringList{} );
+
+		if( m_serverProcess->waitForStarted() == false )
+		{
+			m_errorString = tr( "Failed to start server process: %1" ).arg( m_serverProcess->errorString() );
+			return false;
+		}
+
+		const auto currentUser = VeyonCore::platform().userFunctions().currentUser();
+
+		for( int i = 0; i < m_hostCount; ++i )
+		{
+			auto& host = m_hosts[i];
+			host.sessionId = i + 1;
+			host.process = m_serverProcess;
+
+			m_serverProcess->write( MultiSessionServerControl::openSessionCommand( host.sessionId, currentUser,
+																				  environment ) );
+		}
+
+		return true;
+	}
+
+	for( int i = 0; i < m_hostCount; ++i )
+	{
+		auto& host = m_hosts[i];
+		host.sessionId = i + 1;
+
+		environment.insert( VeyonCore::sessionIdEnvironmentVariable(), QString::number( host.sessionId ) );
+
+		host.process = new QProcess( this );
+		host.process->setProcessEnvironment( environment );
+		host.process->setStandardOutputFile( QProcess::nullDevice() );
+		host.process->setStandardErrorFile( QProcess::nullDevice() );
+		host.process->start( VeyonCore::filesystem().serverFilePath(), QStringList{} );
+
+		if( host.process->waitForStarted() == false )
+		{
+			m_errorString = tr( "Failed to start server process: %1" ).arg( host.process->errorString() );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+void FleetSimulator::stopServers()
+{
+	if( m_serverProcess )
+	{
+		for( auto& host : m_hosts )
+		{
+			host.process = nullptr;
+		}
+
+		// closing the control channel makes the server terminate
+		m_serverProcess->closeWriteChannel();
+		if( m_serverProcess->waitForFinished( ServerTerminationTimeout ) == false )
+		{
+			m_serverProcess->kill();
+			m_serverProcess->waitForFinished();
+		}
+		delete m_serverProcess;
+		m_serverProcess = nullptr;
+	}
+
+	for( auto& host : m_hosts )
+	{
+		if( host.process )
+		{
+			host.process->terminate();
+		}
+	}
+
+	for( auto& host : m_hosts )
+	{
+		if( host.process )
+		{
+			if( host.process->waitForFinished( ServerTerminationTimeout ) == false )
+			{
+				host.process->kill();
+				host.process->waitForFinished();
+			}
+			delete host.process;
+			host.process = nullptr;
+		}
+	}
+}
+
+
+
+bool FleetSimulator::waitForServers()
+{
+	QElapsedTimer startupTimer;
+	startupTimer.start();
+
+	for( const auto& host : std::as_const(m_hosts) )
+	{
+		while( true )
+		{
+			QTcpSocket socket;
+			socket.connectToHost( QHostAddress::LocalHost, quint16( serverPort( host ) ) );
+			if( socket.waitForConnected( ServerStartupPollInterval ) )
+			{
+				break;
+			}
+
+			if( host.process->state() != QProcess::Running || startupTimer.elapsed() > ServerStartupTimeout )
+			{
+				m_errorString = tr( "Server for session %1 did not start listening on port %2" ).
+								arg( host.sessionId ).arg( serverPort( host ) );
+				return false;
+			}
+
+			QThread::msleep( ServerStartupPollInterval );
+		}
+	}
+
+	return true;
+}
+
+
+
+bool FleetSimulator::registerLocation()
+{
+	auto& config = VeyonCore::config();
+
+	const auto networkObjectsKey = QStringLiteral("NetworkObjects");
+	const auto builtinDirectoryKey = QStringLiteral("BuiltinDirectory");
+	const auto syntheticUpdateIntervalKey = QStringLiteral("SyntheticUpdateInterval");
+	const auto headlessVncServerKey = QStringLiteral("HeadlessVncServer");
+
+	m_previousNetworkObjects = config.hasValue( networkObjectsKey, builtinDirectoryKey ) ?
+								   config.value( networkObjectsKey, builtinDirectoryKey, {} ) : QVariant{};
+	m_previousSyntheticUpdateInterval = config.hasValue( syntheticUpdateIntervalKey, headlessVncServerKey ) ?
+											config.value( syntheticUpdateIntervalKey, headlessVncServerKey, {} ) : QVariant{};
+	m_configurationModified = true;
+
+	ObjectManager<NetworkObject> objectManager( config.value( networkObjectsKey, builtinDirectoryKey, QJsonArray{} ).toJsonArray() );
+
+	const NetworkObject location( NetworkObject::Type::Location, locationName() );
+	objectManager.remove( location.uid(), true );
+	objectManager.add( location );
+
+	for( int i = 0; i < m_hostCount; ++i )
+	{
+		const auto sessionId = i + 1;
+		objectManager.add( NetworkObject( NetworkObject::Type::Host,
+										  QStringLiteral("fleet-host-%1").arg( sessionId ),
+										  QStringLiteral("127.0.0.1:%1").arg( config.veyonServerPort() + sessionId ),
+										  {}, {}, NetworkObject::Uid(), location.uid() ) );
+	}
+
+	config.setValue( networkObjectsKey, objectManager.objects(), builtinDirectoryKey );
+
+	if( config.value( syntheticUpdateIntervalKey, headlessVncServerKey, 0 ).toInt() <= 0 )
+	{
+		config.setValue( syntheticUpdateIntervalKey, SyntheticUpdateInterval, headlessVncServerKey );
+	}
+
+	// the server processes read the configuration from the store
+	ConfigurationManager configurationManager;
+	if( configurationManager.saveConfiguration() == false )
+	{
+		m_errorString = configurationManager.errorString();
+		restoreConfiguration();
+		return false;
+	}
+
+	return true;
+}
+
+
+
+void FleetSimulator::restoreConfiguration()
+{
+	if( m_configurationModified == false )
+	{
+		return;
+	}
+
+	m_configurationModified = false;
+
+	auto& config = VeyonCore::config();
+
+	const auto restoreValue = [&config]( const QString& key, const QString& parentKey, const QVariant& value ) {
+		if( value.isValid() )
+		{
+			config.setValue( key, value, parentKey );
+		}
+		else
+		{
+			config.removeValue( key, parentKey );
+		}
+	};
+
+	restoreValue( QStringLiteral("NetworkObjects"), QStringLiteral("BuiltinDirectory"), m_previousNetworkObjects );
+	restoreValue( QStringLiteral("SyntheticUpdateInterval"), QStringLiteral("HeadlessVncServer"),
+				  m_previousSyntheticUpdateInterval );
+
+	ConfigurationManager configurationManager;
+	if( configurationManager.saveConfiguration() == false )
+	{
+		vWarning() << "failed to restore configuration:" << configurationManager.errorString();
+	}
+}
+
+
+
+void FleetSimulator::connectHosts()
+{
+	m_connectTimer.start();
+
+	for( int i = 0; i < m_hosts.count(); ++i )
+	{
+		auto& host = m_hosts[i];
+
+		Computer computer( {}, QStringLiteral("fleet-host-%1").arg( host.sessionId ), QStringLiteral("127.0.0.1") );
+
+		host.computerControlInterface = ComputerControlInterface::Pointer::create( computer, serverPort( host ) );
+
+		connect( host.computerControlInterface.data(), &ComputerControlInterface::stateChanged, this, [this, i]() {
+			auto& currentHost = m_hosts[i];
+			if( currentHost.connectTime < 0 &&
+				currentHost.computerControlInterface->state() == ComputerControlInterface::State::Connected )
+			{
+				currentHost.connectTime = m_connectTimer.elapsed();
+			}
+		} );
+
+		connect( host.computerControlInterface.data(), &ComputerControlInterface::framebufferUpdated, this, [this, i]() {
+			handleFramebufferUpdate( m_hosts[i] );
+		} );
+
+		host.computerControlInterface->start( {}, ComputerControlInterface::UpdateMode::Live );
+	}
+}
+
+
+
+void FleetSimulator::waitForConnections()
+{
+	QEventLoop eventLoop;
+	QTimer pollTimer;
+	connect( &pollTimer, &QTimer::timeout, &eventLoop, [&]() {
+		const auto pending = std::any_of( m_hosts.constBegin(), m_hosts.constEnd(), []( const Host& host ) {
+			return host.firstFramebufferTime < 0;
+		} );
+		if( pending == false || m_connectTimer.elapsed() > ConnectTimeout )
+		{
+			eventLoop.quit();
+		}
+	} );
+	pollTimer.start( ServerStartupPollInterval );
+
+	eventLoop.exec();
+}
+
+
+
+void FleetSimulator::disconnectHosts()
+{
+	for( auto& host : m_hosts )
+	{
+		host.computerControlInterface.clear();
+	}
+}
+
+
+
+void FleetSimulator::sendInputProbes()
+{
+	// move the pointer to a position derived from the current time which the headless
+	// VNC server echoes in the framebuffer so the master can calculate the input latency
+	const auto time = QDateTime::currentMSecsSinceEpoch() & InputProbeTimeMask;
+	const auto x = int( time & ( ( 1 << InputProbeXBits ) - 1 ) );
+	const auto y = int( time >> InputProbeXBits );
+
+	for( const auto& host : std::as_const(m_hosts) )
+	{
+		const auto vncConnection = host.computerControlInterface ? host.computerControlInterface->vncConnection() : nullptr;
+		if( vncConnection && vncConnection->isConnected() )
+		{
+			vncConnection->mouseEvent( x, y, 0 );
+		}
+	}
+}
+
+
+
+void FleetSimulator::handleFramebufferUpdate( Host& host )
+{
+	const auto now = QDateTime::currentMSecsSinceEpoch();
+
+	if( host.firstFramebufferTime < 0 )
+	{
+		host.firstFramebufferTime = m_connectTimer.elapsed();
+	}
+
+	const auto timestamp = FramebufferTimestamp::decode( host.computerControlInterface->framebuffer() );
+	if( timestamp != FramebufferTimestamp::InvalidTimestamp &&
+		timestamp != host.lastFramebufferTimestamp )
+	{
+		host.lastFramebufferTimestamp = timestamp;
+		m_framebufferLatencies.append( now - timestamp );
+	}
+
+	const auto pointerPosition = FramebufferTimestamp::decode( host.computerControlInterface->framebuffer(),
+															   FramebufferTimestamp::PointerPositionRow );
+	if( pointerPosition != FramebufferTimestamp::InvalidTimestamp &&
+		pointerPosition != host.lastPointerPosition )
+	{
+		host.lastPointerPosition = pointerPosition;
+
+		const auto position = FramebufferTimestamp::decodePointerPosition( pointerPosition );
+		const auto sendTime = ( qint64( position.y() ) << InputProbeXBits ) | position.x();
+		m_inputLatencies.append( ( now - sendTime ) & InputProbeTimeMask );
+	}
+}
+
+
+
+void FleetSimulator::evaluate( const ResourceUsage& serverUsageBefore, const ResourceUsage& masterUsageBefore,
+							   qint64 measurementTime )
+{
+	qint64 connectTimeSum = 0;
+	qint64 firstFramebufferTimeSum = 0;
+	int firstFramebufferCount = 0;
+
+	for( const auto& host : std::as_const(m_hosts) )
+	{
+		if( host.connectTime >= 0 )
+		{
+			++m_result.connectedCount;
+			connectTimeSum += host.connectTime;
+			m_result.maximumConnectTime = qMax( m_result.maximumConnectTime, host.connectTime );
+		}
+		if( host.firstFramebufferTime >= 0 )
+		{
+			++firstFramebufferCount;
+			firstFramebufferTimeSum += host.firstFramebufferTime;
+		}
+	}
+
+	if( m_result.connectedCount > 0 )
+	{
+		m_result.averageConnectTime = connectTimeSum / m_result.connectedCount;
+	}
+
+	if( firstFramebufferCount > 0 )
+	{
+		m_result.averageFirstFramebufferTime = firstFramebufferTimeSum / firstFramebufferCount;
+	}
+
+	m_result.framebufferUpdateCount = m_framebufferLatencies.count();
+
+	if( m_framebufferLatencies.isEmpty() == false )
+	{
+		std::sort( m_framebufferLatencies.begin(), m_framebufferLatencies.end() );
+		m_result.averageFramebufferLatency = std::accumulate( m_framebufferLatencies.constBegin(),
+															  m_framebufferLatencies.constEnd(), qint64(0) ) /
+											 m_framebufferLatencies.count();
+		m_result.percentile95FramebufferLatency = m_framebufferLatencies[m_framebufferLatencies.count() * 95 / 100];
+	}
+
+	if( m_inputLatencies.isEmpty() == false )
+	{
+		std::sort( m_inputLatencies.begin(), m_inputLatencies.end() );
+		m_result.averageInputLatency = std::accumulate( m_inputLatencies.constBegin(),
+														m_inputLatencies.constEnd(), qint64(0) ) /
+									   m_inputLatencies.count();
+		m_result.percentile95InputLatency = m_inputLatencies[m_inputLatencies.count() * 95 / 100];
+	}
+
+	const auto serverUsageAfter = serverResourceUsage();
+	const auto masterUsageAfter = resourceUsage( QCoreApplication::applicationPid() );
+
+	m_result.serverCpuUsage = cpuUsage( serverUsageAfter.cpuTicks - serverUsageBefore.cpuTicks, measurementTime );
+	m_result.serverMemoryUsage = serverUsageAfter.memoryUsage;
+	m_result.masterCpuUsage = cpuUsage( masterUsageAfter.cpuTicks - masterUsageBefore.cpuTicks, measurementTime );
+	m_result.masterMemoryUsage = masterUsageAfter.memoryUsage;
+}
+
+
+
+FleetSimulator::ResourceUsage FleetSimulator::serverResourceUsage() const
+{
+	if( m_serverProcess )
+	{
+		return resourceUsage( m_serverProcess->processId() );
+	}
+
+	ResourceUsage usage;
+
+	for( const auto& host : m_hosts )
+	{
+		if( host.process )
+		{
+			const auto hostUsage = resourceUsage( host.process->processId() );
+			usage.cpuTicks += hostUsage.cpuTicks;
+			usage.memoryUsage += hostUsage.memoryUsage;
+		}
+	}
+
+	return usage;
+}
+
+
+
+FleetSimulator::ResourceUsage FleetSimulator::resourceUsage( qint64 pid )
+{
+	ResourceUsage usage;
+
+#ifdef Q_OS_LINUX
+	QFile statFile( QStringLiteral("/proc/%1/stat").arg( pid ) );
+	if( statFile.open( QFile::ReadOnly ) )
+	{
+		// skip PID and command name which may contain spaces
+		const auto stat = statFile.readAll();
+		const auto fields = stat.mid( stat.lastIndexOf( ')' ) + 2 ).split( ' ' );
+		// utime and stime are fields 14 and 15 of which the first two have been skipped
+		static constexpr auto UserTimeField = 11;
+		static constexpr auto SystemTimeField = 12;
+		usage.cpuTicks = fields.value( UserTimeField ).toLongLong() + fields.value( SystemTimeField ).toLongLong();
+	}
+
+	QFile statusFile( QStringLiteral("/proc/%1/status").arg( pid ) );
+	if( statusFile.open( QFile::ReadOnly | QFile::Text ) )
+	{
+		while( statusFile.atEnd() == false )
+		{
+			const auto line = statusFile.readLine();
+			if( line.startsWith( "VmRSS:" ) )
+			{
+				usage.memoryUsage = line.mid( 6 ).simplified().split( ' ' ).value( 0 ).toLongLong();
+				break;
+			}
+		}
+	}
+#else
+	Q_UNUSED(pid)
+#endif
+
+	return usage;
+}
+
+
+
+double FleetSimulator::cpuUsage( qint64 ticks, qint64 milliseconds )
+{
+#ifdef Q_OS_LINUX
+	if( milliseconds > 0 )
+	{
+		return 100.0 * double(ticks) / double(sysconf(_SC_CLK_TCK)) / ( double(milliseconds) / 1000.0 );
+	}
+#else
+	Q_UNUSED(ticks)
+	Q_UNUSED(milliseconds)
+#endif
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * FleetSimulator.h - declaration of FleetSimulator class
+ *
+ * Copyright (c) 2017-2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QProcess>
+
+#include "ComputerControlInterface.h"
+
+// spawns a number of Veyon Server processes backed by the headless VNC server on the
+// local host, connects to all of them and collects connection, framebuffer and resource statistics
+class FleetSimulator : public QObject
+{
+	Q_OBJECT
+public:
+	struct Result
+	{
+		int hostCount{0};
+		bool sharedServerProcess{false};
+		int connectedCount{0};
+		qint64 serverStartupTime{0};
+		qint64 averageConnectTime{-1};
+		qint64 maximumConnectTime{-1};
+		qint64 averageFirstFramebufferTime{-1};
+		qint64 averageFramebufferLatency{-1};
+		qint64 percentile95FramebufferLatency{-1};
+		qint64 averageInputLatency{-1};
+		qint64 percentile95InputLatency{-1};
+		int framebufferUpdateCount{0};
+		double serverCpuUsage{0};
+		qint64 serverMemoryUsage{0};
+		double masterCpuUsage{0};
+		qint64 masterMemoryUsage{0};
+	};
+
+	FleetSimulator( int hostCount, int duration, bool sharedServerProcess = false, QObject* parent = nullptr );
+	~FleetSimulator() override;
+
+	bool checkPrerequisites();
+
+	bool run();
+
+	const Result& result() const
+	{
+		return m_result;
+	}
+
+	const QString& errorString() const
+	{
+		return m_errorString;
+	}
+
+	static QString locationName()
+	{
+		return QStringLiteral("Fleet simulator");
+	}
+
+	static QUuid headlessVncServerPluginUid()
+	{
+		return QUuid{QStringLiteral("f626f759-7691-45c0-bd4a-37171d98d219")};
+	}
+
+private:
+	struct Host
+	{
+		int sessionId{0};
+		QProcess* process{nullptr};
+		ComputerControlInterface::Pointer computerControlInterface;
+		qint64 connectTime{-1};
+		qint64 firstFramebufferTime{-1};
+		qint64 lastFramebufferTimestamp{-1};
+		qint64 lastPointerPosition{-1};
+	};
+
+	struct ResourceUsage
+	{
+		qint64 cpuTicks{0};
+		qint64 memoryUsage{0};
+	};
+
+	static constexpr auto ServerStartupTimeout = 60000;
+	static constexpr auto ServerStartupPollInterval = 100;
+	static constexpr auto ConnectTimeout = 60000;
+	static constexpr auto ServerTerminationTimeout = 5000;
+	static constexpr auto SyntheticUpdateInterval = 40;
+	static constexpr auto InputProbeInterval = 100;
+	// pointer positions used as input probes encode the lower bits of the send time
+	static constexpr auto InputProbeXBits = 9;
+	static constexpr auto InputProbeYBits = 8;
+	static constexpr qint64 InputProbeTimeMask = ( qint64(1) << ( InputProbeXBits + InputProbeYBits ) ) - 1;
+
+	int serverPort( const Host& host ) const;
+
+	bool startServers();
+	void stopServers();
+	bool waitForServers();
+	bool registerLocation();
+	void restoreConfiguration();
+	void connectHosts();
+	void waitForConnections();
+	void disconnectHosts();
+
+	void sendInputProbes();
+	void handleFramebufferUpdate( Host& host );
+
+	void evaluate( const ResourceUsage& serverUsageBefore, const ResourceUsage& masterUsageBefore,
+				   qint64 measurementTime );
+
+	ResourceUsage serverResourceUsage() const;
+	static ResourceUsage resourceUsage( qint64 pid );
+	static double cpuUsage( qint64 ticks, qint64 milliseconds );
+
+	const int m_hostCount;
+	const int m_duration;
+	const bool m_sharedServerProcess;
+
+	// serves all hosts if enabled
+	QProcess* m_serverProcess{nullptr};
+
+	QVector<Host> m_hosts;
+	QVector<qint64> m_framebufferLatencies;
+	QVector<qint64> m_inputLatencies;
+
+	QElapsedTimer m_connectTimer;
+
+	// values overwritten in the configuration while running the servers - an invalid
+	// value denotes a key which did not exist before
+	bool m_configurationModified{false};
+	QVariant m_previousNetworkObjects;
+	QVariant m_previousSyntheticUpdateInterval;
+
+	Result m_result;
+	QString m_errorString;
+
+};
@@ -22,10 +22,67 @@
  *
  */
 
-#include "CommandLineIO.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include "CommandLineBenchmark.h"
 #include "AccessControlProvider.h"
+#include "CryptoCore.h"
+#include "FeatureManager.h"
+#include "FeatureWorkerManager.h"
+#include "FleetSimulator.h"
+#ifdef Q_OS_LINUX
+#include "LinuxSessionEnvironmentCache.h"
+#endif
 #include "PlatformNetworkFunctions.h"
+#include "PlatformUserFunctions.h"
+#include "PluginManager.h"
 #include "TestingCommandLinePlugin.h"
+#include "VeyonServerInterface.h"
+
+
+class BenchmarkServer : public VeyonServerInterface
+{
+public:
+	BenchmarkServer() :
+		VeyonServerInterface( nullptr ),
+		m_featureWorkerManager( *this )
+	{
+	}
+
+	FeatureWorkerManager& featureWorkerManager() override
+	{
+		return m_featureWorkerManager;
+	}
+
+	bool sendFeatureMessageReply( const MessageContext& context, const FeatureMessage& reply ) override
+	{
+		Q_UNUSED(context)
+		Q_UNUSED(reply)
+		return true;
+	}
+
+	int vncServerBasePort() const override
+	{
+		return VeyonCore::config().vncServerPort();
+	}
+
+	void setMinimumFramebufferUpdateInterval( const MessageContext& context, int interval ) override
+	{
+		Q_UNUSED(context)
+		Q_UNUSED(interval)
+	}
+
+private:
+	FeatureWorkerManager m_featureWorkerManager;
+
+};
 
 
 TestingCommandLinePlugin::TestingCommandLinePlugin( QObject* parent ) :
@@ -35,6 +92,13 @@ TestingCommandLinePlugin::TestingCommandLinePlugin( QObject* parent ) :
 { QStringLiteral("authorizedgroups"), QStringLiteral( "check if specified user is in authorized groups [ACCESSING USER]" ) },
 { QStringLiteral("accesscontrolrules"), QStringLiteral( "process access control rules with arguments [ACCESSING USER] [ACCESSING COMPUTER] [LOCAL USER] [LOCAL COMPUTER] [CONNECTED USER]" ) },
 { QStringLiteral("isaccessdeniedbylocalstate"), QStringLiteral( "check if access would be denied by local state") },
+{ QStringLiteral("fleetbenchmark"), QStringLiteral( "run servers for simulated hosts locally and benchmark connections to them with arguments [HOST COUNTS] [DURATION] [shared]" ) },
+{ QStringLiteral("authbenchmark"), QStringLiteral( "benchmark key file authentication handshakes with arguments [HANDSHAKES] [CONCURRENT CONNECTIONS]" ) },
+{ QStringLiteral("featuredispatchbenchmark"), QStringLiteral( "benchmark feature lookups and feature message dispatching with arguments [ITERATIONS]" ) },
+{ QStringLiteral("workerpoolbenchmark"), QStringLiteral( "benchmark latency of starting screen lock workers with and without idle worker pool with arguments [STARTS] [POOL SIZE]" ) },
+{ QStringLiteral("groupresolutionbenchmark"), QStringLiteral( "benchmark resolving user groups and group memberships with arguments [USER] [ITERATIONS]" ) },
+{ QStringLiteral("sessionenvironmentbenchmark"), QStringLiteral( "benchmark discovering the environment of a session in a synthetic process table with arguments [PROCESSES] [SESSION PROCESSES] [ITERATIONS]" ) },
+{ QStringLiteral("startupbenchmark"), QStringLiteral( "benchmark startup of veyon-cli with and without plugin meta data cache with arguments [RUNS] [MODULE]" ) },
 				} )
 {
 }
@@ -133,3 +197,629 @@ CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_ping( con
 
 	return VeyonCore::platform().networkFunctions().ping( arguments.first() ) == PlatformNetworkFunctions::PingResult::ReplyReceived ? Successful : Failed;
 }
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_fleetbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultDuration = 10;
+
+	const auto hostCountsArgument = arguments.value( 0, QStringLiteral("10,100,500") );
+	const auto duration = arguments.value( 1, QString::number( DefaultDuration ) ).toInt();
+	// serve all hosts by a single server process instead of one process per host
+	const auto sharedServerProcess = arguments.value( 2 ) == QLatin1String("shared");
+
+	QList<int> hostCounts;
+	for( const auto& hostCount : hostCountsArgument.split( QLatin1Char(',') ) )
+	{
+		if( hostCount.toInt() <= 0 )
+		{
+			return InvalidArguments;
+		}
+		hostCounts.append( hostCount.toInt() );
+	}
+
+	if( duration <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	CommandLineIO::TableRows tableRows;
+
+	for( const auto hostCount : std::as_const(hostCounts) )
+	{
+		printf( "[TEST]: FleetBenchmark: running %d hosts for %d seconds\n", hostCount, duration );
+
+		FleetSimulator simulator( hostCount, duration * 1000, sharedServerProcess );
+		if( simulator.checkPrerequisites() == false || simulator.run() == false )
+		{
+			CommandLineIO::error( simulator.errorString() );
+			return Failed;
+		}
+
+		const auto& result = simulator.result();
+		tableRows.append( {
+			QString::number( result.hostCount ),
+			QString::number( result.connectedCount ),
+			QString::number( result.serverStartupTime ),
+			QStringLiteral("%1 / %2").arg( result.averageConnectTime ).arg( result.maximumConnectTime ),
+			QString::number( result.averageFirstFramebufferTime ),
+			QStringLiteral("%1 / %2").arg( result.averageFramebufferLatency ).arg( result.percentile95FramebufferLatency ),
+			QStringLiteral("%1 / %2").arg( result.averageInputLatency ).arg( result.percentile95InputLatency ),
+			QString::number( result.framebufferUpdateCount ),
+			QString::number( result.serverCpuUsage, 'f', 1 ),
+			QString::number( result.serverMemoryUsage / 1024 ),
+			QString::number( result.serverMemoryUsage / qMax( 1, result.hostCount ) ),
+			QString::number( result.masterCpuUsage, 'f', 1 ),
+			QString::number( result.masterMemoryUsage / 1024 )
+		} );
+	}
+
+	CommandLineIO::printTable( { { QStringLiteral("Hosts"), QStringLiteral("Connected"), QStringLiteral("Startup [ms]"),
+								   QStringLiteral("Connect avg/max [ms]"), QStringLiteral("First frame [ms]"),
+								   QStringLiteral("Latency avg/p95 [ms]"), QStringLiteral("Input avg/p95 [ms]"),
+								   QStringLiteral("Updates"),
+								   QStringLiteral("Server CPU [%]"), QStringLiteral("Server RSS [MB]"),
+								   QStringLiteral("Server RSS/host [KB]"),
+								   QStringLiteral("Master CPU [%]"), QStringLiteral("Master RSS [MB]") },
+								 tableRows } );
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_authbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultHandshakeCount = 1000;
+	static constexpr auto DefaultConcurrentConnections = 400;
+
+	const auto handshakeCount = arguments.value( 0, QString::number( DefaultHandshakeCount ) ).toInt();
+	const auto concurrentConnections = arguments.value( 1, QString::number( DefaultConcurrentConnections ) ).toInt();
+
+	if( handshakeCount <= 0 || concurrentConnections <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	QTemporaryDir keyDirectory;
+	const auto publicKeyPath = keyDirectory.filePath( QStringLiteral("key") );
+
+	const auto privateKey = CryptoCore::KeyGenerator().createRSA( CryptoCore::RsaKeySize );
+	if( keyDirectory.isValid() == false || privateKey.isNull() ||
+		privateKey.toPublicKey().toPEMFile( publicKeyPath ) == false )
+	{
+		CommandLineIO::error( QStringLiteral("Failed to create temporary key pair") );
+		return Failed;
+	}
+
+	const auto createHandshake = [&]( const std::function<CryptoCore::PublicKey()>& loadPublicKey ) {
+		return [=]() {
+			const auto challenge = CryptoCore::generateChallenge();
+			auto key = privateKey;
+			const auto signature = key.signMessage( challenge, CryptoCore::DefaultSignatureAlgorithm );
+			auto publicKey = loadPublicKey();
+			return publicKey.verifyMessage( challenge, signature, CryptoCore::DefaultSignatureAlgorithm );
+		};
+	};
+
+	// public key loaded from disk for every connection
+	const auto uncachedHandshake = createHandshake( [&]() { return CryptoCore::PublicKey( publicKeyPath ); } );
+	const auto cachedHandshake = createHandshake( [&]() { return VeyonCore::cryptoCore().loadPublicKey( publicKeyPath ); } );
+
+	CommandLineBenchmark benchmark( QStringLiteral("AuthBenchmark"),
+									{ QStringLiteral("Mode"), QStringLiteral("Handshakes"), QStringLiteral("Failed"),
+									  QStringLiteral("Time [ms]"), QStringLiteral("Handshakes/s") } );
+
+	benchmark.info( QStringLiteral("running %1 handshakes with %2 concurrent connections")
+						.arg( handshakeCount ).arg( concurrentConnections ) );
+
+	for( const auto& [mode, handshake] : { std::make_pair( QStringLiteral("uncached"), CommandLineBenchmark::Operation( uncachedHandshake ) ),
+										   std::make_pair( QStringLiteral("cached"), CommandLineBenchmark::Operation( cachedHandshake ) ) } )
+	{
+		const auto measurement = CommandLineBenchmark::runConcurrently( handshakeCount, concurrentConnections, handshake );
+		benchmark.addRow( mode, { QString::number( handshakeCount ), QString::number( measurement.failedCount ),
+								  CommandLineBenchmark::milliseconds( measurement.totalTime ),
+								  QString::number( measurement.runsPerSecond(), 'f', 1 ) } );
+	}
+
+	benchmark.print();
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_featuredispatchbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultIterationCount = 10000;
+
+	const auto iterationCount = arguments.value( 0, QString::number( DefaultIterationCount ) ).toInt();
+	if( iterationCount <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	FeatureManager featureManager;
+
+	FeatureProviderInterfaceList featureInterfaces;
+	for( const auto& pluginObject : std::as_const( VeyonCore::pluginManager().pluginObjects() ) )
+	{
+		auto featureInterface = qobject_cast<FeatureProviderInterface *>( pluginObject );
+		if( featureInterface )
+		{
+			featureInterfaces.append( featureInterface );
+		}
+	}
+
+	FeatureUidList featureUids;
+	for( const auto& feature : featureManager.features() )
+	{
+		featureUids.append( feature.uid() );
+	}
+
+	if( featureUids.isEmpty() )
+	{
+		CommandLineIO::error( QStringLiteral("No features available") );
+		return Failed;
+	}
+
+	// previous implementation of FeatureManager::feature() scanning the feature lists of all plugins
+	const auto scanFeature = [&]( Feature::Uid featureUid ) -> const Feature* {
+		for( const auto& featureInterface : std::as_const( featureInterfaces ) )
+		{
+			for( const auto& feature : featureInterface->featureList() )
+			{
+				if( feature.uid() == featureUid )
+				{
+					return &feature;
+				}
+			}
+		}
+		return nullptr;
+	};
+
+	// previous message dispatching offering each message to all plugins which then compare the feature UID
+	const auto scanFeatureProviders = [&]( Feature::Uid featureUid ) {
+		int count = 0;
+		for( const auto& featureInterface : std::as_const( featureInterfaces ) )
+		{
+			count += featureInterface->hasFeature( featureUid ) ? 1 : 0;
+		}
+		return count;
+	};
+
+	// time per lookup of a single feature UID
+	qint64 checksum = 0;
+	const auto measure = [&]( const std::function<qint64 (Feature::Uid)>& lookup ) {
+		const auto measurement = CommandLineBenchmark::run( iterationCount, [&]() {
+			for( const auto& featureUid : std::as_const( featureUids ) )
+			{
+				checksum += lookup( featureUid );
+			}
+			return true;
+		} );
+		return QString::number( double(measurement.averageTime) / featureUids.count(), 'f', 1 );
+	};
+
+	CommandLineBenchmark benchmark( QStringLiteral("FeatureDispatchBenchmark"),
+									{ QStringLiteral("Operation"), QStringLiteral("Linear scan [ns]"),
+									  QStringLiteral("Dispatch table [ns]") } );
+
+	benchmark.info( QStringLiteral("%1 iterations over %2 features of %3 plugins")
+						.arg( iterationCount ).arg( featureUids.count() ).arg( featureInterfaces.count() ) );
+
+	benchmark.addRow( QStringLiteral("feature()"),
+					  { measure( [&]( Feature::Uid uid ) { return qint64( scanFeature( uid ) != nullptr ); } ),
+						measure( [&]( Feature::Uid uid ) { return qint64( featureManager.feature( uid ).isValid() ); } ) } );
+	benchmark.addRow( QStringLiteral("pluginUid()"),
+					  { measure( [&]( Feature::Uid uid ) { return qint64( scanFeatureProviders( uid ) ); } ),
+						measure( [&]( Feature::Uid uid ) { return qint64( featureManager.pluginUid( uid ).isNull() ); } ) } );
+	benchmark.addRow( QStringLiteral("message routing"),
+					  { measure( [&]( Feature::Uid uid ) { return qint64( scanFeatureProviders( uid ) ); } ),
+						measure( [&]( Feature::Uid uid ) { return qint64( featureManager.featureProviders( uid ).count() ); } ) } );
+
+	benchmark.print();
+
+	Q_UNUSED(checksum)
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_startupbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultRunCount = 10;
+	static constexpr auto ProcessTimeout = 60000;
+
+	const auto runCount = arguments.value( 0, QString::number( DefaultRunCount ) ).toInt();
+	const auto module = arguments.value( 1, commandLineModuleName() );
+
+	if( runCount <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	const auto startCli = [&]( bool useMetaDataCache ) {
+		auto environment = QProcessEnvironment::systemEnvironment();
+		if( useMetaDataCache == false )
+		{
+			environment.insert( QString::fromLatin1( PluginManager::metaDataCacheDisabledEnvironmentVariable() ),
+								QStringLiteral("1") );
+		}
+
+		return [=]() {
+			QProcess process;
+			process.setProcessEnvironment( environment );
+			process.setProcessChannelMode( QProcess::MergedChannels );
+			process.start( QCoreApplication::applicationFilePath(), { module, QStringLiteral("help") } );
+			if( process.waitForFinished( ProcessTimeout ) == false )
+			{
+				process.kill();
+				process.waitForFinished();
+				return false;
+			}
+			return true;
+		};
+	};
+
+	CommandLineBenchmark benchmark( QStringLiteral("StartupBenchmark"),
+									{ QStringLiteral("Plugin loading"), QStringLiteral("Average [ms]"), QStringLiteral("Maximum [ms]") } );
+
+	benchmark.info( QStringLiteral("starting \"veyon-cli %1 help\" %2 times").arg( module ).arg( runCount ) );
+
+	const auto uncached = CommandLineBenchmark::run( runCount, startCli( false ) );
+	// make sure the cache is populated before measuring
+	(void) CommandLineBenchmark::run( 1, startCli( true ) );
+	const auto cached = CommandLineBenchmark::run( runCount, startCli( true ) );
+
+	if( uncached.failedCount > 0 || cached.failedCount > 0 )
+	{
+		CommandLineIO::error( QStringLiteral("veyon-cli did not finish in time") );
+		return Failed;
+	}
+
+	for( const auto& [variant, measurement] : { std::make_pair( QStringLiteral("all plugins"), uncached ),
+												std::make_pair( QStringLiteral("meta data cache"), cached ) } )
+	{
+		benchmark.addRow( variant, { CommandLineBenchmark::milliseconds( measurement.averageTime ),
+									 CommandLineBenchmark::milliseconds( measurement.maximumTime ) } );
+	}
+
+	benchmark.print();
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_workerpoolbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultStartCount = 10;
+	static constexpr auto DefaultPoolSize = 1;
+	static constexpr auto WorkerTimeout = 30000;
+	static constexpr auto PollInterval = 10;
+
+	const auto startCount = arguments.value( 0, QString::number( DefaultStartCount ) ).toInt();
+	const auto poolSize = arguments.value( 1, QString::number( DefaultPoolSize ) ).toInt();
+
+	if( startCount <= 0 || poolSize <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	// screen lock feature - workers are started without sending any message so nothing gets locked
+	const Feature::Uid featureUid{ QStringLiteral("ccb535a2-1d24-4cc1-a709-8b47d2b2ac79") };
+
+	const auto waitFor = []( const std::function<bool()>& condition ) {
+		QElapsedTimer timeoutTimer;
+		timeoutTimer.start();
+
+		QEventLoop eventLoop;
+		QTimer pollTimer;
+		QObject::connect( &pollTimer, &QTimer::timeout, &eventLoop, [&]() {
+			if( condition() || timeoutTimer.hasExpired( WorkerTimeout ) )
+			{
+				eventLoop.quit();
+			}
+		} );
+		pollTimer.start( PollInterval );
+
+		eventLoop.exec();
+
+		return condition();
+	};
+
+	CommandLineBenchmark benchmark( QStringLiteral("WorkerPoolBenchmark"),
+									{ QStringLiteral("Mode"), QStringLiteral("Average [ms]"),
+									  QStringLiteral("Median [ms]"), QStringLiteral("Maximum [ms]") } );
+
+	benchmark.info( QStringLiteral("starting %1 screen lock workers").arg( startCount ) );
+
+	for( const auto currentPoolSize : { 0, poolSize } )
+	{
+		BenchmarkServer server;
+		auto& featureWorkerManager = server.featureWorkerManager();
+		featureWorkerManager.setPoolSize( currentPoolSize );
+
+		bool connected = false;
+		QObject::connect( &featureWorkerManager, &FeatureWorkerManager::workerConnected, &server,
+						  [&]( Feature::Uid uid ) { connected |= uid == featureUid; } );
+
+		// wait for the pool to be refilled after the previous worker has been taken from it
+		const auto waitForIdleWorkers = [&]() {
+			connected = false;
+			return waitFor( [&]() { return featureWorkerManager.idleWorkerCount() >= currentPoolSize; } );
+		};
+
+		const auto startWorker = [&]() {
+			featureWorkerManager.startManagedSystemWorker( featureUid );
+			const auto successful = waitFor( [&]() { return connected; } );
+			featureWorkerManager.stopWorker( featureUid );
+			return successful;
+		};
+
+		const auto measurement = CommandLineBenchmark::run( startCount, startWorker, waitForIdleWorkers );
+		if( measurement.failedCount > 0 )
+		{
+			CommandLineIO::error( QStringLiteral("Workers did not connect in time - make sure no Veyon Server is running in the current session") );
+			return Failed;
+		}
+
+		benchmark.addRow( currentPoolSize > 0 ? QStringLiteral("pool of %1").arg( currentPoolSize ) : QStringLiteral("cold start"),
+						  { CommandLineBenchmark::milliseconds( measurement.averageTime ),
+							CommandLineBenchmark::milliseconds( measurement.medianTime ),
+							CommandLineBenchmark::milliseconds( measurement.maximumTime ) } );
+	}
+
+	benchmark.print();
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_groupresolutionbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultIterationCount = 100;
+
+	if( arguments.isEmpty() )
+	{
+		return NotEnoughArguments;
+	}
+
+	const auto& username = arguments.first();
+	const auto iterationCount = arguments.value( 1, QString::number( DefaultIterationCount ) ).toInt();
+	if( iterationCount <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	auto& userFunctions = VeyonCore::platform().userFunctions();
+
+	CommandLineBenchmark benchmark( QStringLiteral("GroupResolutionBenchmark"),
+									{ QStringLiteral("Operation"), QStringLiteral("Groups"),
+									  QStringLiteral("First call [ms]"), QStringLiteral("Subsequent calls [ms]") } );
+
+	benchmark.info( QStringLiteral("%1 iterations for user %2").arg( iterationCount ).arg( username ) );
+
+	const auto measure = [&]( const QString& operation, const std::function<QStringList()>& resolveGroups ) {
+		QStringList groups;
+		const auto resolve = [&]() { groups = resolveGroups(); return true; };
+		// the first call fills the caches of the platform plugin
+		const auto firstCall = CommandLineBenchmark::run( 1, resolve );
+		const auto subsequentCalls = CommandLineBenchmark::run( iterationCount, resolve );
+		benchmark.addRow( operation, { QString::number( groups.count() ),
+									   CommandLineBenchmark::milliseconds( firstCall.averageTime, 2 ),
+									   CommandLineBenchmark::milliseconds( subsequentCalls.averageTime, 3 ) } );
+	};
+
+	measure( QStringLiteral("userGroups()"), [&]() { return userFunctions.userGroups( true ); } );
+	measure( QStringLiteral("groupsOfUser()"), [&]() { return userFunctions.groupsOfUser( username, true ); } );
+
+	benchmark.print();
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_sessionenvironmentbenchmark( const QStringList& arguments )
+{
+#ifdef Q_OS_LINUX
+	static constexpr auto DefaultProcessCount = 5000;
+	static constexpr auto DefaultSessionProcessCount = 100;
+	static constexpr auto DefaultIterationCount = 20;
+	static constexpr auto VariablesPerProcess = 40;
+	static constexpr auto ChildrenPerProcess = 4;
+	static constexpr auto InitPid = 1;
+	static constexpr auto SessionLeaderPid = 2;
+
+	const auto processCount = arguments.value( 0, QString::number( DefaultProcessCount ) ).toInt();
+	const auto sessionProcessCount = arguments.value( 1, QString::number( DefaultSessionProcessCount ) ).toInt();
+	const auto iterationCount = arguments.value( 2, QString::number( DefaultIterationCount ) ).toInt();
+
+	if( sessionProcessCount <= 0 || processCount <= sessionProcessCount + SessionLeaderPid || iterationCount <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	// the session leader's processes form a tree while all other processes are children of init
+	const auto parentPid = [&]( int pid ) {
+		const auto firstSessionPid = SessionLeaderPid + 1;
+		if( pid == SessionLeaderPid || pid > SessionLeaderPid + sessionProcessCount )
+		{
+			return InitPid;
+		}
+		return SessionLeaderPid + ( pid - firstSessionPid ) / ChildrenPerProcess;
+	};
+
+	const auto writeFile = []( const QString& filePath, const QByteArray& data ) {
+		QFile file( filePath );
+		return file.open( QFile::WriteOnly ) && file.write( data ) == data.size();
+	};
+
+	const auto createProcessTable = [&]( const QString& procPath, bool withChildrenFiles ) {
+		QMultiHash<int, int> children;
+		for( int pid = SessionLeaderPid; pid <= processCount; ++pid )
+		{
+			children.insert( parentPid( pid ), pid );
+		}
+
+		for( int pid = InitPid; pid <= processCount; ++pid )
+		{
+			const auto processPath = QStringLiteral("%1/%2").arg( procPath ).arg( pid );
+			const auto taskPath = QStringLiteral("%1/task/%2").arg( processPath ).arg( pid );
+			if( QDir().mkpath( taskPath ) == false )
+			{
+				return false;
+			}
+
+			// fields after the command name up to the start time, see proc(5)
+			QByteArrayList statFields{ "S", QByteArray::number( pid == InitPid ? 0 : parentPid( pid ) ) };
+			for( int i = 0; i < 17; ++i )
+			{
+				statFields.append( "0" );
+			}
+			statFields.append( QByteArray::number( 1000 + pid ) );
+
+			QByteArrayList variables;
+			for( int i = 0; i < VariablesPerProcess; ++i )
+			{
+				variables.append( "VARIABLE_" + QByteArray::number( i ) + "=some value of process " + QByteArray::number( pid ) );
+			}
+			variables.append( "PID=" + QByteArray::number( pid ) );
+
+			QByteArrayList childPids;
+			const auto childList = children.values( pid );
+			for( const auto child : childList )
+			{
+				childPids.append( QByteArray::number( child ) );
+			}
+
+			if( writeFile( processPath + QStringLiteral("/stat"),
+						   QByteArray::number( pid ) + " (synthetic process) " + statFields.join( ' ' ) + " 0 0\n" ) == false ||
+				writeFile( processPath + QStringLiteral("/environ"), variables.join( '\0' ) + '\0' ) == false ||
+				( withChildrenFiles && writeFile( taskPath + QStringLiteral("/children"), childPids.join( ' ' ) + ' ' ) == false ) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	const auto readFile = []( const QString& filePath ) {
+		QFile file( filePath );
+		return file.open( QFile::ReadOnly ) ? file.readAll() : QByteArray{};
+	};
+
+	// reads the whole process table including all environments
+	qint64 fullScanReadCount = 0;
+	const auto fullScan = [&]( const QString& procPath ) {
+		auto pids = QDir( procPath ).entryList( QDir::Dirs | QDir::NoDotAndDotDot );
+		std::sort( pids.begin(), pids.end(), []( const QString& a, const QString& b ) { return a.toInt() < b.toInt(); } );
+
+		QProcessEnvironment sessionEnvironment;
+		QList<int> ppids;
+
+		for( const auto& pid : std::as_const( pids ) )
+		{
+			const auto stat = readFile( QStringLiteral("%1/%2/stat").arg( procPath, pid ) );
+			const auto ppid = stat.mid( stat.lastIndexOf( ')' ) + 2 ).split( ' ' ).value( 1 ).toInt();
+			const auto variables = readFile( QStringLiteral("%1/%2/environ").arg( procPath, pid ) ).split( '\0' );
+			++fullScanReadCount;
+
+			if( ppid == SessionLeaderPid || ppids.contains( ppid ) )
+			{
+				for( const auto& variable : variables )
+				{
+					const auto separatorPos = variable.indexOf( '=' );
+					if( separatorPos > 0 )
+					{
+						sessionEnvironment.insert( QString::fromUtf8( variable.left( separatorPos ) ),
+												   QString::fromUtf8( variable.mid( separatorPos + 1 ) ) );
+					}
+				}
+				ppids.append( pid.toInt() );
+			}
+		}
+
+		return sessionEnvironment;
+	};
+
+	QTemporaryDir procDirectory;
+	const auto procPath = procDirectory.filePath( QStringLiteral("proc") );
+	const auto procWithoutChildrenPath = procDirectory.filePath( QStringLiteral("proc-without-children") );
+
+	CommandLineBenchmark benchmark( QStringLiteral("SessionEnvironmentBenchmark"),
+									{ QStringLiteral("Method"), QStringLiteral("Time per lookup [ms]"),
+									  QStringLiteral("Environments read per lookup") } );
+
+	benchmark.info( QStringLiteral("creating synthetic process table with %1 processes").arg( processCount ) );
+
+	if( procDirectory.isValid() == false ||
+		createProcessTable( procPath, true ) == false ||
+		createProcessTable( procWithoutChildrenPath, false ) == false )
+	{
+		CommandLineIO::error( QStringLiteral("Failed to create synthetic process table") );
+		return Failed;
+	}
+
+	const auto expectedEnvironment = fullScan( procPath );
+
+	bool mismatch = false;
+
+	const auto measure = [&]( const QString& method, const std::function<QProcessEnvironment()>& lookup,
+							  const std::function<qint64()>& readCount ) {
+		const auto initialReadCount = readCount();
+		const auto measurement = CommandLineBenchmark::run( iterationCount, [&]() { return lookup() == expectedEnvironment; } );
+		mismatch |= measurement.failedCount > 0;
+		benchmark.addRow( method, { CommandLineBenchmark::milliseconds( measurement.averageTime, 3 ),
+									QString::number( ( readCount() - initialReadCount ) / iterationCount ) } );
+	};
+
+	qint64 uncachedReadCount = 0;
+	const auto uncachedLookup = [&]( const QString& path ) {
+		LinuxSessionEnvironmentCache cache( path );
+		const auto environment = cache.environment( SessionLeaderPid );
+		uncachedReadCount += cache.environmentReadCount();
+		return environment;
+	};
+
+	LinuxSessionEnvironmentCache cache( procPath );
+	cache.environment( SessionLeaderPid );
+
+	benchmark.info( QStringLiteral("%1 iterations with %2 processes in session").arg( iterationCount ).arg( sessionProcessCount ) );
+
+	measure( QStringLiteral("full process table scan"),
+			 [&]() { return fullScan( procPath ); },
+			 [&]() { return fullScanReadCount; } );
+	measure( QStringLiteral("subtree walk (uncached)"),
+			 [&]() { return uncachedLookup( procPath ); },
+			 [&]() { return uncachedReadCount; } );
+	measure( QStringLiteral("subtree walk (cached)"),
+			 [&]() { return cache.environment( SessionLeaderPid ); },
+			 [&]() { return cache.environmentReadCount(); } );
+	measure( QStringLiteral("subtree walk w/o children files (uncached)"),
+			 [&]() { return uncachedLookup( procWithoutChildrenPath ); },
+			 [&]() { return uncachedReadCount; } );
+
+	benchmark.print();
+
+	if( mismatch )
+	{
+		CommandLineIO::error( QStringLiteral("Session environments differ between methods") );
+		return Failed;
+	}
+
+	return Successful;
+#else
+	Q_UNUSED(arguments)
+
+	CommandLineIO::error( QStringLiteral("Not supported on this platform") );
+
+	return Failed;
+#endif
+}
@@ -85,6 +85,13 @@ public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_accesscontrolrules( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_isaccessdeniedbylocalstate( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_ping( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_fleetbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_authbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_featuredispatchbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_startupbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_workerpoolbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_groupresolutionbenchmark( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_sessionenvironmentbenchmark( const QStringList& arguments );
 
 private:
 	QMap<QString, QString> m_commands;
@@ -70,7 +70,7 @@ bool TextMessageFeaturePlugin::controlFeature( Feature::Uid featureUid,
 		const auto text = arguments.value( argToString(Argument::Text) ).toString();
 		const auto icon = arguments.value( argToString(Argument::Icon) ).toInt();
 
-		sendFeatureMessage( FeatureMessage{ featureUid, ShowTextMessage }
+		sendTrackedFeatureMessage( FeatureMessage{ featureUid, ShowTextMessage }
 								.addArgument( Argument::Text, text )
 								.addArgument( Argument::Icon, icon ), computerControlInterfaces );
 
@@ -86,6 +86,11 @@ public:
 
 	int configuredServerPort() override;
 
+	bool supportsMultipleInstances() const override
+	{
+		return true;
+	}
+
 	Password configuredPassword() override;
 
 private:
@@ -29,6 +29,7 @@
 #include "Configuration/Proxy.h"
 
 #define FOREACH_HEADLESS_VNC_CONFIG_PROPERTY(OP) \
-    OP( HeadlessVncConfiguration, m_configuration, QColor, backgroundColor, setBackgroundColor, "BackgroundColor", "HeadlessVncServer", QColor(QStringLiteral("#198cb3")), Configuration::Property::Flag::Advanced )
+    OP( HeadlessVncConfiguration, m_configuration, QColor, backgroundColor, setBackgroundColor, "BackgroundColor", "HeadlessVncServer", QColor(QStringLiteral("#198cb3")), Configuration::Property::Flag::Advanced ) \
+    OP( HeadlessVncConfiguration, m_configuration, int, syntheticUpdateInterval, setSyntheticUpdateInterval, "SyntheticUpdateInterval", "HeadlessVncServer", 0, Configuration::Property::Flag::Hidden )
 
 DECLARE_CONFIG_PROXY(HeadlessVncConfiguration, FOREACH_HEADLESS_VNC_CONFIG_PROPERTY)
@@ -28,9 +28,14 @@ extern "C" {
 
 #include <array>
 
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QPainter>
 
+#include "FramebufferTimestamp.h"
 #include "HeadlessVncServer.h"
+#include "RfbFlowControl.h"
 #include "VeyonConfiguration.h"
 
 
@@ -44,10 +49,150 @@ struct HeadlessVncScreen
 	rfbScreenInfoPtr rfbScreen{nullptr};
 	std::array<char *, 2> passwords{};
 	QImage framebuffer;
+	QElapsedTimer syntheticUpdateTimer;
+	int syntheticFrameCount{0};
+	QPoint pointerPosition{-1, -1};
+	bool pointerMoved{false};
 
 };
 
 
+struct HeadlessVncClient
+{
+	bool continuousUpdates{false};
+	QRect continuousUpdatesRect;
+};
+
+
+static rfbBool newHeadlessVncClient( rfbClientPtr client, void** data )
+{
+	Q_UNUSED(client)
+
+	*data = new HeadlessVncClient;
+
+	return TRUE;
+}
+
+
+
+static void closeHeadlessVncClient( rfbClientPtr client, void* data )
+{
+	Q_UNUSED(client)
+
+	delete static_cast<HeadlessVncClient *>( data );
+}
+
+
+
+static rfbBool enableFlowControlEncoding( rfbClientPtr client, void** data, int encoding )
+{
+	Q_UNUSED(data)
+
+	if( encoding == RfbFlowControl::ContinuousUpdatesEncoding )
+	{
+		// announce support for continuous updates
+		const auto message = RfbFlowControl::endOfContinuousUpdatesMessage();
+		rfbWriteExact( client, message.constData(), message.size() );
+	}
+
+	return encoding == RfbFlowControl::ContinuousUpdatesEncoding || encoding == RfbFlowControl::FenceEncoding;
+}
+
+
+
+static rfbBool handleFlowControlMessage( rfbClientPtr client, void* data, const rfbClientToServerMsg* message )
+{
+	auto headlessVncClient = static_cast<HeadlessVncClient *>( data );
+
+	switch( message->type )
+	{
+	case RfbFlowControl::ContinuousUpdatesMessageType:
+	{
+		// message type has been read already
+		QByteArray enableMessage( RfbFlowControl::EnableContinuousUpdatesMessageSize, 0 );
+		if( rfbReadExact( client, enableMessage.data() + 1, enableMessage.size() - 1 ) <= 0 )
+		{
+			rfbCloseClient( client );
+			return TRUE;
+		}
+
+		headlessVncClient->continuousUpdates = enableMessage[1] != 0;
+		headlessVncClient->continuousUpdatesRect = RfbFlowControl::continuousUpdatesRect( enableMessage );
+
+		if( headlessVncClient->continuousUpdates == false )
+		{
+			const auto endMessage = RfbFlowControl::endOfContinuousUpdatesMessage();
+			rfbWriteExact( client, endMessage.constData(), endMessage.size() );
+		}
+		return TRUE;
+	}
+
+	case RfbFlowControl::FenceMessageType:
+	{
+		QByteArray header( RfbFlowControl::FenceMessageHeaderSize, 0 );
+		if( rfbReadExact( client, header.data() + 1, header.size() - 1 ) <= 0 ||
+			RfbFlowControl::fencePayloadSize( header ) > RfbFlowControl::MaximumFencePayloadSize )
+		{
+			rfbCloseClient( client );
+			return TRUE;
+		}
+
+		QByteArray payload( RfbFlowControl::fencePayloadSize( header ), 0 );
+		if( payload.isEmpty() == false && rfbReadExact( client, payload.data(), payload.size() ) <= 0 )
+		{
+			rfbCloseClient( client );
+			return TRUE;
+		}
+
+		const auto flags = RfbFlowControl::fenceFlags( header );
+		if( flags & RfbFlowControl::FenceRequest )
+		{
+			const auto response = RfbFlowControl::fenceResponseMessage( flags, payload );
+			rfbWriteExact( client, response.constData(), response.size() );
+		}
+		return TRUE;
+	}
+
+	default:
+		break;
+	}
+
+	return FALSE;
+}
+
+
+// remember pointer position so it can be echoed in the framebuffer for measuring input latencies
+static void handlePointerEvent( int buttonMask, int x, int y, rfbClientPtr client )
+{
+	auto screen = static_cast<HeadlessVncScreen *>( client->screen->screenData );
+
+	if( screen->pointerPosition != QPoint( x, y ) )
+	{
+		screen->pointerPosition = QPoint( x, y );
+		screen->pointerMoved = true;
+	}
+
+	rfbDefaultPtrAddEvent( buttonMask, x, y, client );
+}
+
+
+
+static int flowControlPseudoEncodings[3] = { RfbFlowControl::ContinuousUpdatesEncoding, RfbFlowControl::FenceEncoding, 0 };
+
+static rfbProtocolExtension flowControlProtocolExtension = {
+	newHeadlessVncClient,
+	nullptr,
+	flowControlPseudoEncodings,
+	enableFlowControlEncoding,
+	handleFlowControlMessage,
+	closeHeadlessVncClient,
+	nullptr,
+	nullptr,
+	nullptr
+};
+
+
+
 HeadlessVncServer::HeadlessVncServer( QObject* parent ) :
 	QObject( parent ),
 	m_configuration( &VeyonCore::config() )
@@ -83,11 +228,17 @@ bool HeadlessVncServer::runServer( int serverPort, const Password& password )
 		return false;
 	}
 
-	while( true )
+	while( QThread::currentThread()->isInterruptionRequested() == false )
 	{
 		QThread::msleep( DefaultSleepTime );
 
+		handleScreenChanges( &screen );
+		handleContinuousUpdates( &screen );
+
 		rfbProcessEvents( screen.rfbScreen, 0 );
+
+		// echo pointer moves immediately instead of waiting for the next sleep cycle
+		handlePointerChanges( &screen );
 	}
 
 	rfbShutdownServer( screen.rfbScreen, true );
@@ -103,6 +254,8 @@ bool HeadlessVncServer::initScreen( HeadlessVncScreen* screen )
 	screen->framebuffer = QImage( DefaultFramebufferWidth, DefaultFramebufferHeight, QImage::Format_RGB32 );
 	screen->framebuffer.fill( m_configuration.backgroundColor() );
 
+	screen->syntheticUpdateTimer.start();
+
 	return true;
 }
 
@@ -148,6 +301,9 @@ bool HeadlessVncServer::initVncServer( int serverPort, const VncServerPluginInte
 	rfbScreen->screenData = screen;
 
 	rfbScreen->cursor = nullptr;
+	rfbScreen->ptrAddEvent = handlePointerEvent;
+
+	rfbRegisterProtocolExtension( &flowControlProtocolExtension );
 
 	rfbInitServer( rfbScreen );
 
@@ -160,6 +316,90 @@ bool HeadlessVncServer::initVncServer( int serverPort, const VncServerPluginInte
 
 
 
+bool HeadlessVncServer::handleScreenChanges( HeadlessVncScreen* screen )
+{
+	const auto syntheticUpdateInterval = m_configuration.syntheticUpdateInterval();
+
+	if( syntheticUpdateInterval <= 0 ||
+		screen->syntheticUpdateTimer.elapsed() < syntheticUpdateInterval )
+	{
+		return false;
+	}
+
+	screen->syntheticUpdateTimer.restart();
+
+	// render a moving bar so every update changes a significant part of the framebuffer
+	const auto width = screen->framebuffer.width();
+	const auto height = screen->framebuffer.height();
+	const auto barX = ( screen->syntheticFrameCount++ * SyntheticBarWidth ) % width;
+
+	QPainter painter( &screen->framebuffer );
+	painter.fillRect( screen->framebuffer.rect(), m_configuration.backgroundColor() );
+	painter.fillRect( barX, 0, SyntheticBarWidth, height, Qt::white );
+	painter.end();
+
+	FramebufferTimestamp::encode( screen->framebuffer, QDateTime::currentMSecsSinceEpoch() );
+
+	// painted over by the background
+	screen->pointerMoved = screen->pointerPosition.x() >= 0;
+	handlePointerChanges( screen );
+
+	rfbMarkRectAsModified( screen->rfbScreen, 0, 0, width, height );
+
+	return true;
+}
+
+
+
+void HeadlessVncServer::handlePointerChanges( HeadlessVncScreen* screen )
+{
+	// only echo pointer positions into synthetic framebuffers used for benchmarking
+	if( screen->pointerMoved == false ||
+		m_configuration.syntheticUpdateInterval() <= 0 )
+	{
+		return;
+	}
+
+	screen->pointerMoved = false;
+
+	constexpr auto row = FramebufferTimestamp::PointerPositionRow;
+
+	FramebufferTimestamp::encode( screen->framebuffer,
+								  FramebufferTimestamp::encodePointerPosition( screen->pointerPosition.x(),
+																			   screen->pointerPosition.y() ),
+								  row );
+
+	rfbMarkRectAsModified( screen->rfbScreen, 0, row * FramebufferTimestamp::BlockSize,
+						   FramebufferTimestamp::Width, ( row + 1 ) * FramebufferTimestamp::BlockSize );
+}
+
+
+
+void HeadlessVncServer::handleContinuousUpdates( HeadlessVncScreen* screen )
+{
+	auto iterator = rfbGetClientIterator( screen->rfbScreen );
+
+	while( auto client = rfbClientIteratorNext( iterator ) )
+	{
+		const auto headlessVncClient = static_cast<HeadlessVncClient *>(
+			rfbGetExtensionClientData( client, &flowControlProtocolExtension ) );
+
+		if( headlessVncClient && headlessVncClient->continuousUpdates )
+		{
+			// keep the region requested so that changes are sent without further update requests -
+			// sending blocks while the client does not take any data so updates can't pile up
+			const auto& rect = headlessVncClient->continuousUpdatesRect;
+			auto region = sraRgnCreateRect( rect.left(), rect.top(), rect.x() + rect.width(), rect.y() + rect.height() );
+			sraRgnOr( client->requestedRegion, region );
+			sraRgnDestroy( region );
+		}
+	}
+
+	rfbReleaseClientIterator( iterator );
+}
+
+
+
 void HeadlessVncServer::rfbLogDebug(const char* format, ...)
 {
 	va_list args;
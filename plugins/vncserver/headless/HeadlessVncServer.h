@@ -92,6 +92,11 @@ public:
 		return -1;
 	}
 
+	bool supportsMultipleInstances() const override
+	{
+		return true;
+	}
+
 	Password configuredPassword() override
 	{
 		return {};
@@ -101,12 +106,15 @@ private:
 	static constexpr auto DefaultFramebufferWidth = 640;
 	static constexpr auto DefaultFramebufferHeight = 480;
 	static constexpr auto DefaultSleepTime = 25;
+	static constexpr auto SyntheticBarWidth = 16;
 
 	bool initScreen( HeadlessVncScreen* screen );
 	bool initVncServer( int serverPort, const VncServerPluginInterface::Password& password,
 						HeadlessVncScreen* screen );
 
 	bool handleScreenChanges( HeadlessVncScreen* screen );
+	void handleContinuousUpdates( HeadlessVncScreen* screen );
+	void handlePointerChanges( HeadlessVncScreen* screen );
 
 	static void rfbLogDebug(const char* format, ...);
 	static void rfbLogNone(const char* format, ...);
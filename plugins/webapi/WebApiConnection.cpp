@@ -22,7 +22,6 @@
  *
  */
 
-#include <QImageWriter>
 #include <QTimer>
 
 #include "ComputerControlInterface.h"
@@ -40,8 +39,6 @@ WebApiConnection::WebApiConnection( const QString& hostAddress ) :
 
 WebApiConnection::~WebApiConnection()
 {
-	m_framebufferEncoder.waitForFinished();
-
 	m_idleTimer->deleteLater();
 	m_lifetimeTimer->deleteLater();
 
@@ -71,109 +68,3 @@ QSize WebApiConnection::scaledFramebufferSize( int width, int height ) const
 	return scaledSize;
 }
 
-
-
-QByteArray WebApiConnection::encodedFramebufferData( QSize size, const QByteArray& format, int compression, int quality )
-{
-	if( m_lastFramebufferRequestTimer.isValid() )
-	{
-		m_lastFramebufferRequestInterval = ( m_lastFramebufferRequestInterval + m_lastFramebufferRequestTimer.restart() ) / 2;
-	}
-	else
-	{
-		m_lastFramebufferRequestTimer.start();
-	}
-
-	m_framebufferEncoder.waitForFinished();
-
-	if( format != m_imageFormat ||
-		compression != m_imageCompression ||
-		quality != m_imageQuality ||
-		size != m_imageSize ||
-		m_framebufferEncoder.isCanceled() ||
-		m_framebufferEncoder.result().expired() )
-	{
-		m_imageFormat = format;
-		m_imageCompression = compression;
-		m_imageQuality = quality;
-		m_imageSize = size;
-
-		runFramebufferEncoder();
-
-		m_framebufferEncoder.waitForFinished();
-	}
-
-	const auto result = m_framebufferEncoder.result();
-
-	m_encodingError = result.errorString;
-
-	const auto preencodeInterval = m_lastFramebufferRequestInterval -
-								   m_framebufferEncodingTime * 125 / 100;
-
-	if( preencodeInterval >= MinimumPreencodeInterval )
-	{
-		QTimer::singleShot( preencodeInterval,
-							m_controlInterface.data(), [this]() {
-								lock();
-								runFramebufferEncoder();
-								unlock();
-							} );
-	}
-	else
-	{
-		m_framebufferEncoder = {};
-	}
-
-
-	return result.imageData;
-}
-
-
-
-void WebApiConnection::runFramebufferEncoder()
-{
-	m_framebufferEncoder = QtConcurrent::run( [this]() {
-
-		QElapsedTimer encodingTimer;
-		encodingTimer.start();
-
-		EncodingResult result;
-		QBuffer dataBuffer( &result.imageData );
-		dataBuffer.open( QBuffer::WriteOnly );
-		QImageWriter imageWriter( &dataBuffer, m_imageFormat );
-
-		if( m_imageCompression > 0 )
-		{
-			static constexpr auto QtPngCompressionLevelFactor = 11;
-
-			imageWriter.setCompression( m_imageCompression * QtPngCompressionLevelFactor );
-		}
-
-		if( m_imageQuality > 0 )
-		{
-			imageWriter.setQuality( m_imageQuality );
-		}
-
-		if( m_imageSize != m_controlInterface->scaledFramebufferSize() )
-		{
-			m_controlInterface->setScaledFramebufferSize(m_imageSize);
-		}
-
-		const auto writeResult = imageWriter.write(
-			m_imageSize.isEmpty() ?
-								 controlInterface()->framebuffer() :
-								 controlInterface()->scaledFramebuffer() );
-
-		dataBuffer.close();
-
-		if( writeResult == false )
-		{
-			result.imageData = {};
-			result.errorString = imageWriter.errorString();
-		}
-
-		m_framebufferEncodingTime = ( m_framebufferEncodingTime + encodingTimer.elapsed() ) / 2;
-
-		return result;
-	} );
-}
@@ -24,9 +24,6 @@
 
 #pragma once
 
-#include <QElapsedTimer>
-#include <QtConcurrent>
-
 #include "ComputerControlInterface.h"
 
 class ComputerControlInterface;
@@ -65,45 +62,9 @@ public:
 
 	QSize scaledFramebufferSize( int width, int height ) const;
 
-	QByteArray encodedFramebufferData( QSize size, const QByteArray& format, int compression, int quality );
-
-	const QString& framebufferEncodingError() const
-	{
-		return m_encodingError;
-	}
-
 private:
-	void runFramebufferEncoder();
-
 	ComputerControlInterface::Pointer m_controlInterface;
 	QTimer* m_idleTimer{nullptr};
 	QTimer* m_lifetimeTimer{nullptr};
 
-	QByteArray m_imageFormat{};
-	int m_imageQuality{0};
-	int m_imageCompression{0};
-	QSize m_imageSize{};
-
-	struct EncodingResult {
-		QByteArray imageData{};
-		QString errorString{};
-		qint64 timestamp{QDateTime::currentMSecsSinceEpoch()};
-
-		bool expired() const
-		{
-			static constexpr auto MaxAge = 1000;
-
-			return QDateTime::currentMSecsSinceEpoch() - timestamp > MaxAge;
-		}
-	};
-
-	static constexpr auto MinimumPreencodeInterval = 10;
-
-	QFuture<EncodingResult> m_framebufferEncoder;
-	QString m_encodingError;
-
-	QElapsedTimer m_lastFramebufferRequestTimer;
-	qint64 m_lastFramebufferRequestInterval{0};
-	QAtomicInteger<qint64> m_framebufferEncodingTime{0};
-
 };
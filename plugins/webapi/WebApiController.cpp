@@ -48,7 +48,9 @@ static QString uuidToString( QUuid uuid )
 WebApiController::WebApiController( const WebApiConfiguration& configuration, QObject* parent ) :
 	QObject( parent ),
 	m_configuration( configuration ),
-	m_connectionsLock( QReadWriteLock::Recursive )
+	m_connectionsLock( QReadWriteLock::Recursive ),
+	m_imageEncoder( new WebApiImageEncoder( configuration.imageEncoderThreadCount(),
+											configuration.imageEncoderQueueLimit(), this ) )
 {
 	connect(&m_updateStatisticsTimer, &QTimer::timeout, this, &WebApiController::updateStatistics);
 	m_updateStatisticsTimer.start(StatisticsUpdateIntervalSeconds * MillisecondsPerSecond);
@@ -295,41 +297,123 @@ WebApiController::Response WebApiController::getFramebuffer( const Request& requ
 		return checkResponse;
 	}
 
-	const auto connection = lookupConnection( request );
+	ComputerControlInterface::Pointer controlInterface;
+	WebApiImageEncoder::Settings settings;
 
-	if( connection->controlInterface()->hasValidFramebuffer() == false )
 	{
-		return Error::FramebufferNotAvailable;
+		// do not block the connection while waiting for the encoder
+		const auto connection = lookupConnection( request );
+
+		if( connection->controlInterface()->hasValidFramebuffer() == false )
+		{
+			return Error::FramebufferNotAvailable;
+		}
+
+		settings.size = connection->scaledFramebufferSize( request.data[k2s(Key::Width)].toInt(),
+														   request.data[k2s(Key::Height)].toInt() );
+		controlInterface = connection->controlInterface();
 	}
 
 	m_framebufferRequestsCounter++;
 
-	const auto width = request.data[k2s(Key::Width)].toInt();
-	const auto height = request.data[k2s(Key::Height)].toInt();
-	const auto size = connection->scaledFramebufferSize( width, height );
-
-	const auto compression = request.data[k2s(Key::Compression)].toString().toInt();
-	const auto quality = request.data[k2s(Key::Quality)].toString().toInt();
+	settings.compression = request.data[k2s(Key::Compression)].toString().toInt();
+	settings.quality = request.data[k2s(Key::Quality)].toString().toInt();
 
-	auto format = request.data[k2s(Key::Format)].toString().toUtf8();
-	if( format.isEmpty() )
+	settings.format = request.data[k2s(Key::Format)].toString().toUtf8();
+	if( settings.format.isEmpty() )
 	{
-		format = QByteArrayLiteral("png");
+		settings.format = QByteArrayLiteral("png");
 	}
 
-	if( QImageWriter::supportedImageFormats().contains( format ) == false )
+	if( QImageWriter::supportedImageFormats().contains( settings.format ) == false )
 	{
 		return Error::UnsupportedImageFormat;
 	}
 
-	const auto imageData = connection->encodedFramebufferData( size, format, compression, quality );
+	auto encoding = m_imageEncoder->encode( controlInterface, settings );
+	if( encoding.isCanceled() )
+	{
+		return Error::ImageEncoderBusy;
+	}
+
+	encoding.waitForFinished();
 
-	if( imageData.isNull() )
+	const auto result = encoding.result();
+	if( result.imageData.isEmpty() )
 	{
-		return { Error::FramebufferEncodingError, connection->framebufferEncodingError() };
+		return { Error::FramebufferEncodingError, result.errorString };
 	}
 
-	return imageData;
+	return result.imageData;
+}
+
+
+
+WebApiController::Response WebApiController::openFramebufferStream( const Request& request,
+																	ComputerControlInterface::Pointer& controlInterface,
+																	WebApiFramebufferStream::Settings& settings )
+{
+	m_apiTotalRequestsCounter++;
+
+	Response checkResponse{};
+	if( ( checkResponse = checkConnection( request ) ).error != Error::NoError )
+	{
+		return checkResponse;
+	}
+
+	{
+		// release the connection lock before the stream starts encoding frames
+		const auto connection = lookupConnection( request );
+
+		if( connection->controlInterface()->hasValidFramebuffer() == false )
+		{
+			return Error::FramebufferNotAvailable;
+		}
+
+		settings.size = connection->scaledFramebufferSize( request.data[k2s(Key::Width)].toInt(),
+														   request.data[k2s(Key::Height)].toInt() );
+		controlInterface = connection->controlInterface();
+	}
+
+	m_framebufferRequestsCounter++;
+
+	settings.compression = request.data[k2s(Key::Compression)].toString().toInt();
+	settings.quality = request.data[k2s(Key::Quality)].toString().toInt();
+
+	settings.format = request.data[k2s(Key::Format)].toString().toUtf8();
+	if( settings.format.isEmpty() )
+	{
+		settings.format = QByteArrayLiteral("jpeg");
+	}
+
+	if( QImageWriter::supportedImageFormats().contains( settings.format ) == false )
+	{
+		return Error::UnsupportedImageFormat;
+	}
+
+	const auto frameRate = request.data[k2s(Key::FrameRate)].toString().toInt();
+	if( frameRate > 0 )
+	{
+		settings.frameRate = qMin( frameRate, int(WebApiFramebufferStream::MaximumFrameRate) );
+	}
+
+	return {};
+}
+
+
+
+void WebApiController::keepFramebufferStreamAlive( const Request& request )
+{
+	const QUuid connectionUuid{lookupHeaderField(request, connectionUidHeaderFieldName())};
+
+	runInWorkerThreadNonBlocking([=] {
+		QReadLocker connectionsReadLocker{&m_connectionsLock};
+		const auto connection = m_connections.value(connectionUuid);
+		if( connection )
+		{
+			connection->idleTimer()->start();
+		}
+	});
 }
 
 
@@ -478,6 +562,7 @@ QString WebApiController::getStatistics()
 	return QStringLiteral("Total API requests: %1 (%2/s in the past %3 s)\n<br/>").arg(m_apiTotalRequestsCounter).arg(m_apiTotalRequestsPerSecond).arg(StatisticsUpdateIntervalSeconds) +
 			QStringLiteral("Framebuffer requests: %1 (%2/s in the past %3 s)\n<br/>").arg(m_framebufferRequestsCounter).arg(m_framebufferRequestsPerSecond).arg(StatisticsUpdateIntervalSeconds) +
 			QStringLiteral("VNC framebuffer updates: %1 (%2/s in the past %3 s)\n<br/>").arg(m_vncFramebufferUpdatesCounter).arg(m_vncFramebufferUpdatesPerSecond).arg(StatisticsUpdateIntervalSeconds) +
+			QStringLiteral("Image encodings: %1 (%2 shared, %3 rejected, %4 / %5 pending, %6 threads)\n<br/>").arg(m_imageEncoder->encodingCount()).arg(m_imageEncoder->sharedCount()).arg(m_imageEncoder->rejectedCount()).arg(m_imageEncoder->pendingCount()).arg(m_imageEncoder->queueLimit()).arg(m_imageEncoder->threadCount()) +
 			QStringLiteral("Number of client connections: %1<br/>\n").arg(m_connections.count());
 }
 
@@ -552,6 +637,7 @@ QString WebApiController::errorString( WebApiController::Error error )
 	case Error::FramebufferNotAvailable: return QStringLiteral("Framebuffer not yet available");
 	case Error::FramebufferEncodingError: return QStringLiteral("Framebuffer encoding error");
 	case Error::ProtocolMismatch: return QStringLiteral("Protocol mismatch error");
+	case Error::ImageEncoderBusy: return QStringLiteral("All image encoders busy");
 	}
 
 	return {};
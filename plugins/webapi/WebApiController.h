@@ -30,6 +30,8 @@
 #include "EnumHelper.h"
 #include "LockingPointer.h"
 #include "WebApiConnection.h"
+#include "WebApiFramebufferStream.h"
+#include "WebApiImageEncoder.h"
 
 #define waDebug() if (VeyonCore::isDebugging()==false); else qDebug() << "[WebAPI]"
 
@@ -50,6 +52,7 @@ public:
 		Quality,
 		Width,
 		Height,
+		FrameRate,
 		Feature,
 		Name,
 		Uid,
@@ -82,6 +85,7 @@ public:
 		FramebufferNotAvailable,
 		FramebufferEncodingError,
 		ProtocolMismatch,
+		ImageEncoderBusy,
 	};
 
 	struct Request
@@ -120,6 +124,9 @@ public:
 	Response closeConnection( const Request& request, const QString& host );
 
 	Response getFramebuffer( const Request& request );
+	Response openFramebufferStream( const Request& request, ComputerControlInterface::Pointer& controlInterface,
+									WebApiFramebufferStream::Settings& settings );
+	void keepFramebufferStreamAlive( const Request& request );
 
 	Response listFeatures( const Request& request );
 	Response setFeatureStatus( const Request& request, const QString& feature );
@@ -134,6 +141,11 @@ public:
 
 	static QString errorString( Error error );
 
+	WebApiImageEncoder* imageEncoder() const
+	{
+		return m_imageEncoder;
+	}
+
 private:
 	void runInWorkerThread(const std::function<void()>& functor) const;
 	void runInWorkerThreadNonBlocking(const std::function<void()>& functor) const;
@@ -176,6 +188,8 @@ private:
 	QMap<QUuid, WebApiConnectionPointer> m_connections{};
 	QReadWriteLock m_connectionsLock;
 
+	WebApiImageEncoder* m_imageEncoder{nullptr};
+
 	QThread* m_workerThread = nullptr;
 	QObject* m_workerObject = nullptr;
 
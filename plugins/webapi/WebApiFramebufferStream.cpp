@@ -0,0 +1,248 @@
+/*
+ * WebApiFramebufferStream.cpp - implementation of WebApiFramebufferStream class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QTcpSocket>
+
+#include "WebApiFramebufferStream.h"
+
+
+WebApiFramebufferStream::WebApiFramebufferStream( QHttpServerResponder&& responder,
+												  QTcpSocket* socket,
+												  const ComputerControlInterface::Pointer& controlInterface,
+												  const Settings& settings,
+												  WebApiImageEncoder* imageEncoder,
+												  QObject* parent ) :
+	QObject( parent ),
+	m_responder( std::move(responder) ),
+	m_socket( socket ),
+	m_controlInterface( controlInterface ),
+	m_settings( settings ),
+	m_imageEncoder( imageEncoder )
+{
+	const auto contentType = QByteArrayLiteral("multipart/x-mixed-replace; boundary=") + boundary();
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	QHttpHeaders headers;
+	headers.append( QHttpHeaders::WellKnownHeader::ContentType, contentType );
+	headers.append( QHttpHeaders::WellKnownHeader::CacheControl, QByteArrayLiteral("no-cache") );
+	m_responder.writeBeginChunked( headers );
+#else
+	m_responder.writeStatusLine();
+	m_responder.writeHeader( QByteArrayLiteral("Content-Type"), contentType );
+	m_responder.writeHeader( QByteArrayLiteral("Cache-Control"), QByteArrayLiteral("no-cache") );
+	m_responder.writeHeader( QByteArrayLiteral("Connection"), QByteArrayLiteral("close") );
+	m_responder.socket()->write( "\r\n" );
+#endif
+
+	if( m_socket )
+	{
+		connect( m_socket, &QTcpSocket::disconnected, this, &WebApiFramebufferStream::finish );
+		// resume sending frames once a slow client has caught up
+		connect( m_socket, &QTcpSocket::bytesWritten, this, [this]() {
+			if( m_updatePending )
+			{
+				handleFramebufferUpdate();
+			}
+		} );
+	}
+	else
+	{
+		// neither disconnects nor slow clients can be detected so do not stream forever
+		m_lifetimeTimer.setSingleShot( true );
+		connect( &m_lifetimeTimer, &QTimer::timeout, this, &WebApiFramebufferStream::finish );
+		m_lifetimeTimer.start( MaximumUnmonitoredLifetime );
+	}
+
+	m_frameTimer.setSingleShot( true );
+	connect( &m_frameTimer, &QTimer::timeout, this, &WebApiFramebufferStream::handleFramebufferUpdate );
+
+	connect( &m_encoder, &QFutureWatcherBase::finished, this, &WebApiFramebufferStream::sendFrame );
+
+	connect( controlInterface.data(), &ComputerControlInterface::framebufferUpdated,
+			 this, &WebApiFramebufferStream::handleFramebufferUpdate );
+	connect( controlInterface.data(), &ComputerControlInterface::stateChanged,
+			 this, &WebApiFramebufferStream::handleStateChange );
+	// ComputerControlInterface::stop() does not emit stateChanged() when the connection is closed or expires
+	connect( controlInterface.data(), &QObject::destroyed, this, &WebApiFramebufferStream::finish );
+
+	// resend the current frame if the screen does not change so the connection does not become idle
+	connect( &m_keepaliveTimer, &QTimer::timeout, this, [this]() {
+		if( m_lastFrameTimer.isValid() && m_lastFrameTimer.elapsed() >= KeepaliveInterval )
+		{
+			handleFramebufferUpdate();
+		}
+	} );
+	m_keepaliveTimer.start( KeepaliveInterval );
+
+	encodeFrame();
+}
+
+
+
+WebApiFramebufferStream::~WebApiFramebufferStream()
+{
+	m_encoder.waitForFinished();
+}
+
+
+
+void WebApiFramebufferStream::handleFramebufferUpdate()
+{
+	m_updatePending = true;
+
+	if( m_finished || m_encoder.isRunning() || m_frameTimer.isActive() )
+	{
+		return;
+	}
+
+	const auto elapsed = m_lastFrameTimer.isValid() ? m_lastFrameTimer.elapsed() : frameInterval();
+	if( elapsed < frameInterval() )
+	{
+		m_frameTimer.start( int(frameInterval() - elapsed) );
+		return;
+	}
+
+	if( isClientBusy() == false )
+	{
+		encodeFrame();
+	}
+}
+
+
+
+void WebApiFramebufferStream::handleStateChange()
+{
+	const auto controlInterface = m_controlInterface.toStrongRef();
+	if( controlInterface.isNull() ||
+		controlInterface->state() != ComputerControlInterface::State::Connected )
+	{
+		finish();
+	}
+}
+
+
+
+void WebApiFramebufferStream::encodeFrame()
+{
+	const auto controlInterface = m_controlInterface.toStrongRef();
+	if( controlInterface.isNull() )
+	{
+		finish();
+		return;
+	}
+
+	m_updatePending = false;
+	m_lastFrameTimer.start();
+
+	const auto encoding = m_imageEncoder->encode( controlInterface, { m_settings.size, m_settings.format,
+																	  m_settings.compression, m_settings.quality } );
+	if( encoding.isCanceled() )
+	{
+		// all encoders busy - try again with the next frame
+		m_updatePending = true;
+		m_frameTimer.start( frameInterval() );
+		return;
+	}
+
+	m_encoder.setFuture( encoding );
+}
+
+
+
+void WebApiFramebufferStream::sendFrame()
+{
+	if( m_finished )
+	{
+		return;
+	}
+
+	const auto result = m_encoder.result();
+	const auto& imageData = result.imageData;
+	if( imageData.isEmpty() )
+	{
+		vWarning() << "failed to encode framebuffer:" << result.errorString;
+		finish();
+		return;
+	}
+
+	const auto mimeSubtype = m_settings.format == "jpg" ? QByteArrayLiteral("jpeg") : m_settings.format;
+
+	const auto part = QByteArrayLiteral("--") + boundary() + QByteArrayLiteral("\r\n") +
+					  QByteArrayLiteral("Content-Type: image/") + mimeSubtype + QByteArrayLiteral("\r\n") +
+					  QByteArrayLiteral("Content-Length: ") + QByteArray::number( imageData.size() ) +
+					  QByteArrayLiteral("\r\n\r\n") + imageData + QByteArrayLiteral("\r\n");
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	m_responder.writeChunk( part );
+#else
+	m_responder.socket()->write( part );
+#endif
+
+	// keep the connection alive only as long as the client keeps up with the frames
+	if( isClientBusy() == false &&
+		( m_lastKeepaliveTimer.isValid() == false || m_lastKeepaliveTimer.elapsed() >= KeepaliveInterval ) )
+	{
+		m_lastKeepaliveTimer.start();
+		Q_EMIT keepalive();
+	}
+
+	if( m_updatePending )
+	{
+		handleFramebufferUpdate();
+	}
+}
+
+
+
+void WebApiFramebufferStream::finish()
+{
+	if( m_finished )
+	{
+		return;
+	}
+
+	m_finished = true;
+	m_frameTimer.stop();
+	m_keepaliveTimer.stop();
+	m_lifetimeTimer.stop();
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	m_responder.writeEndChunked( QByteArray() );
+#else
+	const auto socket = m_responder.socket();
+	if( socket && socket->state() == QTcpSocket::ConnectedState )
+	{
+		socket->disconnectFromHost();
+	}
+#endif
+
+	deleteLater();
+}
+
+
+
+bool WebApiFramebufferStream::isClientBusy() const
+{
+	return m_socket && m_socket->bytesToWrite() > MaximumPendingBytes;
+}
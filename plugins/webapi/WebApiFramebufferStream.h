@@ -0,0 +1,106 @@
+/*
+ * WebApiFramebufferStream.h - declaration of WebApiFramebufferStream class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QtHttpServer/qhttpserverresponder.h>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QTimer>
+
+#include "ComputerControlInterface.h"
+#include "WebApiImageEncoder.h"
+
+// pushes encoded framebuffers of a WebAPI connection as multipart/x-mixed-replace
+// response (e.g. MJPEG) whenever the framebuffer has been updated, limited to a
+// maximum frame rate - lives in the thread of the HTTP server
+class WebApiFramebufferStream : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr auto DefaultFrameRate = 5;
+	static constexpr auto MaximumFrameRate = 30;
+
+	struct Settings
+	{
+		QSize size{};
+		QByteArray format{};
+		int compression{0};
+		int quality{0};
+		int frameRate{DefaultFrameRate};
+	};
+
+	// without a socket to monitor, the stream ends after a maximum lifetime
+	WebApiFramebufferStream( QHttpServerResponder&& responder,
+							 QTcpSocket* socket,
+							 const ComputerControlInterface::Pointer& controlInterface,
+							 const Settings& settings,
+							 WebApiImageEncoder* imageEncoder,
+							 QObject* parent = nullptr );
+	~WebApiFramebufferStream() override;
+
+Q_SIGNALS:
+	// emitted periodically while frames are delivered to the client
+	void keepalive();
+
+private:
+	static constexpr auto MillisecondsPerSecond = 1000;
+	static constexpr auto KeepaliveInterval = 5000;
+	static constexpr auto MaximumPendingBytes = 4 * 1024 * 1024;
+	static constexpr auto MaximumUnmonitoredLifetime = 10 * 60 * 1000;
+
+	static QByteArray boundary()
+	{
+		return QByteArrayLiteral("VeyonFramebuffer");
+	}
+
+	void handleFramebufferUpdate();
+	void handleStateChange();
+	void encodeFrame();
+	void sendFrame();
+	void finish();
+
+	bool isClientBusy() const;
+	int frameInterval() const
+	{
+		return MillisecondsPerSecond / m_settings.frameRate;
+	}
+
+	QHttpServerResponder m_responder;
+	QPointer<QTcpSocket> m_socket;
+	QWeakPointer<ComputerControlInterface> m_controlInterface;
+	const Settings m_settings;
+	WebApiImageEncoder* m_imageEncoder;
+
+	QFutureWatcher<WebApiImageEncoder::Result> m_encoder;
+	QElapsedTimer m_lastFrameTimer;
+	QElapsedTimer m_lastKeepaliveTimer;
+	QTimer m_frameTimer{this};
+	QTimer m_keepaliveTimer{this};
+	QTimer m_lifetimeTimer{this};
+	bool m_updatePending{true};
+	bool m_finished{false};
+
+};
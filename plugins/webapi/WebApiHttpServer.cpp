@@ -29,6 +29,8 @@
 #include <QJsonDocument>
 #include <QSslCertificate>
 #include <QSslKey>
+#include <QTcpSocket>
+#include <QtConcurrent>
 #if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
 #include <QSslServer>
 #endif
@@ -113,6 +115,7 @@ static QHttpServerResponse convertResponse(const WebApiController::Request& requ
 		case WebApiController::Error::FramebufferNotAvailable: return QHttpServerResponse::StatusCode::ServiceUnavailable;
 		case WebApiController::Error::FramebufferEncodingError: return QHttpServerResponse::StatusCode::InternalServerError;
 		case WebApiController::Error::ProtocolMismatch: return QHttpServerResponse::StatusCode::NotImplemented;
+		case WebApiController::Error::ImageEncoderBusy: return QHttpServerResponse::StatusCode::ServiceUnavailable;
 		}
 		return QHttpServerResponse::StatusCode::BadRequest;
 	}();
@@ -129,11 +132,26 @@ static QHttpServerResponse convertResponse(const WebApiController::Request& requ
 
 	waDebug() << "[RESP] [ERROR]" << request.path.toUtf8().constData() << errorObject << int(statusCode);
 
-	return {
+	QHttpServerResponse errorResponse{
 		QByteArrayLiteral("application/json"),
 		QJsonDocument{ QJsonObject{ { QStringLiteral("error"), errorObject } } }.toJson( QJsonDocument::Compact ),
 		statusCode
 	};
+
+	if( response.error == WebApiController::Error::ImageEncoderBusy )
+	{
+		// let clients back off instead of immediately repeating the request
+		static constexpr auto ImageEncoderBusyRetryAfterSeconds = 1;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+		auto headers = errorResponse.headers();
+		headers.append( QHttpHeaders::WellKnownHeader::RetryAfter, QByteArray::number( ImageEncoderBusyRetryAfterSeconds ) );
+		errorResponse.setHeaders( std::move(headers) );
+#else
+		errorResponse.addHeader( QByteArrayLiteral("Retry-After"), QByteArray::number( ImageEncoderBusyRetryAfterSeconds ) );
+#endif
+	}
+
+	return errorResponse;
 }
 
 
@@ -329,6 +347,7 @@ bool WebApiHttpServer::start()
 	success &= addRoute<Method::Post>( QStringLiteral("authentication/<arg>"), &WebApiController::performAuthentication );
 	success &= addRoute<Method::Delete>( QStringLiteral("authentication/<arg>"), &WebApiController::closeConnection );
 	success &= addRoute<Method::Get>( QStringLiteral("framebuffer"), &WebApiController::getFramebuffer );
+	success &= addFramebufferStreamRoute();
 	success &= addRoute<Method::Get>( QStringLiteral("feature"), &WebApiController::listFeatures );
 	success &= addRoute<Method::Get>( QStringLiteral("feature/<arg>"), &WebApiController::getFeatureStatus );
 	success &= addRoute<Method::Put>( QStringLiteral("feature/<arg>"), &WebApiController::setFeatureStatus );
@@ -356,6 +375,104 @@ bool WebApiHttpServer::start()
 
 
 
+bool WebApiHttpServer::addFramebufferStreamRoute()
+{
+	return bool(m_server->route( QStringLiteral("/api/v1/framebuffer/stream"), QHttpServerRequest::Method::Get,
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+		[this](const QHttpServerRequest& request, QHttpServerResponder& responder) {
+#else
+		[this](const QHttpServerRequest& request, QHttpServerResponder&& responder) {
+#endif
+			startFramebufferStream( request, std::move(responder) );
+		} ));
+}
+
+
+
+void WebApiHttpServer::startFramebufferStream( const QHttpServerRequest& request, QHttpServerResponder&& responder )
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	const auto headers = request.headers().toListOfPairs();
+#else
+	const auto headers = request.headers();
+#endif
+	const auto controllerRequest = WebApiController::Request{ QStringLiteral("framebuffer/stream"), headers,
+															  dataFromRequest<Method::Get>( request ) };
+
+	if( m_threadPool.activeThreadCount() >= m_threadPool.maxThreadCount() )
+	{
+		responder.sendResponse( convertResponse( controllerRequest, WebApiController::Error::ConnectionLimitReached ) );
+		return;
+	}
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	const QPointer<QTcpSocket> socket = findClientSocket( request );
+#else
+	const QPointer<QTcpSocket> socket = responder.socket();
+#endif
+
+	// the responder has to outlive this function while the connection is looked up
+	const auto sharedResponder = std::make_shared<QHttpServerResponder>( std::move(responder) );
+
+	// looking up the connection may block so do it in the thread pool like for all other requests
+	auto watcher = new QFutureWatcher<FramebufferStreamSetup>( this );
+	connect( watcher, &QFutureWatcherBase::finished, this, [=]() {
+		watcher->deleteLater();
+
+		const auto setup = watcher->result();
+		if( setup.response.error != WebApiController::Error::NoError )
+		{
+			sharedResponder->sendResponse( convertResponse( controllerRequest, setup.response ) );
+			return;
+		}
+
+		waDebug() << "[STREAM] [START]" << controllerRequest.path.toUtf8().constData()
+				  << toJson(controllerRequest.headers).constData();
+
+		// the stream deletes itself once the client disconnects or the connection is closed
+		auto stream = new WebApiFramebufferStream( std::move(*sharedResponder), socket,
+												   setup.controlInterface, setup.settings,
+												   m_controller->imageEncoder(), this );
+		connect( stream, &WebApiFramebufferStream::keepalive, m_controller, [this, controllerRequest]() {
+			m_controller->keepFramebufferStreamAlive( controllerRequest );
+		} );
+		connect( stream, &QObject::destroyed, m_controller, [controllerRequest]() {
+			waDebug() << "[STREAM] [END]" << controllerRequest.path.toUtf8().constData();
+		} );
+	} );
+
+	watcher->setFuture( QtConcurrent::run( &m_threadPool, [this, controllerRequest]() {
+		FramebufferStreamSetup setup;
+		setup.response = m_controller->openFramebufferStream( controllerRequest, setup.controlInterface, setup.settings );
+		return setup;
+	} ) );
+}
+
+
+
+QTcpSocket* WebApiHttpServer::findClientSocket( const QHttpServerRequest& request ) const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+	// QHttpServerResponder does not provide access to the socket anymore, however
+	// the sockets of all client connections are (indirect) children of the server
+	const auto sockets = m_server->findChildren<QTcpSocket *>();
+	for( auto socket : sockets )
+	{
+		if( socket->peerPort() == request.remotePort() &&
+			socket->peerAddress() == request.remoteAddress() )
+		{
+			return socket;
+		}
+	}
+#else
+	Q_UNUSED(request)
+#endif
+
+	return nullptr;
+}
+
+
+
 bool WebApiHttpServer::setupTls()
 {
 	QFile certFile( VeyonCore::filesystem().expandPath( m_configuration.tlsCertificateFile() ) );
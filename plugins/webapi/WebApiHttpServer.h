@@ -30,7 +30,9 @@
 
 class QHttpServer;
 class QHttpServerRequest;
+class QHttpServerResponder;
 class QTcpServer;
+class QTcpSocket;
 class WebApiConfiguration;
 
 class WebApiHttpServer : public QObject
@@ -60,6 +62,17 @@ private:
 				  WebApiController::Response(WebApiController::* controllerMethod)( const WebApiController::Request& request,
 																					  Args... args ) );
 
+	struct FramebufferStreamSetup
+	{
+		WebApiController::Response response{};
+		ComputerControlInterface::Pointer controlInterface;
+		WebApiFramebufferStream::Settings settings;
+	};
+
+	bool addFramebufferStreamRoute();
+	void startFramebufferStream( const QHttpServerRequest& request, QHttpServerResponder&& responder );
+	QTcpSocket* findClientSocket( const QHttpServerRequest& request ) const;
+
 	QString getDebugInformation();
 
 	const WebApiConfiguration& m_configuration;
@@ -0,0 +1,253 @@
+/*
+ * WebApiImageEncoder.cpp - implementation of WebApiImageEncoder class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QBuffer>
+#include <QImageWriter>
+#include <QtConcurrent>
+
+#include "WebApiImageEncoder.h"
+
+
+WebApiImageEncoder::WebApiImageEncoder( int threadCount, int queueLimit, QObject* parent ) :
+	QObject( parent ),
+	m_queueLimit( qMax( queueLimit, 1 ) )
+{
+	m_threadPool.setObjectName( QStringLiteral("WebApiImageEncoder") );
+	m_threadPool.setMaxThreadCount( threadCount > 0 ? threadCount : QThread::idealThreadCount() );
+}
+
+
+
+WebApiImageEncoder::~WebApiImageEncoder()
+{
+	m_threadPool.waitForDone();
+}
+
+
+
+QFuture<WebApiImageEncoder::Result> WebApiImageEncoder::encode( const ComputerControlInterface::Pointer& controlInterface,
+																 const Settings& settings )
+{
+	const auto controlInterfaceId = quintptr( controlInterface.data() );
+
+	// read the generation before grabbing the framebuffer so the fingerprint is never older
+	const auto framebufferGeneration = controlInterface->framebufferGeneration();
+	const auto image = controlInterface->framebuffer();
+
+	QString host;
+	quint64 imageFingerprint = 0;
+	bool fingerprintValid = false;
+
+	{
+		QMutexLocker locker( &m_cacheMutex );
+
+		auto source = m_controlInterfaceSources.find( controlInterfaceId );
+
+		// a new computer control interface may be allocated at the same address later on
+		if( source == m_controlInterfaceSources.end() )
+		{
+			source = m_controlInterfaceSources.insert( controlInterfaceId, {} );
+			source->host = controlInterface->computer().hostName();
+			source->connection = connect( controlInterface.data(), &QObject::destroyed, this,
+										  [this, controlInterfaceId]() { removeControlInterface( controlInterfaceId ); },
+										  Qt::DirectConnection );
+		}
+
+		host = source->host;
+
+		if( source->framebufferGeneration == framebufferGeneration )
+		{
+			imageFingerprint = source->fingerprint;
+			fingerprintValid = true;
+		}
+	}
+
+	if( fingerprintValid == false )
+	{
+		imageFingerprint = fingerprint( image );
+
+		QMutexLocker locker( &m_cacheMutex );
+		const auto source = m_controlInterfaceSources.find( controlInterfaceId );
+		if( source != m_controlInterfaceSources.end() )
+		{
+			source->framebufferGeneration = framebufferGeneration;
+			source->fingerprint = imageFingerprint;
+		}
+	}
+
+	return encode( host, imageFingerprint, image, settings );
+}
+
+
+
+void WebApiImageEncoder::removeControlInterface( quintptr controlInterfaceId )
+{
+	QMutexLocker locker( &m_cacheMutex );
+
+	const auto source = m_controlInterfaceSources.take( controlInterfaceId );
+	if( source.connection )
+	{
+		disconnect( source.connection );
+	}
+
+	// keep encodings as long as other connections to the same host exist
+	for( const auto& otherSource : std::as_const(m_controlInterfaceSources) )
+	{
+		if( otherSource.host == source.host )
+		{
+			return;
+		}
+	}
+
+	const auto keyPrefix = source.host.toUtf8() + '/';
+
+	for( auto it = m_cache.begin(); it != m_cache.end(); )
+	{
+		if( it.key().startsWith( keyPrefix ) )
+		{
+			it = m_cache.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+
+WebApiImageEncoder::Result WebApiImageEncoder::encodeImage( const QImage& image, const Settings& settings )
+{
+	Result result;
+	QBuffer dataBuffer( &result.imageData );
+	dataBuffer.open( QBuffer::WriteOnly );
+	QImageWriter imageWriter( &dataBuffer, settings.format );
+
+	if( settings.compression > 0 )
+	{
+		static constexpr auto QtPngCompressionLevelFactor = 11;
+
+		imageWriter.setCompression( settings.compression * QtPngCompressionLevelFactor );
+	}
+
+	if( settings.quality > 0 )
+	{
+		imageWriter.setQuality( settings.quality );
+	}
+
+	const auto writeResult = imageWriter.write( settings.size.isEmpty() || settings.size == image.size() ?
+													image :
+													image.scaled( settings.size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation ) );
+
+	dataBuffer.close();
+
+	if( writeResult == false )
+	{
+		result.imageData = {};
+		result.errorString = imageWriter.errorString();
+	}
+
+	return result;
+}
+
+
+
+QByteArray WebApiImageEncoder::cacheKey( const QString& source, const Settings& settings )
+{
+	return source.toUtf8() + '/' +
+		   QByteArray::number( settings.size.width() ) + 'x' + QByteArray::number( settings.size.height() ) + '/' +
+		   settings.format + '/' +
+		   QByteArray::number( settings.compression ) + '/' +
+		   QByteArray::number( settings.quality );
+}
+
+
+
+quint64 WebApiImageEncoder::fingerprint( const QImage& image )
+{
+	// include the geometry so framebuffers of different sizes never match
+	const auto seed = uint( image.width() ) * 65599u + uint( image.height() );
+
+	return quint64( qHashBits( image.constBits(), size_t( image.sizeInBytes() ), seed ) );
+}
+
+
+
+QFuture<WebApiImageEncoder::Result> WebApiImageEncoder::encode( const QString& source, quint64 generation,
+																 const QImage& image, const Settings& settings )
+{
+	const auto key = cacheKey( source, settings );
+
+	QMutexLocker locker( &m_cacheMutex );
+
+	// share pending or finished encodings of the same framebuffer update
+	const auto entry = m_cache.constFind( key );
+	if( entry != m_cache.constEnd() && entry->generation == generation )
+	{
+		++m_sharedCount;
+		return entry->future;
+	}
+
+	if( m_pendingCount >= m_queueLimit )
+	{
+		++m_rejectedCount;
+		return {};
+	}
+
+	if( m_cache.size() >= MaximumCacheSize )
+	{
+		removeFinishedEntries();
+	}
+
+	++m_pendingCount;
+	++m_encodingCount;
+
+	const auto future = QtConcurrent::run( &m_threadPool, [this, image, settings]() {
+		const auto result = encodeImage( image, settings );
+		--m_pendingCount;
+		return result;
+	} );
+
+	// replaces the encoding of a previous framebuffer update
+	m_cache[key] = { generation, future };
+
+	return future;
+}
+
+
+
+void WebApiImageEncoder::removeFinishedEntries()
+{
+	for( auto it = m_cache.begin(); it != m_cache.end(); )
+	{
+		if( it->future.isFinished() )
+		{
+			it = m_cache.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
@@ -0,0 +1,141 @@
+/*
+ * WebApiImageEncoder.h - declaration of WebApiImageEncoder class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <atomic>
+#include <limits>
+
+#include "ComputerControlInterface.h"
+
+// encodes framebuffers of all WebAPI connections and framebuffer streams in a shared thread
+// pool with a bounded number of pending encodings - identical requests for the same
+// framebuffer content of a host (same size, format, compression and quality) share a single
+// encoding, even across different connections to the host, which is kept until the next
+// framebuffer update
+class WebApiImageEncoder : public QObject
+{
+	Q_OBJECT
+public:
+	struct Settings
+	{
+		QSize size{};
+		QByteArray format{};
+		int compression{0};
+		int quality{0};
+	};
+
+	struct Result
+	{
+		QByteArray imageData{};
+		QString errorString{};
+	};
+
+	explicit WebApiImageEncoder( int threadCount, int queueLimit, QObject* parent = nullptr );
+	~WebApiImageEncoder() override;
+
+	// returns a canceled future if the maximum number of pending encodings has been reached
+	QFuture<Result> encode( const ComputerControlInterface::Pointer& controlInterface, const Settings& settings );
+	QFuture<Result> encode( const QString& source, quint64 generation, const QImage& image, const Settings& settings );
+
+	static Result encodeImage( const QImage& image, const Settings& settings );
+
+	int threadCount() const
+	{
+		return m_threadPool.maxThreadCount();
+	}
+
+	int queueLimit() const
+	{
+		return m_queueLimit;
+	}
+
+	int pendingCount() const
+	{
+		return m_pendingCount;
+	}
+
+	qint64 encodingCount() const
+	{
+		return m_encodingCount;
+	}
+
+	qint64 sharedCount() const
+	{
+		return m_sharedCount;
+	}
+
+	qint64 rejectedCount() const
+	{
+		return m_rejectedCount;
+	}
+
+private:
+	static constexpr auto MaximumCacheSize = 1024;
+
+	static constexpr auto UnknownFramebufferGeneration = std::numeric_limits<quint64>::max();
+
+	struct CacheEntry
+	{
+		quint64 generation{0};
+		QFuture<Result> future;
+	};
+
+	// framebuffer generations of different connections to the same host are not comparable,
+	// therefore framebuffer contents are identified by a fingerprint which is computed
+	// once per framebuffer update of each connection
+	struct ControlInterfaceSource
+	{
+		QString host;
+		quint64 framebufferGeneration{UnknownFramebufferGeneration};
+		quint64 fingerprint{0};
+		QMetaObject::Connection connection;
+	};
+
+	static QByteArray cacheKey( const QString& source, const Settings& settings );
+	static quint64 fingerprint( const QImage& image );
+
+	void removeControlInterface( quintptr controlInterfaceId );
+	void removeFinishedEntries();
+
+	const int m_queueLimit;
+
+	QThreadPool m_threadPool{this};
+
+	QMutex m_cacheMutex;
+	QHash<QByteArray, CacheEntry> m_cache;
+	QHash<quintptr, ControlInterfaceSource> m_controlInterfaceSources;
+
+	std::atomic<int> m_pendingCount{0};
+	std::atomic<qint64> m_encodingCount{0};
+	std::atomic<qint64> m_sharedCount{0};
+	std::atomic<qint64> m_rejectedCount{0};
+
+};
@@ -23,8 +23,14 @@
  */
 
 #include "CommandLineIO.h"
+#ifdef VEYON_DEBUG
+#include "CommandLineBenchmark.h"
+#endif
 #include "WebApiConfigurationPage.h"
 #include "WebApiHttpServer.h"
+#ifdef VEYON_DEBUG
+#include "WebApiImageEncoder.h"
+#endif
 #include "WebApiPlugin.h"
 
 
@@ -33,7 +39,10 @@ WebApiPlugin::WebApiPlugin( QObject* parent ) :
 	m_configuration( &VeyonCore::config() ),
 	m_httpServerThread( this ),
 	m_commands( {
-		{ QStringLiteral("runserver"), tr( "Run WebAPI server" ) }
+		{ QStringLiteral("runserver"), tr( "Run WebAPI server" ) },
+#ifdef VEYON_DEBUG
+		{ QStringLiteral("imageencoderbenchmark"), QStringLiteral( "benchmark framebuffer encoding for many concurrent clients with arguments [CLIENTS] [HOSTS] [FRAMES] [QUEUE LIMIT]" ) },
+#endif
 	} )
 {
 	if( VeyonCore::component() == VeyonCore::Component::Service &&
@@ -84,6 +93,126 @@ CommandLinePluginInterface::RunResult WebApiPlugin::handle_runserver( const QStr
 
 
 
+#ifdef VEYON_DEBUG
+CommandLinePluginInterface::RunResult WebApiPlugin::handle_imageencoderbenchmark( const QStringList& arguments )
+{
+	static constexpr auto DefaultClientCount = 50;
+	static constexpr auto DefaultHostCount = 5;
+	static constexpr auto DefaultFrameCount = 10;
+	static constexpr auto DefaultQueueLimit = 32;
+	static constexpr auto FramebufferWidth = 1920;
+	static constexpr auto FramebufferHeight = 1080;
+
+	const auto clientCount = arguments.value( 0, QString::number( DefaultClientCount ) ).toInt();
+	const auto hostCount = arguments.value( 1, QString::number( DefaultHostCount ) ).toInt();
+	const auto frameCount = arguments.value( 2, QString::number( DefaultFrameCount ) ).toInt();
+	const auto queueLimit = arguments.value( 3, QString::number( DefaultQueueLimit ) ).toInt();
+
+	if( clientCount <= 0 || hostCount <= 0 || frameCount <= 0 || queueLimit <= 0 )
+	{
+		return InvalidArguments;
+	}
+
+	// use noisy framebuffers so encoding takes a realistic amount of time
+	QList<QImage> framebuffers;
+	quint32 seed = 1;
+	for( int host = 0; host < hostCount; ++host )
+	{
+		QImage framebuffer( FramebufferWidth, FramebufferHeight, QImage::Format_RGB32 );
+		for( int y = 0; y < framebuffer.height(); ++y )
+		{
+			auto line = reinterpret_cast<QRgb *>( framebuffer.scanLine( y ) );
+			for( int x = 0; x < framebuffer.width(); ++x )
+			{
+				seed = seed * 1103515245 + 12345;
+				line[x] = qRgb( x * 255 / FramebufferWidth, y * 255 / FramebufferHeight, int( seed >> 24 ) );
+			}
+		}
+		framebuffers.append( framebuffer );
+	}
+
+	// clients of the same host request a few typical sizes and formats
+	const QList<WebApiImageEncoder::Settings> requestedSettings{
+		{ { 1280, 720 }, QByteArrayLiteral("jpeg"), 0, 90 },
+		{ { 640, 360 }, QByteArrayLiteral("jpeg"), 0, 75 },
+		{ { 320, 180 }, QByteArrayLiteral("png"), 9, 0 },
+	};
+
+	CommandLineBenchmark benchmark( QStringLiteral("ImageEncoderBenchmark"),
+									{ QStringLiteral("Method"), QStringLiteral("Total time [ms]"),
+									  QStringLiteral("Responses/s"), QStringLiteral("Encodings"),
+									  QStringLiteral("Rejected (busy)") } );
+
+	const auto measure = [&]( const QString& method, const std::function<bool(int, int, const WebApiImageEncoder::Settings&)>& request,
+							  const std::function<qint64()>& encodingCount ) {
+		const auto initialEncodingCount = encodingCount();
+		qint64 totalTime = 0;
+		int responseCount = 0;
+		int rejectedCount = 0;
+
+		// all clients request the current frame at the same time as after a framebuffer update
+		for( int frame = 0; frame < frameCount; ++frame )
+		{
+			std::atomic<int> nextClient{0};
+			const auto measurement = CommandLineBenchmark::runConcurrently( clientCount, clientCount, [&]() {
+				const auto client = nextClient++;
+				return request( client % hostCount, frame, requestedSettings[( client / hostCount ) % requestedSettings.size()] );
+			} );
+			totalTime += measurement.totalTime;
+			responseCount += measurement.runCount;
+			rejectedCount += measurement.failedCount;
+		}
+
+		benchmark.addRow( method, { CommandLineBenchmark::milliseconds( totalTime ),
+									QString::number( totalTime > 0 ? responseCount * 1e9 / double(totalTime) : 0, 'f', 0 ),
+									QString::number( encodingCount() - initialEncodingCount ),
+									QString::number( rejectedCount ) } );
+	};
+
+	// every request encoded on its own
+	std::atomic<qint64> separateEncodingCount{0};
+	const auto separateRequest = [&]( int host, int frame, const WebApiImageEncoder::Settings& settings ) {
+		Q_UNUSED(frame)
+		++separateEncodingCount;
+		return WebApiImageEncoder::encodeImage( framebuffers.at( host ), settings ).imageData.isEmpty() == false;
+	};
+
+	const auto sharedRequest = [&]( WebApiImageEncoder* encoder ) {
+		return [&, encoder]( int host, int frame, const WebApiImageEncoder::Settings& settings ) {
+			auto encoding = encoder->encode( QString::number( host ), quint64( frame ), framebuffers.at( host ), settings );
+			if( encoding.isCanceled() )
+			{
+				return false;
+			}
+			encoding.waitForFinished();
+			return encoding.result().imageData.isEmpty() == false;
+		};
+	};
+
+	WebApiImageEncoder unboundedEncoder( 0, clientCount );
+	WebApiImageEncoder boundedEncoder( 0, queueLimit );
+
+	benchmark.info( QStringLiteral("%1 clients requesting %2 frames of %3 hosts, %4 encoder threads")
+						.arg( clientCount ).arg( frameCount ).arg( hostCount ).arg( boundedEncoder.threadCount() ) );
+
+	measure( QStringLiteral("separate encoding per request"), separateRequest,
+			 [&]() { return qint64( separateEncodingCount ); } );
+	measure( QStringLiteral("shared encoder pool"), sharedRequest( &unboundedEncoder ),
+			 [&]() { return unboundedEncoder.encodingCount(); } );
+	measure( QStringLiteral("shared encoder pool (queue limit %1)").arg( queueLimit ), sharedRequest( &boundedEncoder ),
+			 [&]() { return boundedEncoder.encodingCount(); } );
+
+	benchmark.print();
+
+	benchmark.info( QStringLiteral("%1 of %2 requests to the shared encoder pool were served by a shared encoding")
+						.arg( unboundedEncoder.sharedCount() ).arg( unboundedEncoder.sharedCount() + unboundedEncoder.encodingCount() ) );
+
+	return Successful;
+}
+#endif
+
+
+
 void WebApiPlugin::startHttpServerThread()
 {
 	m_httpServer = new WebApiHttpServer{ m_configuration };
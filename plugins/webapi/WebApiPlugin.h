@@ -97,6 +97,9 @@ public:
 
 public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_runserver( const QStringList& arguments );
+#ifdef VEYON_DEBUG
+	CommandLinePluginInterface::RunResult handle_imageencoderbenchmark( const QStringList& arguments );
+#endif
 
 private:
 	void startHttpServerThread();
@@ -27,6 +27,7 @@
 #include "VeyonCore.h"
 #include "ComputerControlClient.h"
 #include "ComputerControlServer.h"
+#include "RfbFlowControl.h"
 
 
 ComputerControlClient::ComputerControlClient( ComputerControlServer* server,
@@ -44,6 +45,17 @@ ComputerControlClient::ComputerControlClient( ComputerControlServer* server,
 	m_clientProtocol( vncServerSocket(), vncServerPassword )
 {
 	m_framebufferUpdateTimer.start();
+	m_statisticsTimer.start();
+
+	m_pendingFramebufferUpdateRequestTimer.setSingleShot(true);
+	connect(&m_pendingFramebufferUpdateRequestTimer, &QTimer::timeout,
+			this, &ComputerControlClient::sendPendingFramebufferUpdateRequest);
+
+	m_continuousUpdateTimer.setSingleShot(true);
+	connect(&m_continuousUpdateTimer, &QTimer::timeout, this, &ComputerControlClient::requestContinuousUpdate);
+
+	// resume continuous updates once queued data has been sent to the client
+	connect(clientSocket, &QTcpSocket::bytesWritten, this, &ComputerControlClient::requestContinuousUpdate);
 }
 
 
@@ -70,8 +82,23 @@ bool ComputerControlClient::receiveClientMessage()
 		return m_server->handleFeatureMessage(this);
 	}
 
-	// filter framebuffer update requests when minimum framebuffer update interval is set
-	if (messageType == rfbFramebufferUpdateRequest && m_minimumFramebufferUpdateInterval > 0)
+	switch (uint8_t(messageType))
+	{
+	case rfbSetEncodings:
+		return receiveSetEncodingsMessage();
+	case RfbFlowControl::ContinuousUpdatesMessageType:
+		return receiveEnableContinuousUpdatesMessage();
+	case RfbFlowControl::FenceMessageType:
+		return receiveFenceMessage();
+	case rfbPointerEvent:
+		return receivePointerEventMessages();
+	default:
+		break;
+	}
+
+	// rate-limit framebuffer update requests when minimum framebuffer update interval is set
+	if (messageType == rfbFramebufferUpdateRequest &&
+		(m_minimumFramebufferUpdateInterval > 0 || m_continuousUpdatesEnabled))
 	{
 		if (socket->bytesAvailable() < sz_rfbFramebufferUpdateRequestMsg)
 		{
@@ -80,17 +107,36 @@ bool ComputerControlClient::receiveClientMessage()
 
 		const auto messageData = socket->read(sz_rfbFramebufferUpdateRequestMsg);
 		const auto updateRequestMessage = reinterpret_cast<const rfbFramebufferUpdateRequestMsg *>(messageData.constData());
+		const QRect rect(qFromBigEndian(updateRequestMessage->x),
+						 qFromBigEndian(updateRequestMessage->y),
+						 qFromBigEndian(updateRequestMessage->w),
+						 qFromBigEndian(updateRequestMessage->h));
+
+		if (updateRequestMessage->incremental && m_continuousUpdatesEnabled)
+		{
+			// updates are pushed to the client anyway
+			return true;
+		}
 
 		if (updateRequestMessage->incremental &&
 			m_framebufferUpdateTimer.hasExpired(m_minimumFramebufferUpdateInterval) == false)
 		{
-			// discard update request
+			// defer request until interval expires - the VNC server accumulates all changes
+			// in the meantime so the deferred request yields a single coalesced update
+			m_pendingFramebufferUpdateRect = m_hasPendingFramebufferUpdateRequest ?
+												 m_pendingFramebufferUpdateRect.united(rect) : rect;
+			m_hasPendingFramebufferUpdateRequest = true;
+
+			if (m_pendingFramebufferUpdateRequestTimer.isActive() == false)
+			{
+				m_pendingFramebufferUpdateRequestTimer.start(
+					int(qMax<qint64>(0, m_minimumFramebufferUpdateInterval - m_framebufferUpdateTimer.elapsed())));
+			}
+
 			return true;
 		}
 
-		// forward request to server
-		m_framebufferUpdateTimer.restart();
-		return vncServerSocket()->write(messageData) == messageData.size();
+		return forwardFramebufferUpdateRequest(rect, updateRequestMessage->incremental);
 	}
 
 	return VncProxyConnection::receiveClientMessage();
@@ -101,4 +147,385 @@ bool ComputerControlClient::receiveClientMessage()
 void ComputerControlClient::setMinimumFramebufferUpdateInterval(int interval)
 {
 	m_minimumFramebufferUpdateInterval = interval;
+
+	// do not hold back deferred requests when rate control has been disabled
+	if (m_minimumFramebufferUpdateInterval <= 0)
+	{
+		sendPendingFramebufferUpdateRequest();
+		requestContinuousUpdate();
+	}
+}
+
+
+
+bool ComputerControlClient::receiveServerMessage()
+{
+	if (VncProxyConnection::receiveServerMessage())
+	{
+		if (m_continuousUpdatesEnabled && clientProtocol().lastMessageType() == rfbFramebufferUpdate)
+		{
+			finishContinuousUpdate();
+		}
+
+		updateStatistics();
+		return true;
+	}
+
+	return false;
+}
+
+
+
+bool ComputerControlClient::receiveSetEncodingsMessage()
+{
+	auto socket = proxyClientSocket();
+
+	rfbSetEncodingsMsg setEncodingsMessage;
+	if (socket->peek(reinterpret_cast<char *>(&setEncodingsMessage), sz_rfbSetEncodingsMsg) != sz_rfbSetEncodingsMsg)
+	{
+		return false;
+	}
+
+	const auto encodingCount = int(qFromBigEndian(setEncodingsMessage.nEncodings));
+	if (encodingCount > MAX_ENCODINGS)
+	{
+		// let default implementation reject the message
+		return VncProxyConnection::receiveClientMessage();
+	}
+
+	const auto messageSize = sz_rfbSetEncodingsMsg + encodingCount * int(sizeof(uint32_t));
+	if (socket->bytesAvailable() < messageSize)
+	{
+		return false;
+	}
+
+	const auto message = socket->read(messageSize);
+
+	// strip pseudo-encodings handled by us so that the VNC server never sends related messages
+	QByteArray encodings;
+	bool continuousUpdates = false;
+	bool fences = false;
+
+	for (int offset = sz_rfbSetEncodingsMsg; offset < messageSize; offset += int(sizeof(uint32_t)))
+	{
+		const auto encoding = qFromBigEndian<int32_t>(message.constData() + offset);
+		if (encoding == RfbFlowControl::ContinuousUpdatesEncoding)
+		{
+			continuousUpdates = true;
+		}
+		else if (encoding == RfbFlowControl::FenceEncoding)
+		{
+			fences = true;
+		}
+		else
+		{
+			encodings.append(message.constData() + offset, int(sizeof(uint32_t)));
+		}
+	}
+
+	// messages which only announce support for the extensions must not reset the encodings of the VNC server
+	if (encodings.isEmpty() == false || (continuousUpdates == false && fences == false))
+	{
+		setEncodingsMessage.nEncodings = qToBigEndian<uint16_t>(uint16_t(encodings.size() / int(sizeof(uint32_t))));
+
+		const auto forwardedMessage = QByteArray(reinterpret_cast<const char *>(&setEncodingsMessage), sz_rfbSetEncodingsMsg) +
+									  encodings;
+		if (vncServerSocket()->write(forwardedMessage) != forwardedMessage.size())
+		{
+			return false;
+		}
+	}
+
+	m_clientSupportsFences |= fences;
+
+	if (continuousUpdates && m_clientSupportsContinuousUpdates == false)
+	{
+		m_clientSupportsContinuousUpdates = true;
+
+		// tell client that continuous updates are supported
+		const auto endOfContinuousUpdatesMessage = RfbFlowControl::endOfContinuousUpdatesMessage();
+		return socket->write(endOfContinuousUpdatesMessage) == endOfContinuousUpdatesMessage.size();
+	}
+
+	return true;
+}
+
+
+
+bool ComputerControlClient::receiveEnableContinuousUpdatesMessage()
+{
+	auto socket = proxyClientSocket();
+
+	if (socket->bytesAvailable() < RfbFlowControl::EnableContinuousUpdatesMessageSize)
+	{
+		return false;
+	}
+
+	const auto message = socket->read(RfbFlowControl::EnableContinuousUpdatesMessageSize);
+
+	if (message[1])
+	{
+		m_continuousUpdatesRect = RfbFlowControl::continuousUpdatesRect(message);
+		m_continuousUpdatesEnabled = true;
+
+		requestContinuousUpdate();
+
+		return true;
+	}
+
+	m_continuousUpdatesEnabled = false;
+	m_continuousUpdateTimer.stop();
+
+	// confirm that no more updates are pushed
+	const auto endOfContinuousUpdatesMessage = RfbFlowControl::endOfContinuousUpdatesMessage();
+	return socket->write(endOfContinuousUpdatesMessage) == endOfContinuousUpdatesMessage.size();
+}
+
+
+
+bool ComputerControlClient::receiveFenceMessage()
+{
+	auto socket = proxyClientSocket();
+
+	const auto header = socket->peek(RfbFlowControl::FenceMessageHeaderSize);
+	if (header.size() < RfbFlowControl::FenceMessageHeaderSize)
+	{
+		return false;
+	}
+
+	const auto payloadSize = RfbFlowControl::fencePayloadSize(header);
+	if (payloadSize > RfbFlowControl::MaximumFencePayloadSize)
+	{
+		vCritical() << "received fence with invalid payload size" << payloadSize;
+		socket->close();
+		return false;
+	}
+
+	if (socket->bytesAvailable() < RfbFlowControl::FenceMessageHeaderSize + payloadSize)
+	{
+		return false;
+	}
+
+	socket->read(RfbFlowControl::FenceMessageHeaderSize);
+	const auto payload = socket->read(payloadSize);
+	const auto flags = RfbFlowControl::fenceFlags(header);
+
+	if (flags & RfbFlowControl::FenceRequest)
+	{
+		// all preceding messages have been forwarded to the VNC server already
+		const auto response = RfbFlowControl::fenceResponseMessage(flags, payload);
+		return socket->write(response) == response.size();
+	}
+
+	// response to a fence sent after a framebuffer update
+	if (payload.size() == int(sizeof(qint64)))
+	{
+		m_congestionControl.finishRoundTrip(qFromBigEndian<qint64>(payload.constData()));
+		requestContinuousUpdate();
+	}
+
+	return true;
+}
+
+
+
+bool ComputerControlClient::receivePointerEventMessages()
+{
+	auto socket = proxyClientSocket();
+
+	if (socket->bytesAvailable() < sz_rfbPointerEventMsg)
+	{
+		return false;
+	}
+
+	auto message = socket->read(sz_rfbPointerEventMsg);
+
+	// drop pointer moves already superseded by further buffered moves so that the VNC server
+	// does not have to process (and render) outdated positions after network stalls - messages
+	// changing the button state are always forwarded to keep clicks at their positions
+	while (socket->bytesAvailable() >= sz_rfbPointerEventMsg &&
+		   uint8_t(message[1]) == m_pointerButtonMask)
+	{
+		const auto nextMessage = socket->peek(sz_rfbPointerEventMsg);
+		if (uint8_t(nextMessage[0]) != rfbPointerEvent || nextMessage[1] != message[1])
+		{
+			break;
+		}
+
+		message = socket->read(sz_rfbPointerEventMsg);
+	}
+
+	m_pointerButtonMask = uint8_t(message[1]);
+
+	return vncServerSocket()->write(message) == message.size();
+}
+
+
+
+bool ComputerControlClient::forwardFramebufferUpdateRequest(const QRect& rect, bool incremental)
+{
+	// a pending request is obsolete if covered by the forwarded request
+	if (m_hasPendingFramebufferUpdateRequest && rect.contains(m_pendingFramebufferUpdateRect))
+	{
+		m_pendingFramebufferUpdateRequestTimer.stop();
+		m_hasPendingFramebufferUpdateRequest = false;
+	}
+
+	rfbFramebufferUpdateRequestMsg updateRequestMessage{};
+	updateRequestMessage.type = rfbFramebufferUpdateRequest;
+	updateRequestMessage.incremental = incremental ? 1 : 0;
+	updateRequestMessage.x = qToBigEndian<uint16_t>(rect.x());
+	updateRequestMessage.y = qToBigEndian<uint16_t>(rect.y());
+	updateRequestMessage.w = qToBigEndian<uint16_t>(rect.width());
+	updateRequestMessage.h = qToBigEndian<uint16_t>(rect.height());
+
+	m_framebufferUpdateTimer.restart();
+
+	return vncServerSocket()->write(reinterpret_cast<const char *>(&updateRequestMessage),
+									sz_rfbFramebufferUpdateRequestMsg) == sz_rfbFramebufferUpdateRequestMsg;
+}
+
+
+
+void ComputerControlClient::sendPendingFramebufferUpdateRequest()
+{
+	if (m_hasPendingFramebufferUpdateRequest)
+	{
+		m_pendingFramebufferUpdateRequestTimer.stop();
+		m_hasPendingFramebufferUpdateRequest = false;
+
+		forwardFramebufferUpdateRequest(m_pendingFramebufferUpdateRect, true);
+	}
+}
+
+
+
+void ComputerControlClient::requestContinuousUpdate()
+{
+	if (m_continuousUpdatesEnabled == false || m_continuousUpdateRequested)
+	{
+		return;
+	}
+
+	if (isClientCongested())
+	{
+		// retried when the client acknowledges data or the socket has been drained - recheck
+		// periodically nevertheless in case the client stopped answering fences
+		if (m_continuousUpdateTimer.isActive() == false)
+		{
+			m_continuousUpdateTimer.start(CongestionRecheckInterval);
+		}
+		return;
+	}
+
+	if (m_minimumFramebufferUpdateInterval > 0 &&
+		m_framebufferUpdateTimer.hasExpired(m_minimumFramebufferUpdateInterval) == false)
+	{
+		m_continuousUpdateTimer.start(
+			int(qMax<qint64>(0, m_minimumFramebufferUpdateInterval - m_framebufferUpdateTimer.elapsed())));
+		return;
+	}
+
+	m_continuousUpdateTimer.stop();
+
+	// the VNC server answers with the next change, i.e. the update is pushed as soon as available
+	m_continuousUpdateRequested = forwardFramebufferUpdateRequest(m_continuousUpdatesRect, true);
+}
+
+
+
+void ComputerControlClient::finishContinuousUpdate()
+{
+	m_continuousUpdateRequested = false;
+
+	m_congestionControl.updateSent(clientProtocol().lastMessage().size());
+
+	if (m_clientSupportsFences)
+	{
+		// measure how long it takes until the client has processed the update
+		const auto roundTripId = m_congestionControl.startRoundTrip();
+		if (roundTripId >= 0)
+		{
+			QByteArray payload(int(sizeof(roundTripId)), 0);
+			qToBigEndian<qint64>(roundTripId, payload.data());
+
+			proxyClientSocket()->write(RfbFlowControl::fenceMessage(RfbFlowControl::FenceRequest |
+																	RfbFlowControl::FenceBlockBefore, payload));
+		}
+	}
+
+	requestContinuousUpdate();
+}
+
+
+
+bool ComputerControlClient::isClientCongested() const
+{
+	if (proxyClientSocket()->bytesToWrite() >= MaximumQueuedClientBytes)
+	{
+		return true;
+	}
+
+	return m_clientSupportsFences && m_congestionControl.isCongested();
+}
+
+
+
+void ComputerControlClient::updateStatistics()
+{
+	m_transferredBytes += clientProtocol().lastMessage().size();
+
+	if (clientProtocol().lastMessageType() == rfbFramebufferUpdate)
+	{
+		++m_framebufferUpdateCount;
+	}
+
+	const auto elapsed = m_statisticsTimer.elapsed();
+	if (elapsed >= StatisticsInterval)
+	{
+		m_framebufferUpdateRate = m_framebufferUpdateCount * 1000.0 / elapsed;
+		m_transferRate = m_transferredBytes * 1000.0 / elapsed;
+
+		// only log periodically or if the rates changed significantly to not flood the log with many clients
+		if (m_statisticsLogTimer.isValid() == false ||
+			m_statisticsLogTimer.elapsed() >= StatisticsLogInterval ||
+			hasNotableStatisticsChange())
+		{
+			if (m_continuousUpdatesEnabled && m_clientSupportsFences)
+			{
+				vDebug() << proxyClientSocket()->peerAddress().toString()
+						 << "updates/s:" << m_framebufferUpdateRate << "bytes/s:" << m_transferRate
+						 << "RTT:" << m_congestionControl.roundTripTime()
+						 << "window:" << m_congestionControl.window()
+						 << "in flight:" << m_congestionControl.bytesInFlight();
+			}
+			else
+			{
+				vDebug() << proxyClientSocket()->peerAddress().toString()
+						 << "updates/s:" << m_framebufferUpdateRate << "bytes/s:" << m_transferRate;
+			}
+
+			m_loggedFramebufferUpdateRate = m_framebufferUpdateRate;
+			m_loggedTransferRate = m_transferRate;
+			m_statisticsLogTimer.restart();
+		}
+
+		m_framebufferUpdateCount = 0;
+		m_transferredBytes = 0;
+		m_statisticsTimer.restart();
+	}
+}
+
+
+
+bool ComputerControlClient::hasNotableStatisticsChange() const
+{
+	// the offsets keep small fluctuations of almost idle clients (e.g. between 0 and 1 updates/s) quiet
+	const auto differsSignificantly = [](qreal rate, qreal loggedRate, qreal offset) {
+		return rate + offset > (loggedRate + offset) * StatisticsLogChangeFactor ||
+			   (rate + offset) * StatisticsLogChangeFactor < loggedRate + offset;
+	};
+
+	return differsSignificantly(m_framebufferUpdateRate, m_loggedFramebufferUpdateRate, 1) ||
+		   differsSignificantly(m_transferRate, m_loggedTransferRate, StatisticsLogMinimumTransferRate);
 }
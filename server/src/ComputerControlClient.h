@@ -25,7 +25,9 @@
 #pragma once
 
 #include <QElapsedTimer>
+#include <QTimer>
 
+#include "FramebufferCongestionControl.h"
 #include "VncClientProtocol.h"
 #include "VncProxyConnection.h"
 #include "VncServerClient.h"
@@ -55,7 +57,19 @@ public:
 
 	void setMinimumFramebufferUpdateInterval(int interval);
 
+	qreal framebufferUpdateRate() const
+	{
+		return m_framebufferUpdateRate;
+	}
+
+	qreal transferRate() const
+	{
+		return m_transferRate;
+	}
+
 protected:
+	bool receiveServerMessage() override;
+
 	VncClientProtocol& clientProtocol() override
 	{
 		return m_clientProtocol;
@@ -67,6 +81,29 @@ protected:
 	}
 
 private:
+	static constexpr auto StatisticsInterval = 1000;
+	static constexpr auto StatisticsLogInterval = 60000;
+	// log statistics earlier if a rate differs from the last logged one by this factor
+	static constexpr auto StatisticsLogChangeFactor = 2;
+	static constexpr auto StatisticsLogMinimumTransferRate = 64 * 1024;
+	static constexpr auto MaximumQueuedClientBytes = 4 * 1024 * 1024;
+	static constexpr auto CongestionRecheckInterval = 1000;
+
+	bool receiveSetEncodingsMessage();
+	bool receiveEnableContinuousUpdatesMessage();
+	bool receiveFenceMessage();
+	bool receivePointerEventMessages();
+
+	bool forwardFramebufferUpdateRequest(const QRect& rect, bool incremental);
+	void sendPendingFramebufferUpdateRequest();
+
+	void requestContinuousUpdate();
+	void finishContinuousUpdate();
+	bool isClientCongested() const;
+
+	void updateStatistics();
+	bool hasNotableStatisticsChange() const;
+
 	ComputerControlServer* m_server;
 
 	VncServerClient m_serverClient;
@@ -77,4 +114,29 @@ private:
 	int m_minimumFramebufferUpdateInterval{-1};
 	QElapsedTimer m_framebufferUpdateTimer;
 
+	QTimer m_pendingFramebufferUpdateRequestTimer{this};
+	QRect m_pendingFramebufferUpdateRect;
+	bool m_hasPendingFramebufferUpdateRequest{false};
+
+	// the VNC server does not know about continuous updates so they are emulated by
+	// requesting updates from it whenever the client can take more data
+	bool m_clientSupportsContinuousUpdates{false};
+	bool m_clientSupportsFences{false};
+	bool m_continuousUpdatesEnabled{false};
+	bool m_continuousUpdateRequested{false};
+	QRect m_continuousUpdatesRect;
+	QTimer m_continuousUpdateTimer{this};
+	FramebufferCongestionControl m_congestionControl;
+
+	uint8_t m_pointerButtonMask{0};
+
+	QElapsedTimer m_statisticsTimer;
+	int m_framebufferUpdateCount{0};
+	qint64 m_transferredBytes{0};
+	qreal m_framebufferUpdateRate{0};
+	qreal m_transferRate{0};
+	QElapsedTimer m_statisticsLogTimer;
+	qreal m_loggedFramebufferUpdateRate{0};
+	qreal m_loggedTransferRate{0};
+
 } ;
@@ -22,7 +22,7 @@
  *
  */
 
-#include <QCoreApplication>
+#include <QElapsedTimer>
 
 #include "AccessControlProvider.h"
 #include "BuiltinFeatures.h"
@@ -37,23 +37,33 @@
 
 
 ComputerControlServer::ComputerControlServer( QObject* parent ) :
+	ComputerControlServer( VeyonCore::sessionId(), {}, {}, parent )
+{
+}
+
+
+
+ComputerControlServer::ComputerControlServer( int sessionId, const QProcessEnvironment& sessionEnvironment,
+											  const QString& sessionUser, QObject* parent ) :
 	VeyonServerInterface(parent),
+	m_sessionId( sessionId ),
+	m_sessionEnvironment( sessionEnvironment ),
+	m_sessionUser( sessionUser ),
 	m_allowedIPs(),
 	m_failedAuthHosts(),
 	m_featureWorkerManager( *this ),
 	m_serverAuthenticationManager( this ),
-	m_serverAccessControlManager( m_featureWorkerManager, VeyonCore::builtinFeatures().desktopAccessDialog(), this ),
-	m_vncServer(),
-	m_vncProxyServer( VeyonCore::config().localConnectOnly() || VeyonCore::builtinFeatures().accessControlProvider().isAccessToLocalComputerDenied() ?
+	m_serverAccessControlManager( *this, VeyonCore::builtinFeatures().desktopAccessDialog(), this ),
+	m_vncServer( m_sessionId ),
+	m_vncProxyServer( VeyonCore::config().localConnectOnly() || VeyonCore::builtinFeatures().accessControlProvider().isAccessToLocalComputerDenied( sessionUser() ) ?
 						  QHostAddress::LocalHost : QHostAddress::Any,
-					  VeyonCore::config().veyonServerPort() + VeyonCore::sessionId(),
+					  VeyonCore::config().veyonServerPort() + m_sessionId,
 					  this,
 					  this )
 {
 	updateTrayIconToolTip();
 
-	// make app terminate once the VNC server thread has finished
-	connect( &m_vncServer, &VncServer::finished, QCoreApplication::instance(), &QCoreApplication::quit );
+	connect( &m_vncServer, &VncServer::finished, this, &ComputerControlServer::finished );
 
 	connect( &m_serverAuthenticationManager, &ServerAuthenticationManager::finished,
 			 this, &ComputerControlServer::showAuthenticationMessage );
@@ -61,8 +71,16 @@ ComputerControlServer::ComputerControlServer( QObject* parent ) :
 	connect( &m_serverAccessControlManager, &ServerAccessControlManager::finished,
 			 this, &ComputerControlServer::showAccessControlMessage );
 
-	connect(&m_vncProxyServer, &VncProxyServer::serverMessageProcessed,
+	// send current state to new connections once they're established and afterwards
+	// only when feature plugins notify about changes
+	connect(&m_vncProxyServer, &VncProxyServer::connectionEstablished,
 			 this, &ComputerControlServer::sendAsyncFeatureMessages, Qt::DirectConnection);
+
+	m_asyncFeatureMessagesTimer.setSingleShot(true);
+	m_asyncFeatureMessagesTimer.setInterval(0);
+	connect(&m_asyncFeatureMessagesTimer, &QTimer::timeout, this, &ComputerControlServer::sendPendingAsyncFeatureMessages);
+	connect(&VeyonCore::featureManager(), &FeatureManager::asyncFeatureMessagesPending,
+			&m_asyncFeatureMessagesTimer, QOverload<>::of(&QTimer::start));
 	connect( &m_vncProxyServer, &VncProxyServer::connectionClosed, this, &ComputerControlServer::updateTrayIconToolTip );
 }
 
@@ -132,13 +150,57 @@ bool ComputerControlServer::handleFeatureMessage(ComputerControlClient* client)
 		return false;
 	}
 
-	VeyonCore::featureManager().handleFeatureMessage( *this, MessageContext{socket, client}, featureMessage );
+	const MessageContext messageContext{socket, client};
+
+	if (featureMessage.requestId().isNull())
+	{
+		VeyonCore::featureManager().handleFeatureMessage(*this, messageContext, featureMessage);
+	}
+	else
+	{
+		handleRequest(messageContext, featureMessage);
+	}
 
 	return true;
 }
 
 
 
+bool ComputerControlServer::handleRequest(const MessageContext& messageContext, const FeatureMessage& message)
+{
+	const auto requestId = message.requestId();
+
+	QElapsedTimer executionTimer;
+	executionTimer.start();
+
+	auto handled = m_handledRequests.value(requestId, false);
+
+	if (m_handledRequests.contains(requestId))
+	{
+		vDebug() << "not handling request" << requestId << "again";
+	}
+	else
+	{
+		handled = VeyonCore::featureManager().handleFeatureMessage(*this, messageContext, message);
+
+		m_handledRequests[requestId] = handled;
+		m_handledRequestIds.enqueue(requestId);
+		if (m_handledRequestIds.size() > MaximumHandledRequests)
+		{
+			m_handledRequests.remove(m_handledRequestIds.dequeue());
+		}
+	}
+
+	return sendFeatureMessageReply(messageContext,
+								   FeatureMessage{message.featureUid(), FeatureMessage::AcknowledgeCommand}
+								   .setRequestId(requestId)
+								   .addArgument(FeatureMessage::AcknowledgementArgument::Handled, handled)
+								   .addArgument(FeatureMessage::AcknowledgementArgument::ExecutionTime,
+												int(executionTimer.elapsed())));
+}
+
+
+
 bool ComputerControlServer::sendFeatureMessageReply( const MessageContext& context, const FeatureMessage& reply )
 {
 	vDebug() << reply;
@@ -185,7 +247,7 @@ void ComputerControlServer::showAuthenticationMessage( VncServerClient* client )
 	{
 		vWarning() << "Authentication failed for" << client->hostAddress() << client->username();
 
-		if (VeyonCore::config().failedAuthenticationNotificationsEnabled() &&
+		if (VeyonCore::config().snapshot()->failedAuthenticationNotificationsEnabled &&
 			VeyonCore::platform().sessionFunctions().currentSessionHasUser())
 		{
 			QMutexLocker l( &m_dataMutex );
@@ -215,7 +277,7 @@ void ComputerControlServer::showAccessControlMessage( VncServerClient* client )
 	{
 		vInfo() << "Access control successful for" << client->hostAddress() << client->username();
 
-		if (VeyonCore::config().remoteConnectionNotificationsEnabled() &&
+		if (VeyonCore::config().snapshot()->remoteConnectionNotificationsEnabled &&
 			VeyonCore::platform().sessionFunctions().currentSessionHasUser())
 		{
 			const auto fqdn = HostAddress( client->hostAddress() ).tryConvert( HostAddress::Type::FullyQualifiedDomainName );
@@ -233,7 +295,7 @@ void ComputerControlServer::showAccessControlMessage( VncServerClient* client )
 	{
 		vWarning() << "Access control failed for" << client->hostAddress() << client->username();
 
-		if( VeyonCore::config().failedAuthenticationNotificationsEnabled() )
+		if( VeyonCore::config().snapshot()->failedAuthenticationNotificationsEnabled )
 		{
 			QMutexLocker l( &m_dataMutex );
 
@@ -285,16 +347,65 @@ void ComputerControlServer::sendAsyncFeatureMessages(VncProxyConnection* connect
 
 
 
+void ComputerControlServer::sendPendingAsyncFeatureMessages()
+{
+	for (auto connection : std::as_const(m_vncProxyServer.clients()))
+	{
+		if (connection->isEstablished())
+		{
+			sendAsyncFeatureMessages(connection);
+		}
+	}
+}
+
+
+
+QProcessEnvironment ComputerControlServer::sessionEnvironment() const
+{
+	if( servesProcessSession() )
+	{
+		return VeyonServerInterface::sessionEnvironment();
+	}
+
+	return m_sessionEnvironment;
+}
+
+
+
+QString ComputerControlServer::sessionUser() const
+{
+	if( servesProcessSession() )
+	{
+		return VeyonServerInterface::sessionUser();
+	}
+
+	return m_sessionUser;
+}
+
+
+
+bool ComputerControlServer::sessionHasUser() const
+{
+	if( servesProcessSession() )
+	{
+		return VeyonCore::platform().sessionFunctions().currentSessionHasUser();
+	}
+
+	return m_sessionUser.isEmpty() == false;
+}
+
+
+
 void ComputerControlServer::updateTrayIconToolTip()
 {
-	if (VeyonCore::platform().sessionFunctions().currentSessionHasUser() == false)
+	if (sessionHasUser() == false)
 	{
 		return;
 	}
 
 	auto toolTip = tr( "%1 Service %2 at %3:%4" ).arg( VeyonCore::applicationName(), VeyonCore::versionString(),
 													   HostAddress::localFQDN(),
-												QString::number( VeyonCore::config().veyonServerPort() + VeyonCore::sessionId() ) );
+												QString::number( VeyonCore::config().veyonServerPort() + m_sessionId ) );
 
 	QMutexLocker locker( &m_dataMutex );
 
@@ -25,6 +25,8 @@
 #pragma once
 
 #include <QMutex>
+#include <QQueue>
+#include <QTimer>
 #include <QtConcurrent>
 
 #include "FeatureWorkerManager.h"
@@ -43,10 +45,18 @@ class ComputerControlServer : public VeyonServerInterface, VncProxyConnectionFac
 	Q_OBJECT
 public:
 	explicit ComputerControlServer( QObject* parent = nullptr );
+	// serves the given session instead of the session the process belongs to
+	ComputerControlServer( int sessionId, const QProcessEnvironment& sessionEnvironment,
+						   const QString& sessionUser, QObject* parent = nullptr );
 	~ComputerControlServer() override;
 
 	bool start();
 
+	bool supportsMultipleInstances() const
+	{
+		return m_vncServer.supportsMultipleInstances();
+	}
+
 	VncProxyConnection* createVncProxyConnection( QTcpSocket* clientSocket,
 												  int vncServerPort,
 												  const Password& vncServerPassword,
@@ -78,15 +88,41 @@ public:
 
 	void setMinimumFramebufferUpdateInterval(const MessageContext& context, int interval) override;
 
+	int sessionId() const override
+	{
+		return m_sessionId;
+	}
+
+	QProcessEnvironment sessionEnvironment() const override;
+	QString sessionUser() const override;
+
+	bool servesProcessSession() const override
+	{
+		return m_sessionEnvironment.isEmpty();
+	}
+
+Q_SIGNALS:
+	void finished();
+
 private:
+	bool sessionHasUser() const;
+
 	void checkForIncompleteAuthentication( VncServerClient* client );
 	void showAuthenticationMessage( VncServerClient* client );
 	void showAccessControlMessage( VncServerClient* client );
 	QFutureWatcher<void>* resolveFQDNs( const QStringList& hosts );
 
+	bool handleRequest(const MessageContext& messageContext, const FeatureMessage& message);
+
 	void sendAsyncFeatureMessages(VncProxyConnection* connection);
+	void sendPendingAsyncFeatureMessages();
 	void updateTrayIconToolTip();
 
+	// has to be initialized before any other member since they depend on the session
+	const int m_sessionId;
+	const QProcessEnvironment m_sessionEnvironment;
+	const QString m_sessionUser;
+
 	QMutex m_dataMutex;
 	QStringList m_allowedIPs;
 
@@ -103,4 +139,12 @@ private:
 	VncServer m_vncServer;
 	VncProxyServer m_vncProxyServer;
 
+	QTimer m_asyncFeatureMessagesTimer{this};
+
+	// results of recently handled messages with request IDs so that messages sent again
+	// by masters (e.g. after a reconnect) are acknowledged without being executed twice
+	static constexpr auto MaximumHandledRequests = 256;
+	QHash<QUuid, bool> m_handledRequests;
+	QQueue<QUuid> m_handledRequestIds;
+
 } ;
@@ -0,0 +1,122 @@
+/*
+ * FramebufferCongestionControl.cpp - implementation of the FramebufferCongestionControl class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "FramebufferCongestionControl.h"
+
+
+FramebufferCongestionControl::FramebufferCongestionControl()
+{
+	reset();
+}
+
+
+
+void FramebufferCongestionControl::reset()
+{
+	m_pendingRoundTrips.clear();
+	m_sentBytes = 0;
+	m_acknowledgedBytes = 0;
+	m_window = InitialWindow;
+	m_slowStart = true;
+	m_roundTripTime = -1;
+	m_minimumRoundTripTime = -1;
+}
+
+
+
+void FramebufferCongestionControl::updateSent( qint64 bytes )
+{
+	m_sentBytes += bytes;
+}
+
+
+
+qint64 FramebufferCongestionControl::startRoundTrip()
+{
+	if( m_pendingRoundTrips.size() >= MaximumPendingRoundTrips )
+	{
+		// bytes sent in the meantime are acknowledged with the next fence
+		return -1;
+	}
+
+	RoundTrip roundTrip{m_nextRoundTripId++, m_sentBytes, bytesInFlight(), {}};
+	roundTrip.timer.start();
+
+	m_pendingRoundTrips.enqueue( roundTrip );
+
+	return roundTrip.id;
+}
+
+
+
+void FramebufferCongestionControl::finishRoundTrip( qint64 id )
+{
+	// fences are answered in order so all round trips before the given one are lost
+	while( m_pendingRoundTrips.isEmpty() == false && m_pendingRoundTrips.head().id != id )
+	{
+		m_pendingRoundTrips.dequeue();
+	}
+
+	if( m_pendingRoundTrips.isEmpty() )
+	{
+		return;
+	}
+
+	const auto roundTrip = m_pendingRoundTrips.dequeue();
+
+	m_acknowledgedBytes = qMax( m_acknowledgedBytes, roundTrip.sentBytes );
+	m_roundTripTime = int(roundTrip.timer.elapsed());
+
+	if( m_minimumRoundTripTime < 0 || m_roundTripTime < m_minimumRoundTripTime )
+	{
+		m_minimumRoundTripTime = m_roundTripTime;
+	}
+
+	if( m_roundTripTime > m_minimumRoundTripTime * 2 + RoundTripTimeTolerance )
+	{
+		// data queues up somewhere between us and the client
+		m_window = qMax( MinimumWindow, m_window * 3 / 4 );
+		m_slowStart = false;
+	}
+	else if( m_roundTripTime <= m_minimumRoundTripTime + RoundTripTimeTolerance &&
+			 roundTrip.bytesInFlight >= m_window / 2 )
+	{
+		// only grow the window if it actually has been utilized
+		m_window = qMin( MaximumWindow, m_slowStart ? m_window * 2 : m_window + m_window / 8 );
+	}
+}
+
+
+
+bool FramebufferCongestionControl::isCongested() const
+{
+	if( m_pendingRoundTrips.isEmpty() == false &&
+		m_pendingRoundTrips.head().timer.hasExpired( RoundTripTimeout ) )
+	{
+		// client does not answer fences (reliably) so do not stall updates forever
+		return false;
+	}
+
+	return bytesInFlight() >= m_window;
+}
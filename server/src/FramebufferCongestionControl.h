@@ -0,0 +1,97 @@
+/*
+ * FramebufferCongestionControl.h - header file for the FramebufferCongestionControl class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QQueue>
+
+// limits the amount of framebuffer update data in flight to a client based on round trip
+// times measured through RFB fences - the window grows while round trip times stay close
+// to the minimum observed one and shrinks once data starts to queue up in the network
+class FramebufferCongestionControl
+{
+public:
+	FramebufferCongestionControl();
+
+	void reset();
+
+	void updateSent( qint64 bytes );
+
+	// returns the ID to send with the fence request or -1 if too many fences are pending
+	qint64 startRoundTrip();
+	void finishRoundTrip( qint64 id );
+
+	bool isCongested() const;
+
+	qint64 bytesInFlight() const
+	{
+		return m_sentBytes - m_acknowledgedBytes;
+	}
+
+	qint64 window() const
+	{
+		return m_window;
+	}
+
+	int roundTripTime() const
+	{
+		return m_roundTripTime;
+	}
+
+	int minimumRoundTripTime() const
+	{
+		return m_minimumRoundTripTime;
+	}
+
+private:
+	static constexpr qint64 InitialWindow = 256 * 1024;
+	static constexpr qint64 MinimumWindow = 64 * 1024;
+	static constexpr qint64 MaximumWindow = 32 * 1024 * 1024;
+	static constexpr int MaximumPendingRoundTrips = 16;
+	static constexpr int RoundTripTimeout = 5000;
+	// round trip times exceeding the minimum by less than this are considered jitter
+	static constexpr int RoundTripTimeTolerance = 5;
+
+	struct RoundTrip
+	{
+		qint64 id;
+		qint64 sentBytes;
+		qint64 bytesInFlight;
+		QElapsedTimer timer;
+	};
+
+	QQueue<RoundTrip> m_pendingRoundTrips;
+	qint64 m_nextRoundTripId{0};
+
+	qint64 m_sentBytes{0};
+	qint64 m_acknowledgedBytes{0};
+
+	qint64 m_window{InitialWindow};
+	bool m_slowStart{true};
+
+	int m_roundTripTime{-1};
+	int m_minimumRoundTripTime{-1};
+
+};
@@ -0,0 +1,178 @@
+/*
+ * MultiSessionServer.cpp - implementation of the MultiSessionServer class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#include "ComputerControlServer.h"
+#include "MultiSessionServer.h"
+
+
+MultiSessionServer::MultiSessionServer( QObject* parent ) :
+	QObject( parent )
+{
+}
+
+
+
+MultiSessionServer::~MultiSessionServer()
+{
+	while( m_servers.isEmpty() == false )
+	{
+		closeSession( m_servers.firstKey() );
+	}
+}
+
+
+
+bool MultiSessionServer::start()
+{
+#ifdef Q_OS_LINUX
+	m_commandNotifier = new QSocketNotifier( STDIN_FILENO, QSocketNotifier::Read, this );
+	connect( m_commandNotifier, &QSocketNotifier::activated, this, &MultiSessionServer::readCommands );
+
+	return true;
+#else
+	vCritical() << "serving multiple sessions is not supported on this platform";
+
+	return false;
+#endif
+}
+
+
+
+void MultiSessionServer::readCommands()
+{
+#ifdef Q_OS_LINUX
+	char buffer[ReadBufferSize];
+	const auto count = ::read( STDIN_FILENO, buffer, sizeof(buffer) );
+
+	if( count < 0 && ( errno == EINTR || errno == EAGAIN ) )
+	{
+		return;
+	}
+
+	if( count <= 0 )
+	{
+		// the process controlling us has gone
+		vInfo() << "control channel closed - shutting down";
+		m_commandNotifier->setEnabled( false );
+		QCoreApplication::quit();
+		return;
+	}
+
+	m_commandBuffer.append( buffer, int(count) );
+
+	int lineEnd = -1;
+	while( ( lineEnd = m_commandBuffer.indexOf( '\n' ) ) >= 0 )
+	{
+		const auto line = m_commandBuffer.left( lineEnd + 1 );
+		m_commandBuffer.remove( 0, lineEnd + 1 );
+
+		processCommand( MultiSessionServerControl::parseCommand( line ) );
+	}
+
+	if( m_commandBuffer.size() > MaximumCommandSize )
+	{
+		vCritical() << "discarding oversized command";
+		m_commandBuffer.clear();
+	}
+#endif
+}
+
+
+
+void MultiSessionServer::processCommand( const MultiSessionServerControl::Command& command )
+{
+	switch( command.type )
+	{
+	case MultiSessionServerControl::Command::Type::OpenSession:
+		openSession( command.sessionId, command.sessionEnvironment, command.sessionUser );
+		break;
+	case MultiSessionServerControl::Command::Type::CloseSession:
+		closeSession( command.sessionId );
+		break;
+	default:
+		vWarning() << "received invalid command";
+		break;
+	}
+}
+
+
+
+void MultiSessionServer::openSession( int sessionId, const QProcessEnvironment& sessionEnvironment,
+									  const QString& sessionUser )
+{
+	// session might be opened again e.g. after the user changed
+	closeSession( sessionId );
+
+	auto server = new ComputerControlServer( sessionId, sessionEnvironment, sessionUser, this );
+
+	if( server->supportsMultipleInstances() == false )
+	{
+		vCritical() << "the configured VNC server does not support serving multiple sessions";
+		delete server;
+		return;
+	}
+
+	if( server->start() == false )
+	{
+		vCritical() << "failed to start server for session" << sessionId;
+		delete server;
+		return;
+	}
+
+	connect( server, &ComputerControlServer::finished, this, [=]() {
+		vWarning() << "VNC server for session" << sessionId << "finished";
+		if( m_servers.value( sessionId ) == server )
+		{
+			m_servers.remove( sessionId );
+		}
+		server->deleteLater();
+	} );
+
+	m_servers[sessionId] = server;
+
+	vInfo() << "serving session" << sessionId << "of user" << sessionUser
+			<< "- serving" << m_servers.size() << "sessions in total";
+}
+
+
+
+void MultiSessionServer::closeSession( int sessionId )
+{
+	const auto server = m_servers.take( sessionId );
+	if( server )
+	{
+		vInfo() << "closing session" << sessionId;
+
+		server->disconnect( this );
+		delete server;
+	}
+}
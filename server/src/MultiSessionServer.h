@@ -0,0 +1,61 @@
+/*
+ * MultiSessionServer.h - header file for the MultiSessionServer class
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QMap>
+
+#include "MultiSessionServerControl.h"
+
+class ComputerControlServer;
+class QSocketNotifier;
+
+// serves multiple sessions within one process by running a ComputerControlServer per session
+// so that plugins, keys, access control and configuration are loaded only once - sessions are
+// opened and closed by the process which started the server (usually the service)
+class MultiSessionServer : public QObject
+{
+	Q_OBJECT
+public:
+	explicit MultiSessionServer( QObject* parent = nullptr );
+	~MultiSessionServer() override;
+
+	bool start();
+
+private:
+	static constexpr auto ReadBufferSize = 4096;
+	static constexpr auto MaximumCommandSize = 1024 * 1024;
+
+	void readCommands();
+	void processCommand( const MultiSessionServerControl::Command& command );
+
+	void openSession( int sessionId, const QProcessEnvironment& sessionEnvironment, const QString& sessionUser );
+	void closeSession( int sessionId );
+
+	QSocketNotifier* m_commandNotifier{nullptr};
+	QByteArray m_commandBuffer;
+
+	QMap<int, ComputerControlServer *> m_servers;
+
+};
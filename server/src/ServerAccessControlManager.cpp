@@ -30,11 +30,12 @@
 #include "DesktopAccessDialog.h"
 
 
-ServerAccessControlManager::ServerAccessControlManager( FeatureWorkerManager& featureWorkerManager,
+ServerAccessControlManager::ServerAccessControlManager( VeyonServerInterface& server,
 														DesktopAccessDialog& desktopAccessDialog,
 														QObject* parent ) :
 	QObject( parent ),
-	m_featureWorkerManager( featureWorkerManager ),
+	m_server( server ),
+	m_featureWorkerManager( server.featureWorkerManager() ),
 	m_desktopAccessDialog( desktopAccessDialog ),
 	m_clients(),
 	m_desktopAccessChoices()
@@ -120,7 +121,8 @@ void ServerAccessControlManager::performAccessControl( VncServerClient* client )
 	const auto checkResult = VeyonCore::builtinFeatures().accessControlProvider()
 							 .checkAccess(client->username(),
 										  client->hostAddress(),
-										  connectedUsers());
+										  connectedUsers(),
+										  m_server.sessionUser());
 
 	switch (checkResult.access)
 	{
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "DesktopAccessDialog.h"
+#include "VeyonServerInterface.h"
 #include "VncServerClient.h"
 
 class VariantArrayMessage;
@@ -33,7 +34,7 @@ class ServerAccessControlManager : public QObject
 {
 	Q_OBJECT
 public:
-	ServerAccessControlManager( FeatureWorkerManager& featureWorkerManager,
+	ServerAccessControlManager( VeyonServerInterface& server,
 								DesktopAccessDialog& desktopAccessDialog,
 								QObject* parent );
 
@@ -53,6 +54,7 @@ private:
 
 	QStringList connectedUsers() const;
 
+	VeyonServerInterface& m_server;
 	FeatureWorkerManager& m_featureWorkerManager;
 	DesktopAccessDialog& m_desktopAccessDialog;
 
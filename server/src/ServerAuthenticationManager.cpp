@@ -42,12 +42,14 @@ QVector<RfbVeyonAuth::Type> ServerAuthenticationManager::supportedAuthTypes() co
 {
 	QVector<RfbVeyonAuth::Type> authTypes;
 
-	if( VeyonCore::config().authenticationMethod() == VeyonCore::AuthenticationMethod::KeyFileAuthentication )
+	const auto authenticationMethod = VeyonCore::config().snapshot()->authenticationMethod;
+
+	if( authenticationMethod == VeyonCore::AuthenticationMethod::KeyFileAuthentication )
 	{
 		authTypes.append( RfbVeyonAuth::KeyFile );
 	}
 
-	if( VeyonCore::config().authenticationMethod() == VeyonCore::AuthenticationMethod::LogonAuthentication )
+	if( authenticationMethod == VeyonCore::AuthenticationMethod::LogonAuthentication )
 	{
 		authTypes.append( RfbVeyonAuth::Logon );
 	}
@@ -135,14 +137,13 @@ VncServerClient::AuthState ServerAuthenticationManager::performKeyAuthentication
 
 		const auto publicKeyPath = VeyonCore::filesystem().publicKeyPath( authKeyName );
 
-		CryptoCore::PublicKey publicKey( publicKeyPath );
+		auto publicKey = VeyonCore::cryptoCore().loadPublicKey( publicKeyPath );
 		if( publicKey.isNull() || publicKey.isPublic() == false )
 		{
 			vWarning() << "failed to load public key from" << publicKeyPath;
 			return VncServerClient::AuthState::Failed;
 		}
 
-		vDebug() << "loaded public key from" << publicKeyPath;
 		if( publicKey.verifyMessage( client->challenge(), signature, CryptoCore::DefaultSignatureAlgorithm ) == false )
 		{
 			vWarning() << "FAIL";
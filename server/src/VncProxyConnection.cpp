@@ -133,7 +133,11 @@ void VncProxyConnection::readFromServer()
 	{
 		while( receiveServerMessage() )
 		{
-			Q_EMIT serverMessageProcessed();
+			if( m_established == false )
+			{
+				m_established = true;
+				Q_EMIT established();
+			}
 		}
 	}
 	else
@@ -55,6 +55,13 @@ public:
 		return m_vncServerSocket;
 	}
 
+	// returns whether both protocols are running and at least one server message has been forwarded
+	// to the client, i.e. additional messages can be sent to the client between RFB messages
+	bool isEstablished() const
+	{
+		return m_established;
+	}
+
 protected Q_SLOTS:
 	void readFromClient();
 	void readFromServer();
@@ -80,9 +87,11 @@ private:
 
 	const QMap<int, int> m_rfbClientToServerMessageSizes;
 
+	bool m_established{false};
+
 Q_SIGNALS:
 	void clientConnectionClosed();
 	void serverConnectionClosed();
-	void serverMessageProcessed();
+	void established();
 
 } ;
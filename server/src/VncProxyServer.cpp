@@ -103,8 +103,8 @@ void VncProxyServer::acceptConnection()
 																	 m_vncServerPassword,
 																	 this );
 
-	connect(connection, &VncProxyConnection::serverMessageProcessed, this,
-		[=]() { Q_EMIT serverMessageProcessed(connection); }, Qt::DirectConnection );
+	connect(connection, &VncProxyConnection::established, this,
+		[=]() { Q_EMIT connectionEstablished(connection); }, Qt::DirectConnection );
 
 	connect( connection, &VncProxyConnection::clientConnectionClosed, this, [=]() { closeConnection( connection ); } );
 	connect( connection, &VncProxyConnection::serverConnectionClosed, this, [=]() { closeConnection( connection ); } );
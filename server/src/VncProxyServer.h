@@ -55,7 +55,7 @@ public:
 	}
 
 Q_SIGNALS:
-	void serverMessageProcessed(VncProxyConnection* connection);
+	void connectionEstablished(VncProxyConnection* connection);
 	void connectionClosed( VncProxyConnection* connection );
 
 private:
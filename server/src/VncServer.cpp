@@ -35,14 +35,19 @@
 #include "VncServerPluginInterface.h"
 
 
-VncServer::VncServer( QObject* parent ) :
+VncServer::VncServer( int sessionId, QObject* parent ) :
 	QThread( parent ),
+	m_sessionId( sessionId ),
 	m_pluginInterface( nullptr )
 {
 	const auto currentSessionType = VeyonCore::platform().sessionFunctions().currentSessionType();
 
-	VeyonCore::authenticationCredentials().setInternalVncServerPassword(
-				CryptoCore::generateChallenge().toBase64().left( MAXPWLEN ) );
+	// VNC servers of all sessions served by this process share the password
+	if( VeyonCore::authenticationCredentials().internalVncServerPassword().isEmpty() )
+	{
+		VeyonCore::authenticationCredentials().setInternalVncServerPassword(
+					CryptoCore::generateChallenge().toBase64().left( MAXPWLEN ) );
+	}
 
 	VncServerPluginInterfaceList defaultVncServerPlugins;
 
@@ -90,6 +95,14 @@ VncServer::VncServer( QObject* parent ) :
 VncServer::~VncServer()
 {
 	vDebug();
+
+	// only servers of plugins supporting multiple instances can be stopped while the process keeps running
+	if( isRunning() && supportsMultipleInstances() )
+	{
+		requestInterruption();
+		quit();
+		wait();
+	}
 }
 
 
@@ -106,6 +119,13 @@ void VncServer::prepare()
 
 
 
+bool VncServer::supportsMultipleInstances() const
+{
+	return m_pluginInterface && m_pluginInterface->supportsMultipleInstances();
+}
+
+
+
 int VncServer::serverBasePort() const
 {
 
@@ -121,7 +141,7 @@ int VncServer::serverBasePort() const
 
 int VncServer::serverPort() const
 {
-	return serverBasePort() + VeyonCore::sessionId();
+	return serverBasePort() + m_sessionId;
 }
 
 
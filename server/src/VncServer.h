@@ -37,11 +37,13 @@ class VncServer : public QThread
 public:
 	using Password = CryptoCore::SecureArray;
 
-	explicit VncServer( QObject* parent = nullptr );
+	explicit VncServer( int sessionId, QObject* parent = nullptr );
 	~VncServer() override;
 
 	void prepare();
 
+	bool supportsMultipleInstances() const;
+
 	int serverBasePort() const;
 	int serverPort() const;
 
@@ -50,6 +52,7 @@ public:
 private:
 	void run() override;
 
+	const int m_sessionId;
 	VncServerPluginInterface* m_pluginInterface;
 
 } ;
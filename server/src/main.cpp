@@ -25,6 +25,7 @@
 #include <QGuiApplication>
 
 #include "ComputerControlServer.h"
+#include "MultiSessionServer.h"
 
 
 int main( int argc, char **argv )
@@ -35,6 +36,18 @@ int main( int argc, char **argv )
 
 	VeyonCore core( &app, VeyonCore::Component::Server, QStringLiteral("Server") );
 
+	if( MultiSessionServerControl::isEnabled() )
+	{
+		MultiSessionServer server( &core );
+		if( server.start() == false )
+		{
+			vCritical() << "Failed to start multi session server";
+			return -1;
+		}
+
+		return core.exec();
+	}
+
 	ComputerControlServer server( &core );
 	if( server.start() == false )
 	{
@@ -42,5 +55,8 @@ int main( int argc, char **argv )
 		return -1;
 	}
 
+	// make app terminate once the VNC server thread has finished
+	QObject::connect( &server, &ComputerControlServer::finished, &app, &QCoreApplication::quit );
+
 	return core.exec();
 }
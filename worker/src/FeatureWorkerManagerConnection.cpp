@@ -26,6 +26,7 @@
 #include <QHostAddress>
 
 #include "FeatureManager.h"
+#include "FeatureWorkerManager.h"
 #include "FeatureWorkerManagerConnection.h"
 #include "VeyonConfiguration.h"
 
@@ -86,7 +87,14 @@ void FeatureWorkerManagerConnection::sendInitMessage()
 
 	m_connectTimer.stop();
 
-	FeatureMessage(m_featureUid, FeatureMessage::InitCommand).sendPlain(&m_socket);
+	FeatureMessage initMessage(m_featureUid, FeatureMessage::InitCommand);
+	if (m_featureUid.isNull())
+	{
+		// allow FeatureWorkerManager to identify idle workers it started itself
+		initMessage.addArgument(FeatureWorkerManager::InitArgument::ProcessId, QCoreApplication::applicationPid());
+	}
+
+	initMessage.sendPlain(&m_socket);
 }
 
 
@@ -97,7 +105,28 @@ void FeatureWorkerManagerConnection::receiveMessage()
 
 	while( featureMessage.isReadyForReceive( &m_socket ) )
 	{
-		if( featureMessage.receive( &m_socket ) )
+		if( featureMessage.receive( &m_socket ) == false )
+		{
+			continue;
+		}
+
+		if( m_featureUid.isNull() )
+		{
+			if( featureMessage.command() == FeatureMessage::InitCommand &&
+				featureMessage.featureUid().isNull() == false )
+			{
+				m_featureUid = featureMessage.featureUid();
+				Q_EMIT featureAssigned( m_featureUid );
+
+				// confirm assignment
+				sendInitMessage();
+			}
+			else
+			{
+				vWarning() << "ignoring message for idle worker" << featureMessage;
+			}
+		}
+		else
 		{
 			VeyonCore::featureManager().handleFeatureMessage( m_worker, featureMessage );
 		}
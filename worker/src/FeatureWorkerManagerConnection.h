@@ -44,6 +44,9 @@ public:
 
 	bool sendMessage( const FeatureMessage& message );
 
+Q_SIGNALS:
+	void featureAssigned( Feature::Uid featureUid );
+
 private:
 	static constexpr auto ConnectTimeout = 3000;
 
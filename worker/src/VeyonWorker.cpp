@@ -34,8 +34,41 @@ VeyonWorker::VeyonWorker( QUuid featureUid, QObject* parent ) :
 	QObject( parent ),
 	m_core( QCoreApplication::instance(),
 			VeyonCore::Component::Worker,
-			QStringLiteral( "FeatureWorker-" ) + VeyonCore::formattedUuid( featureUid ) ),
+			QStringLiteral( "FeatureWorker-" ) +
+				( featureUid.isNull() ? QStringLiteral("Idle") : VeyonCore::formattedUuid( featureUid ) ) ),
 	m_workerManagerConnection( nullptr )
+{
+	if( featureUid.isNull() == false )
+	{
+		initFeature( featureUid );
+	}
+
+	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid);
+
+	if( featureUid.isNull() )
+	{
+		connect( m_workerManagerConnection, &FeatureWorkerManagerConnection::featureAssigned,
+				 this, &VeyonWorker::initFeature );
+
+		vInfo() << "Running idle worker";
+	}
+}
+
+
+
+VeyonWorker::~VeyonWorker()
+{
+	vDebug();
+
+	delete m_workerManagerConnection;
+	m_workerManagerConnection = nullptr;
+
+	vDebug() << "finished";
+}
+
+
+
+void VeyonWorker::initFeature( Feature::Uid featureUid )
 {
 	const Feature* workerFeature = nullptr;
 
@@ -57,25 +90,11 @@ VeyonWorker::VeyonWorker( QUuid featureUid, QObject* parent ) :
 		qFatal( "Specified feature is disabled by configuration!" );
 	}
 
-	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid);
-
 	vInfo() << "Running worker for feature" << workerFeature->name();
 }
 
 
 
-VeyonWorker::~VeyonWorker()
-{
-	vDebug();
-
-	delete m_workerManagerConnection;
-	m_workerManagerConnection = nullptr;
-
-	vDebug() << "finished";
-}
-
-
-
 bool VeyonWorker::sendFeatureMessageReply( const FeatureMessage& reply )
 {
 	return m_workerManagerConnection &&
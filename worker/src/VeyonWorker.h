@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Feature.h"
 #include "VeyonCore.h"
 #include "VeyonWorkerInterface.h"
 
@@ -44,6 +45,8 @@ public:
 	}
 
 private:
+	void initFeature( Feature::Uid featureUid );
+
 	VeyonCore m_core;
 	FeatureWorkerManagerConnection* m_workerManagerConnection;
 
@@ -26,6 +26,7 @@
 #include <QIcon>
 
 #include "Feature.h"
+#include "FeatureWorkerManager.h"
 #include "VeyonWorker.h"
 
 
@@ -43,8 +44,11 @@ int main( int argc, char **argv )
 		qFatal( "Not enough arguments (feature)" );
 	}
 
+	// idle workers are started without feature and get it assigned by FeatureWorkerManager later
+	const auto isIdleWorker = arguments[1] == FeatureWorkerManager::idleWorkerArgument();
+
 	const auto featureUid = Feature::Uid{arguments[1]};
-	if( featureUid.isNull() )
+	if( featureUid.isNull() && isIdleWorker == false )
 	{
 		qFatal( "Invalid feature UID given" );
 	}